@@ -0,0 +1,208 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string_view>
+#include <vector>
+#include "Algorithms.h"
+#include "Kernels.h"
+#include "LinearAllocator.h"
+#include "StringView.h"
+
+namespace jlb
+{
+	namespace benchmarks
+	{
+		namespace
+		{
+			void RunSortBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("sort"))
+					return;
+
+				const size_t count = runner.Scale(1 << 20);
+				LinearAllocator allocator{ count * sizeof(int) * 2 + 1024 };
+
+				Array<int> array{};
+				array.Allocate(allocator, count);
+				std::vector<int> vector(count);
+
+				std::mt19937 random{ 42 };
+				std::vector<int> randomValues(count);
+				for (int& value : randomValues)
+					value = static_cast<int>(random());
+				std::vector<int> sortedValues(randomValues);
+				std::sort(sortedValues.begin(), sortedValues.end());
+				std::vector<int> fewUniqueValues(count);
+				for (int& value : fewUniqueValues)
+					value = static_cast<int>(random() % 16);
+
+				struct Input final
+				{
+					const char* name;
+					const char* radixName;
+					const std::vector<int>* values;
+				};
+
+				const Input inputs[] =
+				{
+					{ "Sort random", "RadixSort random", &randomValues },
+					{ "Sort sorted", "RadixSort sorted", &sortedValues },
+					{ "Sort few unique", "RadixSort few unique", &fewUniqueValues }
+				};
+
+				for (const auto& input : inputs)
+				{
+					auto resetArray = [&]
+					{
+						std::copy(input.values->begin(), input.values->end(), array.GetData());
+					};
+					auto resetVector = [&]
+					{
+						vector = *input.values;
+					};
+					auto stdSort = [&]
+					{
+						std::sort(vector.begin(), vector.end());
+					};
+
+					runner.Compare(input.name, count, resetArray, [&]
+					{
+						Sort(array);
+					}, resetVector, stdSort);
+
+					runner.Compare(input.radixName, count, resetArray, [&]
+					{
+						RadixSort(array, allocator);
+					}, resetVector, stdSort);
+				}
+
+				array.Free(allocator);
+			}
+
+			void RunKernelBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("kernels"))
+					return;
+
+				const size_t count = runner.Scale(1 << 20);
+				std::mt19937 random{ 42 };
+				std::vector<int32_t> ints(count);
+				std::vector<float> floats(count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					ints[i] = static_cast<int32_t>(random() % 1000);
+					floats[i] = static_cast<float>(ints[i]);
+				}
+				// The value to find is only at the end, so that the whole range is scanned.
+				ints.back() = -1;
+
+				runner.Compare("Find int", count, [&]
+				{
+					DoNotOptimize(Find(ints.data(), count, -1));
+				}, [&]
+				{
+					DoNotOptimize(std::find(ints.begin(), ints.end(), -1));
+				});
+
+				runner.Compare("Count int", count, [&]
+				{
+					DoNotOptimize(Count(ints.data(), count, 7));
+				}, [&]
+				{
+					DoNotOptimize(std::count(ints.begin(), ints.end(), 7));
+				});
+
+				runner.Compare("MinMax int", count, [&]
+				{
+					int32_t min, max;
+					MinMax(ints.data(), count, min, max);
+					DoNotOptimize(min);
+					DoNotOptimize(max);
+				}, [&]
+				{
+					DoNotOptimize(std::minmax_element(ints.begin(), ints.end()));
+				});
+
+				runner.Compare("MinMax float", count, [&]
+				{
+					float min, max;
+					MinMax(floats.data(), count, min, max);
+					DoNotOptimize(min);
+					DoNotOptimize(max);
+				}, [&]
+				{
+					DoNotOptimize(std::minmax_element(floats.begin(), floats.end()));
+				});
+
+				runner.Compare("Sum int", count, [&]
+				{
+					DoNotOptimize(Sum(ints.data(), count));
+				}, [&]
+				{
+					DoNotOptimize(std::accumulate(ints.begin(), ints.end(), int64_t(0)));
+				});
+
+				runner.Compare("Sum float", count, [&]
+				{
+					DoNotOptimize(Sum(floats.data(), count));
+				}, [&]
+				{
+					DoNotOptimize(std::accumulate(floats.begin(), floats.end(), 0.0f));
+				});
+			}
+
+			void RunStringBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("string"))
+					return;
+
+				const size_t count = runner.Scale(1 << 22);
+				std::mt19937 random{ 42 };
+				std::vector<char> text(count);
+				for (char& c : text)
+					c = static_cast<char>('a' + random() % 26);
+				// Only found at the end, so that the whole text is scanned.
+				const char pattern[] = "needle";
+				std::copy(pattern, pattern + 6, text.end() - 6);
+
+				const StringView view{ text.data(), count };
+				const std::string_view stdView{ text.data(), count };
+
+				runner.Compare("Find char", count, [&]
+				{
+					DoNotOptimize(view.Find('n', count - 6));
+					DoNotOptimize(view.Find('#'));
+				}, [&]
+				{
+					DoNotOptimize(stdView.find('n', count - 6));
+					DoNotOptimize(stdView.find('#'));
+				});
+
+				runner.Compare("Find string", count, [&]
+				{
+					DoNotOptimize(view.Find("needle"));
+				}, [&]
+				{
+					DoNotOptimize(stdView.find("needle"));
+				});
+
+				runner.Compare("FindAny", count, [&]
+				{
+					DoNotOptimize(view.FindAny("#@!"));
+				}, [&]
+				{
+					DoNotOptimize(stdView.find_first_of("#@!"));
+				});
+			}
+		}
+
+		void RunAlgorithmBenchmarks(const Runner& runner)
+		{
+			RunSortBenchmarks(runner);
+			RunKernelBenchmarks(runner);
+			RunStringBenchmarks(runner);
+		}
+	}
+}
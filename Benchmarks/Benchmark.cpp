@@ -0,0 +1,48 @@
+#include "Benchmark.h"
+#include <cstdio>
+#include <cstring>
+
+namespace jlb
+{
+	namespace benchmarks
+	{
+		Runner::Runner(const int argc, char** argv)
+		{
+			for (int i = 1; i < argc; ++i)
+			{
+				if (strcmp(argv[i], "--quick") == 0)
+					_quick = true;
+				else
+					_filter = argv[i];
+			}
+
+			printf("%-40s %12s %12s %9s\n", "benchmark", "jlb ns/op", "std ns/op", "jlb/std");
+		}
+
+		size_t Runner::Scale(const size_t count) const
+		{
+			const size_t scaled = _quick ? count / 64 : count;
+			return scaled > 0 ? scaled : 1;
+		}
+
+		bool Runner::BeginGroup(const char* group) const
+		{
+			if (_filter && strcmp(_filter, group) != 0)
+				return false;
+			printf("\n[%s]\n", group);
+			return true;
+		}
+
+		size_t Runner::GetRepetitions() const
+		{
+			return _quick ? 1 : 7;
+		}
+
+		void Runner::Print(const char* name, const double jlbNanoseconds, const double stdNanoseconds)
+		{
+			const double ratio = stdNanoseconds > 0 ? jlbNanoseconds / stdNanoseconds : 0;
+			printf("%-40s %12.2f %12.2f %9.2f\n", name, jlbNanoseconds, stdNanoseconds, ratio);
+			fflush(stdout);
+		}
+	}
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+namespace jlb
+{
+	namespace benchmarks
+	{
+		/// <summary>
+		/// Prevents the compiler from optimizing away the computation of a value.
+		/// </summary>
+		template <typename T>
+		void DoNotOptimize(const T& value)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			asm volatile("" : : "r,m"(value) : "memory");
+#else
+			static volatile const void* sink;
+			sink = &value;
+#endif
+		}
+
+		/// <summary>
+		/// Runs benchmarks and prints how jlb compares to the std equivalent.
+		/// </summary>
+		class Runner final
+		{
+		public:
+			/// <summary>
+			/// Supported arguments: --quick for a short run with less work, 
+			/// and a group name to only run the benchmarks of that group.
+			/// </summary>
+			Runner(int argc, char** argv);
+
+			/// <summary>
+			/// Scales the amount of work down in a quick run.
+			/// </summary>
+			/// <param name="count">Amount of work in a full run.</param>
+			/// <returns>Amount of work for this run.</returns>
+			[[nodiscard]] size_t Scale(size_t count) const;
+			/// <summary>
+			/// Checks if the benchmarks of a group should run, and prints the group if so.
+			/// </summary>
+			/// <param name="group">Name of the group.</param>
+			/// <returns>If the group should run.</returns>
+			[[nodiscard]] bool BeginGroup(const char* group) const;
+
+			/// <summary>
+			/// Times both functions and prints the time per operation.
+			/// </summary>
+			/// <param name="name">Name of the benchmark.</param>
+			/// <param name="operations">Amount of operations done by a single call.</param>
+			/// <param name="jlbFunction">Function that uses jlb.</param>
+			/// <param name="stdFunction">Function that uses the std equivalent.</param>
+			template <typename Jlb, typename Std>
+			void Compare(const char* name, size_t operations, Jlb jlbFunction, Std stdFunction) const;
+			/// <summary>
+			/// Times both functions and prints the time per operation.<br>
+			/// The reset functions are called before every timed call, but are not timed themselves.
+			/// </summary>
+			/// <param name="name">Name of the benchmark.</param>
+			/// <param name="operations">Amount of operations done by a single call.</param>
+			template <typename JlbReset, typename Jlb, typename StdReset, typename Std>
+			void Compare(const char* name, size_t operations, 
+				JlbReset jlbReset, Jlb jlbFunction, StdReset stdReset, Std stdFunction) const;
+
+		private:
+			bool _quick = false;
+			const char* _filter = nullptr;
+
+			[[nodiscard]] size_t GetRepetitions() const;
+			static void Print(const char* name, double jlbNanoseconds, double stdNanoseconds);
+
+			template <typename Reset, typename Function>
+			[[nodiscard]] double Measure(size_t operations, Reset reset, Function function) const;
+		};
+
+		template <typename Jlb, typename Std>
+		void Runner::Compare(const char* name, const size_t operations, Jlb jlbFunction, Std stdFunction) const
+		{
+			Compare(name, operations, [] {}, jlbFunction, [] {}, stdFunction);
+		}
+
+		template <typename JlbReset, typename Jlb, typename StdReset, typename Std>
+		void Runner::Compare(const char* name, const size_t operations,
+			JlbReset jlbReset, Jlb jlbFunction, StdReset stdReset, Std stdFunction) const
+		{
+			const double jlbNanoseconds = Measure(operations, jlbReset, jlbFunction);
+			const double stdNanoseconds = Measure(operations, stdReset, stdFunction);
+			Print(name, jlbNanoseconds, stdNanoseconds);
+		}
+
+		template <typename Reset, typename Function>
+		double Runner::Measure(const size_t operations, Reset reset, Function function) const
+		{
+			using Clock = std::chrono::steady_clock;
+
+			// Warm up the caches, then keep the fastest repetition since noise only ever adds time.
+			reset();
+			function();
+
+			double best = 0;
+			const size_t repetitions = GetRepetitions();
+			for (size_t i = 0; i < repetitions; ++i)
+			{
+				reset();
+				const auto start = Clock::now();
+				function();
+				const auto end = Clock::now();
+
+				const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+				best = i == 0 || nanoseconds < best ? nanoseconds : best;
+			}
+
+			return best / static_cast<double>(operations > 0 ? operations : 1);
+		}
+
+		void RunContainerBenchmarks(const Runner& runner);
+		void RunConcurrencyBenchmarks(const Runner& runner);
+		void RunAlgorithmBenchmarks(const Runner& runner);
+	}
+}
@@ -0,0 +1,197 @@
+#include "Benchmark.h"
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include "LinearAllocator.h"
+#include "MPMCQueue.h"
+#include "Queue.h"
+#include "SPSCQueue.h"
+
+namespace jlb
+{
+	namespace benchmarks
+	{
+		namespace
+		{
+			// Queue protected by a mutex, the usual std alternative for passing values between threads.
+			template <typename T>
+			class LockedQueue final
+			{
+			public:
+				void Enqueue(const T& value)
+				{
+					std::lock_guard<std::mutex> lock{ _mutex };
+					_queue.push(value);
+				}
+
+				[[nodiscard]] bool TryDequeue(T& outValue)
+				{
+					std::lock_guard<std::mutex> lock{ _mutex };
+					if (_queue.empty())
+						return false;
+					outValue = _queue.front();
+					_queue.pop();
+					return true;
+				}
+
+			private:
+				std::mutex _mutex{};
+				std::queue<T> _queue{};
+			};
+
+			// Runs the producers and consumers on their own threads, and waits for them to finish.
+			template <typename Producer, typename Consumer>
+			void RunThreads(const size_t producerCount, Producer producer, const size_t consumerCount, Consumer consumer)
+			{
+				std::thread threads[8];
+				size_t threadCount = 0;
+				for (size_t i = 0; i < producerCount; ++i)
+					threads[threadCount++] = std::thread(producer);
+				for (size_t i = 0; i < consumerCount; ++i)
+					threads[threadCount++] = std::thread(consumer);
+				for (size_t i = 0; i < threadCount; ++i)
+					threads[i].join();
+			}
+
+			void RunQueueBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("queue"))
+					return;
+
+				const size_t count = runner.Scale(1 << 20);
+				constexpr size_t batch = 64;
+				LinearAllocator allocator{ batch * sizeof(int) + 1024 };
+
+				Queue<int> queue{};
+				queue.Allocate(allocator, batch);
+				std::queue<int> stdQueue{};
+
+				runner.Compare("Enqueue Dequeue in batches", count * 2, [&]
+				{
+					int64_t sum = 0;
+					for (size_t i = 0; i < count; i += batch)
+					{
+						for (size_t j = 0; j < batch; ++j)
+							queue.Enqueue(static_cast<int>(j));
+						for (size_t j = 0; j < batch; ++j)
+							sum += queue.Dequeue();
+					}
+					DoNotOptimize(sum);
+				}, [&]
+				{
+					int64_t sum = 0;
+					for (size_t i = 0; i < count; i += batch)
+					{
+						for (size_t j = 0; j < batch; ++j)
+							stdQueue.push(static_cast<int>(j));
+						for (size_t j = 0; j < batch; ++j)
+						{
+							sum += stdQueue.front();
+							stdQueue.pop();
+						}
+					}
+					DoNotOptimize(sum);
+				});
+
+				queue.Free(allocator);
+			}
+
+			void RunSPSCBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("spsc"))
+					return;
+
+				const size_t count = runner.Scale(1 << 20);
+				LinearAllocator allocator{ 1 << 16 };
+
+				SPSCQueue<int> queue{};
+				queue.Allocate(allocator, 1024);
+				LockedQueue<int> lockedQueue{};
+
+				runner.Compare("Producer to consumer", count, [&]
+				{
+					RunThreads(1, [&]
+					{
+						for (size_t i = 0; i < count; ++i)
+							while (!queue.TryEnqueue(static_cast<int>(i)))
+								std::this_thread::yield();
+					}, 1, [&]
+					{
+						int value;
+						for (size_t i = 0; i < count; ++i)
+							while (!queue.TryDequeue(value))
+								std::this_thread::yield();
+					});
+				}, [&]
+				{
+					RunThreads(1, [&]
+					{
+						for (size_t i = 0; i < count; ++i)
+							lockedQueue.Enqueue(static_cast<int>(i));
+					}, 1, [&]
+					{
+						int value;
+						for (size_t i = 0; i < count; ++i)
+							while (!lockedQueue.TryDequeue(value))
+								std::this_thread::yield();
+					});
+				});
+
+				queue.Free(allocator);
+			}
+
+			void RunMPMCBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("mpmc"))
+					return;
+
+				constexpr size_t threadCount = 2;
+				const size_t count = runner.Scale(1 << 19);
+				LinearAllocator allocator{ 1 << 16 };
+
+				MPMCQueue<int> queue{};
+				queue.Allocate(allocator, 1024);
+				LockedQueue<int> lockedQueue{};
+
+				runner.Compare("2 producers to 2 consumers", count * threadCount, [&]
+				{
+					RunThreads(threadCount, [&]
+					{
+						for (size_t i = 0; i < count; ++i)
+							while (!queue.TryEnqueue(static_cast<int>(i)))
+								std::this_thread::yield();
+					}, threadCount, [&]
+					{
+						int value;
+						for (size_t i = 0; i < count; ++i)
+							while (!queue.TryDequeue(value))
+								std::this_thread::yield();
+					});
+				}, [&]
+				{
+					RunThreads(threadCount, [&]
+					{
+						for (size_t i = 0; i < count; ++i)
+							lockedQueue.Enqueue(static_cast<int>(i));
+					}, threadCount, [&]
+					{
+						int value;
+						for (size_t i = 0; i < count; ++i)
+							while (!lockedQueue.TryDequeue(value))
+								std::this_thread::yield();
+					});
+				});
+
+				queue.Free(allocator);
+			}
+		}
+
+		void RunConcurrencyBenchmarks(const Runner& runner)
+		{
+			RunQueueBenchmarks(runner);
+			RunSPSCBenchmarks(runner);
+			RunMPMCBenchmarks(runner);
+		}
+	}
+}
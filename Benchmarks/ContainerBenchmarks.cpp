@@ -0,0 +1,627 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <list>
+#include <map>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Array.h"
+#include "BTree.h"
+#include "ClockCache.h"
+#include "FilteredHashMap.h"
+#include "FrameAllocator.h"
+#include "HashMap.h"
+#include "Heap.h"
+#include "LinearAllocator.h"
+#include "StaticMap.h"
+#include "Vector.h"
+
+namespace jlb
+{
+	namespace benchmarks
+	{
+		namespace
+		{
+			size_t HashInt(int& value)
+			{
+				// Same as std::hash<int> in the common standard libraries.
+				return static_cast<size_t>(value);
+			}
+
+			constexpr uint32_t STATIC_KEY_COUNT = 512;
+
+			constexpr uint32_t GetStaticKey(const uint32_t index)
+			{
+				return index * 2654435761u;
+			}
+
+			constexpr StaticMap<uint32_t, uint32_t, STATIC_KEY_COUNT> BuildStaticMap()
+			{
+				StaticMapEntry<uint32_t, uint32_t> entries[STATIC_KEY_COUNT]{};
+				for (uint32_t i = 0; i < STATIC_KEY_COUNT; ++i)
+					entries[i] = { GetStaticKey(i), i };
+				return StaticMap<uint32_t, uint32_t, STATIC_KEY_COUNT>(entries);
+			}
+
+			void RunAllocatorBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("allocator"))
+					return;
+
+				const size_t count = runner.Scale(1 << 20);
+				constexpr size_t size = 64;
+				LinearAllocator allocator{ count * (size + sizeof(size_t)) + 1024 };
+
+				runner.Compare("Malloc Free pairs", count, [&]
+				{
+					for (size_t i = 0; i < count; ++i)
+					{
+						void* ptr = allocator.Malloc(size);
+						DoNotOptimize(ptr);
+						allocator.Free();
+					}
+				}, [&]
+				{
+					for (size_t i = 0; i < count; ++i)
+					{
+						void* ptr = malloc(size);
+						DoNotOptimize(ptr);
+						free(ptr);
+					}
+				});
+
+				std::vector<void*> pointers(count);
+				runner.Compare("Malloc all then Free all", count, [&]
+				{
+					for (size_t i = 0; i < count; ++i)
+						DoNotOptimize(allocator.Malloc(size));
+					for (size_t i = 0; i < count; ++i)
+						allocator.Free();
+				}, [&]
+				{
+					for (size_t i = 0; i < count; ++i)
+						pointers[i] = malloc(size);
+					for (size_t i = count; i > 0; --i)
+						free(pointers[i - 1]);
+				});
+
+				// Per frame data that has to live for three frames, compared to freeing it individually three frames later.
+				constexpr size_t frameCount = 3;
+				constexpr size_t perFrame = 256;
+				FrameAllocator frames{};
+				frames.Allocate(allocator, frameCount, perFrame * (size + sizeof(size_t)) + 64);
+				std::vector<void*> inFlight(frameCount * perFrame, nullptr);
+				runner.Compare("Frame allocations", count, [&]
+				{
+					for (size_t i = 0; i < count; i += perFrame)
+					{
+						frames.BeginFrame();
+						for (size_t j = 0; j < perFrame; ++j)
+							DoNotOptimize(frames.Malloc(size));
+					}
+				}, [&]
+				{
+					size_t slot = 0;
+					for (size_t i = 0; i < count; i += perFrame)
+					{
+						slot = (slot + 1) % frameCount;
+						for (size_t j = 0; j < perFrame; ++j)
+						{
+							void*& ptr = inFlight[slot * perFrame + j];
+							free(ptr);
+							ptr = malloc(size);
+							DoNotOptimize(ptr);
+						}
+					}
+				});
+				for (void* ptr : inFlight)
+					free(ptr);
+				frames.Free(allocator);
+			}
+
+			void RunArrayBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("array"))
+					return;
+
+				const size_t count = runner.Scale(1 << 22);
+				LinearAllocator allocator{ count * sizeof(int) + 1024 };
+
+				Array<int> array{};
+				array.Allocate(allocator, count);
+				std::vector<int> vector(count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					array[i] = static_cast<int>(i);
+					vector[i] = static_cast<int>(i);
+				}
+
+				runner.Compare("Iterate and sum", count, [&]
+				{
+					int64_t sum = 0;
+					for (const int value : array)
+						sum += value;
+					DoNotOptimize(sum);
+				}, [&]
+				{
+					int64_t sum = 0;
+					for (const int value : vector)
+						sum += value;
+					DoNotOptimize(sum);
+				});
+
+				runner.Compare("Index and sum", count, [&]
+				{
+					int64_t sum = 0;
+					for (size_t i = 0; i < count; ++i)
+						sum += array[i];
+					DoNotOptimize(sum);
+				}, [&]
+				{
+					int64_t sum = 0;
+					for (size_t i = 0; i < count; ++i)
+						sum += vector[i];
+					DoNotOptimize(sum);
+				});
+
+				array.Free(allocator);
+			}
+
+			void RunVectorBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("vector"))
+					return;
+
+				const size_t count = runner.Scale(1 << 20);
+				LinearAllocator allocator{ count * sizeof(int) + 1024 };
+
+				Vector<int> vector{};
+				vector.Allocate(allocator, count);
+				std::vector<int> stdVector{};
+				stdVector.reserve(count);
+
+				runner.Compare("Add", count, [&]
+				{
+					vector.Clear();
+				}, [&]
+				{
+					for (size_t i = 0; i < count; ++i)
+						vector.Add(static_cast<int>(i));
+					DoNotOptimize(vector.GetData());
+				}, [&]
+				{
+					stdVector.clear();
+				}, [&]
+				{
+					for (size_t i = 0; i < count; ++i)
+						stdVector.push_back(static_cast<int>(i));
+					DoNotOptimize(stdVector.data());
+				});
+
+				runner.Compare("RemoveAt front (swap with last)", count, [&]
+				{
+					vector.Clear();
+					for (size_t i = 0; i < count; ++i)
+						vector.Add(static_cast<int>(i));
+				}, [&]
+				{
+					for (size_t i = 0; i < count; ++i)
+						vector.RemoveAt(0);
+					DoNotOptimize(vector.GetData());
+				}, [&]
+				{
+					stdVector.assign(count, 0);
+				}, [&]
+				{
+					for (size_t i = 0; i < count; ++i)
+					{
+						stdVector[0] = stdVector.back();
+						stdVector.pop_back();
+					}
+					DoNotOptimize(stdVector.data());
+				});
+
+				vector.Free(allocator);
+			}
+
+			void RunHashMapBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("hashmap"))
+					return;
+
+				const size_t capacity = runner.Scale(1 << 12);
+				LinearAllocator allocator{ capacity * sizeof(KeyPair<int>) * 2 + 1024 };
+
+				// Unique random keys, the second half is never inserted and used for misses.
+				std::vector<int> keys(capacity * 2);
+				for (size_t i = 0; i < keys.size(); ++i)
+					keys[i] = static_cast<int>(i);
+				std::shuffle(keys.begin(), keys.end(), std::mt19937{ 42 });
+
+				for (const double loadFactor : { 0.25, 0.5, 0.75, 0.9 })
+				{
+					const size_t count = static_cast<size_t>(static_cast<double>(capacity) * loadFactor);
+					int* hits = keys.data();
+					int* misses = keys.data() + capacity;
+
+					HashMap<int> map{};
+					map.hasher = HashInt;
+					std::unordered_set<int> set{};
+
+					auto resetMap = [&]
+					{
+						map.Free(allocator);
+						map.Allocate(allocator, capacity);
+					};
+					auto fillMap = [&]
+					{
+						resetMap();
+						for (size_t i = 0; i < count; ++i)
+							map.Insert(hits[i]);
+					};
+					auto resetSet = [&]
+					{
+						set.clear();
+						set.reserve(capacity);
+					};
+					auto fillSet = [&]
+					{
+						resetSet();
+						for (size_t i = 0; i < count; ++i)
+							set.insert(hits[i]);
+					};
+
+					map.Allocate(allocator, capacity);
+					char name[64];
+
+					snprintf(name, sizeof name, "Insert (load %.2f)", loadFactor);
+					runner.Compare(name, count, resetMap, [&]
+					{
+						for (size_t i = 0; i < count; ++i)
+							map.Insert(hits[i]);
+					}, resetSet, [&]
+					{
+						for (size_t i = 0; i < count; ++i)
+							set.insert(hits[i]);
+					});
+
+					fillMap();
+					fillSet();
+
+					snprintf(name, sizeof name, "Hit (load %.2f)", loadFactor);
+					runner.Compare(name, count, [&]
+					{
+						size_t found = 0;
+						for (size_t i = 0; i < count; ++i)
+							found += map.Contains(hits[i]);
+						DoNotOptimize(found);
+					}, [&]
+					{
+						size_t found = 0;
+						for (size_t i = 0; i < count; ++i)
+							found += set.count(hits[i]);
+						DoNotOptimize(found);
+					});
+
+					snprintf(name, sizeof name, "Miss (load %.2f)", loadFactor);
+					runner.Compare(name, count, [&]
+					{
+						size_t found = 0;
+						for (size_t i = 0; i < count; ++i)
+							found += map.Contains(misses[i]);
+						DoNotOptimize(found);
+					}, [&]
+					{
+						size_t found = 0;
+						for (size_t i = 0; i < count; ++i)
+							found += set.count(misses[i]);
+						DoNotOptimize(found);
+					});
+
+					snprintf(name, sizeof name, "Erase (load %.2f)", loadFactor);
+					runner.Compare(name, count, fillMap, [&]
+					{
+						for (size_t i = 0; i < count; ++i)
+							map.Erase(hits[i]);
+					}, fillSet, [&]
+					{
+						for (size_t i = 0; i < count; ++i)
+							set.erase(hits[i]);
+					});
+
+					map.Free(allocator);
+
+					// Same misses, but most of them are rejected by the filter before the table is searched.
+					FilteredHashMap<int> filtered{};
+					filtered.hasher = HashInt;
+					filtered.Allocate(allocator, capacity, 0.01);
+					for (size_t i = 0; i < count; ++i)
+						filtered.Insert(hits[i]);
+
+					snprintf(name, sizeof name, "Filtered miss (load %.2f)", loadFactor);
+					runner.Compare(name, count, [&]
+					{
+						size_t found = 0;
+						for (size_t i = 0; i < count; ++i)
+							found += filtered.Contains(misses[i]);
+						DoNotOptimize(found);
+					}, [&]
+					{
+						size_t found = 0;
+						for (size_t i = 0; i < count; ++i)
+							found += set.count(misses[i]);
+						DoNotOptimize(found);
+					});
+
+					filtered.Free(allocator);
+				}
+
+				// Fixed key set known at compile time, half of the lookups are misses.
+				static constexpr auto staticMap = BuildStaticMap();
+				std::unordered_map<uint32_t, uint32_t> staticSet{};
+				for (uint32_t i = 0; i < STATIC_KEY_COUNT; ++i)
+					staticSet.emplace(GetStaticKey(i), i);
+				std::vector<uint32_t> lookups(capacity);
+				for (size_t i = 0; i < lookups.size(); ++i)
+					lookups[i] = GetStaticKey(static_cast<uint32_t>(i % (STATIC_KEY_COUNT * 2)));
+
+				runner.Compare("Static map lookup", lookups.size(), [&]
+				{
+					uint32_t sum = 0;
+					for (const uint32_t key : lookups)
+					{
+						const uint32_t* value = staticMap.Find(key);
+						sum += value ? *value : 0;
+					}
+					DoNotOptimize(sum);
+				}, [&]
+				{
+					uint32_t sum = 0;
+					for (const uint32_t key : lookups)
+					{
+						const auto it = staticSet.find(key);
+						sum += it != staticSet.end() ? it->second : 0;
+					}
+					DoNotOptimize(sum);
+				});
+			}
+
+			void RunBTreeBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("btree"))
+					return;
+
+				const size_t count = runner.Scale(1 << 18);
+				using Tree = BTree<uint32_t, uint32_t>;
+				// Half full leaves of 256 bytes, plus the inner nodes.
+				LinearAllocator allocator{ count / (Tree::LEAF_CAPACITY / 2) * 256 * 2 + 4096 };
+
+				std::vector<uint32_t> keys(count);
+				for (size_t i = 0; i < count; ++i)
+					keys[i] = static_cast<uint32_t>(i * 2);
+				std::shuffle(keys.begin(), keys.end(), std::mt19937{ 42 });
+
+				Tree tree{};
+				tree.Allocate(allocator, count);
+				std::map<uint32_t, uint32_t> map{};
+
+				runner.Compare("Insert random", count, [&]
+				{
+					tree.Clear();
+				}, [&]
+				{
+					for (const uint32_t key : keys)
+						tree.Insert(key, key);
+				}, [&]
+				{
+					map.clear();
+				}, [&]
+				{
+					for (const uint32_t key : keys)
+						map.emplace(key, key);
+				});
+
+				tree.Clear();
+				map.clear();
+				for (const uint32_t key : keys)
+				{
+					tree.Insert(key, key);
+					map.emplace(key, key);
+				}
+
+				// Half of the lookups are misses, since only the even keys are inserted.
+				runner.Compare("Find", count, [&]
+				{
+					uint32_t sum = 0;
+					for (size_t i = 0; i < count; ++i)
+					{
+						const uint32_t* value = tree.Find(keys[i] + (i & 1));
+						sum += value ? *value : 0;
+					}
+					DoNotOptimize(sum);
+				}, [&]
+				{
+					uint32_t sum = 0;
+					for (size_t i = 0; i < count; ++i)
+					{
+						const auto it = map.find(keys[i] + (i & 1));
+						sum += it != map.end() ? it->second : 0;
+					}
+					DoNotOptimize(sum);
+				});
+
+				constexpr uint32_t rangeSize = 256;
+				const size_t rangeCount = count / 64;
+				runner.Compare("Range scan (128 keys)", rangeCount * rangeSize / 2, [&]
+				{
+					uint32_t sum = 0;
+					for (size_t i = 0; i < rangeCount; ++i)
+						tree.ForEachInRange(keys[i], keys[i] + rangeSize - 1, [&sum](const uint32_t&, const uint32_t& value)
+						{
+							sum += value;
+						});
+					DoNotOptimize(sum);
+				}, [&]
+				{
+					uint32_t sum = 0;
+					for (size_t i = 0; i < rangeCount; ++i)
+					{
+						const auto last = map.upper_bound(keys[i] + rangeSize - 1);
+						for (auto it = map.lower_bound(keys[i]); it != last; ++it)
+							sum += it->second;
+					}
+					DoNotOptimize(sum);
+				});
+
+				runner.Compare("Iterate all", count, [&]
+				{
+					uint32_t sum = 0;
+					for (const auto [key, value] : tree)
+						sum += value;
+					DoNotOptimize(sum);
+				}, [&]
+				{
+					uint32_t sum = 0;
+					for (const auto& [key, value] : map)
+						sum += value;
+					DoNotOptimize(sum);
+				});
+
+				tree.Free(allocator);
+			}
+
+			void RunCacheBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("cache"))
+					return;
+
+				const size_t count = runner.Scale(1 << 20);
+				constexpr size_t capacity = 1 << 12;
+				LinearAllocator allocator{ capacity * 32 + 1024 };
+
+				// Skewed keys, where a small set of hot keys is requested far more often than the rest.
+				std::vector<uint32_t> keys(count);
+				std::mt19937 random{ 42 };
+				std::uniform_real_distribution<double> distribution{ 0, 1 };
+				for (uint32_t& key : keys)
+				{
+					const double sample = distribution(random);
+					key = static_cast<uint32_t>(sample * sample * sample * capacity * 8);
+				}
+
+				ClockCache<uint32_t, uint32_t> cache{};
+				cache.hasher = [](const uint32_t& key)
+				{
+					return static_cast<size_t>(key * 2654435761u);
+				};
+				cache.Allocate(allocator, capacity);
+
+				// The common way to bolt LRU eviction onto a hash map, with a linked list of recently used keys.
+				std::list<std::pair<uint32_t, uint32_t>> recent{};
+				std::unordered_map<uint32_t, std::list<std::pair<uint32_t, uint32_t>>::iterator> lru{};
+
+				runner.Compare("Get or put", count, [&]
+				{
+					cache.Clear();
+				}, [&]
+				{
+					uint32_t sum = 0;
+					for (const uint32_t key : keys)
+					{
+						const uint32_t* value = cache.Get(key);
+						sum += value ? *value : cache.Put(key, key);
+					}
+					DoNotOptimize(sum);
+				}, [&]
+				{
+					recent.clear();
+					lru.clear();
+					lru.reserve(capacity);
+				}, [&]
+				{
+					uint32_t sum = 0;
+					for (const uint32_t key : keys)
+					{
+						const auto it = lru.find(key);
+						if (it != lru.end())
+						{
+							recent.splice(recent.begin(), recent, it->second);
+							sum += it->second->second;
+							continue;
+						}
+						if (lru.size() == capacity)
+						{
+							lru.erase(recent.back().first);
+							recent.pop_back();
+						}
+						recent.emplace_front(key, key);
+						lru.emplace(key, recent.begin());
+						sum += key;
+					}
+					DoNotOptimize(sum);
+				});
+
+				cache.Free(allocator);
+			}
+
+			void RunHeapBenchmarks(const Runner& runner)
+			{
+				if (!runner.BeginGroup("heap"))
+					return;
+
+				const size_t count = runner.Scale(1 << 18);
+				LinearAllocator allocator{ (count + 1) * sizeof(KeyPair<int>) + 1024 };
+
+				std::vector<int> values(count);
+				std::mt19937 random{ 42 };
+				for (int& value : values)
+					value = static_cast<int>(random() % count);
+
+				Heap<int> heap{};
+				heap.hasher = HashInt;
+				heap.Allocate(allocator, count);
+				std::priority_queue<int, std::vector<int>, std::greater<int>> queue{};
+
+				runner.Compare("Push then Pop all", count * 2, [&]
+				{
+					for (int value : values)
+						heap.Insert(value);
+					int64_t sum = 0;
+					while (heap.GetCount() > 0)
+						sum += heap.Pop();
+					DoNotOptimize(sum);
+				}, [&]
+				{
+					for (const int value : values)
+						queue.push(value);
+					int64_t sum = 0;
+					while (!queue.empty())
+					{
+						sum += queue.top();
+						queue.pop();
+					}
+					DoNotOptimize(sum);
+				});
+
+				heap.Free(allocator);
+			}
+		}
+
+		void RunContainerBenchmarks(const Runner& runner)
+		{
+			RunAllocatorBenchmarks(runner);
+			RunArrayBenchmarks(runner);
+			RunVectorBenchmarks(runner);
+			RunHashMapBenchmarks(runner);
+			RunBTreeBenchmarks(runner);
+			RunCacheBenchmarks(runner);
+			RunHeapBenchmarks(runner);
+		}
+	}
+}
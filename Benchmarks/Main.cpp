@@ -0,0 +1,12 @@
+#include "Benchmark.h"
+
+int main(const int argc, char** argv)
+{
+	using namespace jlb::benchmarks;
+
+	const Runner runner{ argc, argv };
+	RunContainerBenchmarks(runner);
+	RunConcurrencyBenchmarks(runner);
+	RunAlgorithmBenchmarks(runner);
+	return 0;
+}
@@ -0,0 +1,608 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "Array.h"
+#include "Scheduler.h"
+
+namespace jlb
+{
+	namespace algorithmsImpl
+	{
+		// Ranges smaller than this are sorted with insertion sort.
+		constexpr size_t INSERTION_SORT_THRESHOLD = 24;
+		// Ranges larger than this use a pseudo median of nine as the pivot.
+		constexpr size_t NINTHER_THRESHOLD = 128;
+		// Parallel sorting is not worth it below this amount of values.
+		constexpr size_t PARALLEL_SORT_THRESHOLD = 4096;
+
+		/// <summary>
+		/// Converts a key into an unsigned integer with the same ordering, so that it can be sorted byte by byte.
+		/// </summary>
+		template <typename Key>
+		[[nodiscard]] auto ToRadixKey(const Key key)
+		{
+			static_assert(std::is_arithmetic_v<Key>, "Radix keys have to be integers or floating point values.");
+
+			if constexpr (std::is_floating_point_v<Key>)
+			{
+				static_assert(sizeof(Key) == 4 || sizeof(Key) == 8);
+				using Bits = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+				Bits bits;
+				memcpy(&bits, &key, sizeof(Key));
+
+				// Negative values are ordered in reverse, so flip all their bits. Positive values only need the sign flipped.
+				constexpr Bits sign = static_cast<Bits>(1) << (sizeof(Bits) * 8 - 1);
+				return bits & sign ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | sign);
+			}
+			else if constexpr (std::is_signed_v<Key>)
+			{
+				// Flip the sign bit so that negative values come first.
+				using Bits = std::make_unsigned_t<Key>;
+				constexpr Bits sign = static_cast<Bits>(1) << (sizeof(Bits) * 8 - 1);
+				return static_cast<Bits>(static_cast<Bits>(key) ^ sign);
+			}
+			else
+				return key;
+		}
+
+		template <typename T>
+		void Copy(T* dst, const T* src, const size_t count)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (count > 0)
+					memcpy(dst, src, count * sizeof(T));
+			}
+			else
+				for (size_t i = 0; i < count; ++i)
+					dst[i] = src[i];
+		}
+
+		template <typename T, typename Compare>
+		void Sort2(T* a, T* b, Compare& compare)
+		{
+			if (compare(*b, *a))
+				std::iter_swap(a, b);
+		}
+
+		template <typename T, typename Compare>
+		void Sort3(T* a, T* b, T* c, Compare& compare)
+		{
+			Sort2(a, b, compare);
+			Sort2(b, c, compare);
+			Sort2(a, b, compare);
+		}
+
+		template <typename T, typename Compare>
+		void InsertionSort(T* begin, T* end, Compare& compare)
+		{
+			if (begin == end)
+				return;
+
+			for (T* current = begin + 1; current != end; ++current)
+			{
+				if (!compare(*current, *(current - 1)))
+					continue;
+
+				T temp = std::move(*current);
+				T* sift = current;
+				do
+				{
+					*sift = std::move(*(sift - 1));
+					--sift;
+				} while (sift != begin && compare(temp, *(sift - 1)));
+				*sift = std::move(temp);
+			}
+		}
+
+		/// <summary>
+		/// Insertion sort that gives up after moving a handful of values.<br>
+		/// Used to quickly finish ranges that turn out to be (nearly) sorted already.
+		/// </summary>
+		/// <returns>If the range has been sorted.</returns>
+		template <typename T, typename Compare>
+		[[nodiscard]] bool PartialInsertionSort(T* begin, T* end, Compare& compare)
+		{
+			constexpr size_t limit = 8;
+			if (begin == end)
+				return true;
+
+			size_t moved = 0;
+			for (T* current = begin + 1; current != end; ++current)
+			{
+				if (moved > limit)
+					return false;
+				if (!compare(*current, *(current - 1)))
+					continue;
+
+				T temp = std::move(*current);
+				T* sift = current;
+				do
+				{
+					*sift = std::move(*(sift - 1));
+					--sift;
+				} while (sift != begin && compare(temp, *(sift - 1)));
+				*sift = std::move(temp);
+				moved += current - sift;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Partitions the range around the pivot stored at begin. Values equal to the pivot end up on the right.
+		/// </summary>
+		/// <param name="outAlreadyPartitioned">If no values had to be swapped.</param>
+		/// <returns>Final position of the pivot.</returns>
+		template <typename T, typename Compare>
+		[[nodiscard]] T* PartitionRight(T* begin, T* end, Compare& compare, bool& outAlreadyPartitioned)
+		{
+			T pivot = std::move(*begin);
+			T* first = begin;
+			T* last = end;
+
+			// The median of three guarantees that there is a value that is not smaller than the pivot on the right.
+			while (compare(*++first, pivot));
+
+			// If nothing has been found on the left, there might not be a value smaller than the pivot on the right either.
+			if (first - 1 == begin)
+				while (first < last && !compare(*--last, pivot));
+			else
+				while (!compare(*--last, pivot));
+
+			outAlreadyPartitioned = first >= last;
+
+			while (first < last)
+			{
+				std::iter_swap(first, last);
+				while (compare(*++first, pivot));
+				while (!compare(*--last, pivot));
+			}
+
+			T* pivotPos = first - 1;
+			*begin = std::move(*pivotPos);
+			*pivotPos = std::move(pivot);
+			return pivotPos;
+		}
+
+		/// <summary>
+		/// Partitions the range around the pivot stored at begin. Values equal to the pivot end up on the left.<br>
+		/// Used when the pivot is known to be the smallest value in the range, to get rid of many duplicates at once.
+		/// </summary>
+		/// <returns>Final position of the pivot.</returns>
+		template <typename T, typename Compare>
+		[[nodiscard]] T* PartitionLeft(T* begin, T* end, Compare& compare)
+		{
+			T pivot = std::move(*begin);
+			T* first = begin;
+			T* last = end;
+
+			while (compare(pivot, *--last));
+
+			if (last + 1 == end)
+				while (first < last && !compare(pivot, *++first));
+			else
+				while (!compare(pivot, *++first));
+
+			while (first < last)
+			{
+				std::iter_swap(first, last);
+				while (compare(pivot, *--last));
+				while (!compare(pivot, *++first));
+			}
+
+			*begin = std::move(*last);
+			*last = std::move(pivot);
+			return last;
+		}
+
+		/// <summary>
+		/// Moves the chosen pivot to begin.
+		/// </summary>
+		template <typename T, typename Compare>
+		void ChoosePivot(T* begin, T* end, Compare& compare)
+		{
+			const size_t size = end - begin;
+			T* middle = begin + size / 2;
+
+			if (size > NINTHER_THRESHOLD)
+			{
+				Sort3(begin, middle, end - 1, compare);
+				Sort3(begin + 1, middle - 1, end - 2, compare);
+				Sort3(begin + 2, middle + 1, end - 3, compare);
+				Sort3(middle - 1, middle, middle + 1, compare);
+				std::iter_swap(begin, middle);
+			}
+			else
+				Sort3(middle, begin, end - 1, compare);
+		}
+
+		/// <summary>
+		/// Swaps a few values around to break up patterns that lead to unbalanced partitions.
+		/// </summary>
+		template <typename T>
+		void BreakPatterns(T* begin, T* end)
+		{
+			const size_t size = end - begin;
+			if (size < INSERTION_SORT_THRESHOLD)
+				return;
+
+			const size_t quarter = size / 4;
+			std::iter_swap(begin, begin + quarter);
+			std::iter_swap(end - 1, end - quarter);
+
+			if (size > NINTHER_THRESHOLD)
+			{
+				std::iter_swap(begin + 1, begin + quarter + 1);
+				std::iter_swap(begin + 2, begin + quarter + 2);
+				std::iter_swap(end - 2, end - quarter - 1);
+				std::iter_swap(end - 3, end - quarter - 2);
+			}
+		}
+
+		/// <summary>
+		/// Pattern-defeating quicksort.<br>
+		/// Falls back to heap sort after too many unbalanced partitions, so it is always O(n log n).
+		/// </summary>
+		/// <param name="badAllowed">Amount of unbalanced partitions allowed before falling back to heap sort.</param>
+		/// <param name="leftmost">If there are no values before begin. Otherwise the value before begin is a lower bound for the range.</param>
+		template <typename T, typename Compare>
+		void PdqSort(T* begin, T* end, Compare& compare, size_t badAllowed, bool leftmost)
+		{
+			while (true)
+			{
+				const size_t size = end - begin;
+				if (size < INSERTION_SORT_THRESHOLD)
+				{
+					InsertionSort(begin, end, compare);
+					return;
+				}
+
+				ChoosePivot(begin, end, compare);
+
+				// If the pivot is equal to the lower bound, every value equal to it can be skipped over at once.
+				if (!leftmost && !compare(*(begin - 1), *begin))
+				{
+					begin = PartitionLeft(begin, end, compare) + 1;
+					continue;
+				}
+
+				bool alreadyPartitioned;
+				T* pivotPos = PartitionRight(begin, end, compare, alreadyPartitioned);
+
+				const size_t leftSize = pivotPos - begin;
+				const size_t rightSize = end - (pivotPos + 1);
+
+				if (leftSize < size / 8 || rightSize < size / 8)
+				{
+					if (--badAllowed == 0)
+					{
+						std::make_heap(begin, end, compare);
+						std::sort_heap(begin, end, compare);
+						return;
+					}
+
+					BreakPatterns(begin, pivotPos);
+					BreakPatterns(pivotPos + 1, end);
+				}
+				// A range that did not need any swaps is likely to be sorted already.
+				else if (alreadyPartitioned && 
+					PartialInsertionSort(begin, pivotPos, compare) && 
+					PartialInsertionSort(pivotPos + 1, end, compare))
+					return;
+
+				// Recurse into the left side, and loop over the right side.
+				PdqSort(begin, pivotPos, compare, badAllowed, leftmost);
+				begin = pivotPos + 1;
+				leftmost = false;
+			}
+		}
+
+		template <typename T, typename Compare>
+		void Sort(T* begin, T* end, Compare& compare)
+		{
+			size_t size = end - begin;
+			size_t log = 0;
+			while (size >>= 1)
+				++log;
+			PdqSort(begin, end, compare, log + 1, true);
+		}
+
+		/// <summary>
+		/// Finds how many of the first k merged values come from a, when merging the sorted ranges a and b.<br>
+		/// Ties are taken from a first, which keeps the merge stable.
+		/// </summary>
+		template <typename T, typename Compare>
+		[[nodiscard]] size_t CoRank(const size_t k, const T* a, const size_t aCount, const T* b, const size_t bCount, Compare& compare)
+		{
+			size_t low = k > bCount ? k - bCount : 0;
+			size_t high = k < aCount ? k : aCount;
+
+			while (low < high)
+			{
+				const size_t i = (low + high) / 2;
+				const size_t j = k - i;
+
+				// If a[i] is not larger than b[j - 1], it belongs in the first k values as well.
+				if (j > 0 && !compare(b[j - 1], a[i]))
+					low = i + 1;
+				else
+					high = i;
+			}
+
+			return low;
+		}
+
+		template <typename T, typename Compare>
+		void Merge(const T* a, const T* aEnd, const T* b, const T* bEnd, T* dst, Compare& compare)
+		{
+			while (a != aEnd && b != bEnd)
+				*dst++ = compare(*b, *a) ? *b++ : *a++;
+			Copy(dst, a, aEnd - a);
+			Copy(dst + (aEnd - a), b, bEnd - b);
+		}
+	}
+
+	/// <summary>
+	/// Sorts all values between begin() and end() with a least significant digit radix sort.<br>
+	/// Runs in linear time, and skips bytes that are the same for every value.<br>
+	/// Temporarily allocates a buffer with the same size as the array.
+	/// </summary>
+	/// <param name="array">Array to sort. A Vector only sorts its current values.</param>
+	/// <param name="allocator">Allocator used for the temporary buffer.</param>
+	/// <param name="key">Called as key(const T&amp; value), returns the integer or floating point value to sort on.</param>
+	template <typename T, typename Key>
+	void RadixSort(Array<T>& array, LinearAllocator& allocator, Key key)
+	{
+		using namespace algorithmsImpl;
+
+		T* data = array.GetData();
+		const size_t count = array.end() - array.begin();
+		if (count < 2)
+			return;
+
+		using Radix = decltype(ToRadixKey(key(data[0])));
+		constexpr size_t passes = sizeof(Radix);
+
+		// Count the occurrences of every byte for every pass at once.
+		size_t counts[passes][256]{};
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Radix radix = ToRadixKey(key(data[i]));
+			for (size_t pass = 0; pass < passes; ++pass)
+				++counts[pass][static_cast<size_t>(radix >> pass * 8) & 0xFF];
+		}
+
+		T* temp = allocator.New<T>(count);
+		T* src = data;
+		T* dst = temp;
+
+		for (size_t pass = 0; pass < passes; ++pass)
+		{
+			auto& passCounts = counts[pass];
+
+			// Skip the pass if every value has the same byte.
+			const size_t first = static_cast<size_t>(ToRadixKey(key(src[0])) >> pass * 8) & 0xFF;
+			if (passCounts[first] == count)
+				continue;
+
+			// Convert the counts into offsets.
+			size_t offset = 0;
+			for (auto& bucket : passCounts)
+			{
+				const size_t bucketCount = bucket;
+				bucket = offset;
+				offset += bucketCount;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const size_t byte = static_cast<size_t>(ToRadixKey(key(src[i])) >> pass * 8) & 0xFF;
+				dst[passCounts[byte]++] = src[i];
+			}
+
+			std::swap(src, dst);
+		}
+
+		if (src != data)
+			Copy(data, src, count);
+		allocator.Free();
+	}
+
+	/// <summary>
+	/// Sorts all values between begin() and end() with a least significant digit radix sort.<br>
+	/// T has to be an integer or floating point type.
+	/// </summary>
+	/// <param name="array">Array to sort. A Vector only sorts its current values.</param>
+	/// <param name="allocator">Allocator used for the temporary buffer.</param>
+	template <typename T>
+	void RadixSort(Array<T>& array, LinearAllocator& allocator)
+	{
+		RadixSort(array, allocator, [](const T& value)
+		{
+			return value;
+		});
+	}
+
+	/// <summary>
+	/// Sorts all values between begin() and end() in place with pattern-defeating quicksort.<br>
+	/// Not stable. Runs in linear time on sorted and reverse sorted input, and is O(n log n) in the worst case.
+	/// </summary>
+	/// <param name="array">Array to sort. A Vector only sorts its current values.</param>
+	/// <param name="compare">Returns true if the first value should come before the second one.</param>
+	template <typename T, typename Compare = std::less<T>>
+	void Sort(Array<T>& array, Compare compare = {})
+	{
+		T* data = array.GetData();
+		algorithmsImpl::Sort(data, data + (array.end() - array.begin()), compare);
+	}
+
+	/// <summary>
+	/// Sorts all values between begin() and end() using all the workers of the scheduler.<br>
+	/// Every worker sorts a chunk, after which the chunks are merged in rounds.
+	/// Every merge is split up over the workers as well, so the last rounds do not end up on a single thread.<br>
+	/// Stable between chunks, but not within them. Temporarily allocates a buffer with the same size as the array.
+	/// </summary>
+	/// <param name="array">Array to sort. A Vector only sorts its current values.</param>
+	/// <param name="scheduler">Scheduler to run on. Has to be called from the thread that allocated it.</param>
+	/// <param name="allocator">Allocator used for the temporary buffer.</param>
+	/// <param name="compare">Returns true if the first value should come before the second one. Called from multiple threads.</param>
+	template <typename T, typename Compare = std::less<T>>
+	void ParallelSort(Array<T>& array, Scheduler& scheduler, LinearAllocator& allocator, Compare compare = {})
+	{
+		using namespace algorithmsImpl;
+
+		T* data = array.GetData();
+		const size_t count = array.end() - array.begin();
+		const size_t workerCount = scheduler.GetWorkerCount();
+
+		if (count < PARALLEL_SORT_THRESHOLD || workerCount < 2)
+		{
+			Sort(data, data + count, compare);
+			return;
+		}
+
+		// Sort the initial runs.
+		const size_t runCount = workerCount * 2;
+		size_t runSize = (count + runCount - 1) / runCount;
+		scheduler.ParallelFor(0, runCount, [data, count, runSize, &compare](const size_t index, LinearAllocator&)
+		{
+			const size_t begin = index * runSize;
+			const size_t end = begin + runSize < count ? begin + runSize : count;
+			if (begin < end)
+				Sort(data + begin, data + end, compare);
+		}, 1);
+
+		T* temp = allocator.New<T>(count);
+		T* src = data;
+		T* dst = temp;
+
+		// Merge pairs of runs until there is only one left.
+		// The output is divided into equally sized segments, so that every worker gets the same amount of work.
+		const size_t segmentCount = workerCount * 4;
+		const size_t segmentSize = (count + segmentCount - 1) / segmentCount;
+
+		for (; runSize < count; runSize *= 2)
+		{
+			scheduler.ParallelFor(0, segmentCount, [&](const size_t index, LinearAllocator&)
+			{
+				const size_t segmentBegin = index * segmentSize;
+				const size_t segmentEnd = segmentBegin + segmentSize < count ? segmentBegin + segmentSize : count;
+
+				// A segment can span multiple pairs of runs.
+				size_t out = segmentBegin;
+				while (out < segmentEnd)
+				{
+					const size_t pairBegin = out / (runSize * 2) * (runSize * 2);
+					const size_t middle = pairBegin + runSize < count ? pairBegin + runSize : count;
+					const size_t pairEnd = middle + runSize < count ? middle + runSize : count;
+					const size_t localEnd = segmentEnd < pairEnd ? segmentEnd : pairEnd;
+
+					const T* a = src + pairBegin;
+					const T* b = src + middle;
+					const size_t aCount = middle - pairBegin;
+					const size_t bCount = pairEnd - middle;
+
+					// Find out which parts of both runs end up in this part of the output.
+					const size_t iBegin = CoRank(out - pairBegin, a, aCount, b, bCount, compare);
+					const size_t iEnd = CoRank(localEnd - pairBegin, a, aCount, b, bCount, compare);
+					const size_t jBegin = out - pairBegin - iBegin;
+					const size_t jEnd = localEnd - pairBegin - iEnd;
+
+					Merge(a + iBegin, a + iEnd, b + jBegin, b + jEnd, dst + out, compare);
+					out = localEnd;
+				}
+			}, 1);
+
+			std::swap(src, dst);
+		}
+
+		if (src != data)
+			scheduler.ParallelFor(0, segmentCount, [data, src, count, segmentSize](const size_t index, LinearAllocator&)
+			{
+				const size_t begin = index * segmentSize;
+				const size_t end = begin + segmentSize < count ? begin + segmentSize : count;
+				if (begin < end)
+					Copy(data + begin, src + begin, end - begin);
+			}, 1);
+
+		allocator.Free();
+	}
+
+	/// <summary>
+	/// Moves all the values between begin() and end() for which the predicate returns true to the front.<br>
+	/// Not stable.
+	/// </summary>
+	/// <param name="array">Array to partition. A Vector only partitions its current values.</param>
+	/// <param name="predicate">Returns true for values that should be moved to the front.</param>
+	/// <returns>Index of the first value for which the predicate returned false.</returns>
+	template <typename T, typename Predicate>
+	size_t Partition(Array<T>& array, Predicate predicate)
+	{
+		T* begin = array.GetData();
+		T* first = begin;
+		T* last = begin + (array.end() - array.begin());
+
+		while (true)
+		{
+			while (first != last && predicate(*first))
+				++first;
+			while (first != last && !predicate(*(last - 1)))
+				--last;
+			if (first == last)
+				return first - begin;
+
+			std::iter_swap(first++, --last);
+		}
+	}
+
+	/// <summary>
+	/// Partially sorts the values between begin() and end(), so that the value at index n is the one that would be there if the array was sorted.<br>
+	/// Everything before it is not larger, everything after it is not smaller. Runs in linear time on average.
+	/// </summary>
+	/// <param name="array">Array to partially sort. A Vector only sorts its current values.</param>
+	/// <param name="n">Index of the value to put in place.</param>
+	/// <param name="compare">Returns true if the first value should come before the second one.</param>
+	template <typename T, typename Compare = std::less<T>>
+	void NthElement(Array<T>& array, const size_t n, Compare compare = {})
+	{
+		using namespace algorithmsImpl;
+
+		T* begin = array.GetData();
+		T* end = begin + (array.end() - array.begin());
+		assert(begin + n < end);
+		T* nth = begin + n;
+
+		// Fall back to sorting if the partitions keep being unbalanced.
+		size_t badAllowed = 8;
+		while (static_cast<size_t>(end - begin) >= INSERTION_SORT_THRESHOLD)
+		{
+			const size_t size = end - begin;
+			ChoosePivot(begin, end, compare);
+
+			bool alreadyPartitioned;
+			T* pivotPos = PartitionRight(begin, end, compare, alreadyPartitioned);
+			if (pivotPos == nth)
+				return;
+
+			const size_t leftSize = pivotPos - begin;
+			if ((leftSize < size / 8 || size - leftSize - 1 < size / 8) && --badAllowed == 0)
+			{
+				Sort(begin, end, compare);
+				return;
+			}
+
+			if (nth < pivotPos)
+				end = pivotPos;
+			else
+				begin = pivotPos + 1;
+		}
+
+		InsertionSort(begin, end, compare);
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Define JLB_ALLOCATOR_STATS in every translation unit to enable the LinearAllocator statistics and tracing.
+// When it is not defined, all the bookkeeping is compiled out and the allocator has the same size and speed as before.
+#ifdef JLB_ALLOCATOR_STATS
+
+// Maximum amount of different tags per allocator. Tag 0 is used for untagged allocations.
+#ifndef JLB_ALLOCATOR_MAX_TAGS
+#define JLB_ALLOCATOR_MAX_TAGS 32
+#endif
+// Amount of events the trace ring buffer remembers.
+#ifndef JLB_ALLOCATOR_TRACE_SIZE
+#define JLB_ALLOCATOR_TRACE_SIZE 256
+#endif
+
+#define JLB_ALLOCATOR_CONCAT_IMPL(a, b) a##b
+#define JLB_ALLOCATOR_CONCAT(a, b) JLB_ALLOCATOR_CONCAT_IMPL(a, b)
+// Attributes every allocation made by the allocator until the end of the scope to the tag.
+#define JLB_ALLOCATOR_TAG(allocator, tag) \
+	const jlb::LinearAllocator::TagScope JLB_ALLOCATOR_CONCAT(jlbAllocatorTag, __LINE__){ allocator, tag }
+
+#else
+#define JLB_ALLOCATOR_TAG(allocator, tag) static_cast<void>(0)
+#endif
+
+namespace jlb
+{
+	/// <summary>
+	/// Totals of a single LinearAllocator. Sizes include the size metadata of every allocation.
+	/// </summary>
+	struct AllocatorStats final
+	{
+		size_t usedBytes = 0;
+		size_t peakBytes = 0;
+		size_t mallocCount = 0;
+		size_t freeCount = 0;
+	};
+
+	/// <summary>
+	/// Totals of all the allocations made with the same tag.
+	/// </summary>
+	struct AllocatorTagStats final
+	{
+		const char* tag = nullptr;
+		size_t usedBytes = 0;
+		size_t peakBytes = 0;
+		// Bytes allocated over the lifetime of the allocator, including memory that has been freed since.
+		size_t totalBytes = 0;
+		size_t mallocCount = 0;
+	};
+
+	enum class AllocatorEvent : uint8_t
+	{
+		Malloc,
+		Free,
+		Resize,
+		Release
+	};
+
+	/// <summary>
+	/// Single entry in the trace of an allocator.
+	/// </summary>
+	struct AllocatorTraceEvent final
+	{
+		uint64_t sequence = 0;
+		AllocatorEvent event = AllocatorEvent::Malloc;
+		uint32_t tag = 0;
+		// Offset of the allocation from the start of the allocator's memory.
+		size_t offset = 0;
+		size_t size = 0;
+	};
+}
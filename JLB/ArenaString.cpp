@@ -0,0 +1,91 @@
+#include "ArenaString.h"
+#include "LinearAllocator.h"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+namespace jlb
+{
+	size_t HashString(const char* str, const size_t length)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (size_t i = 0; i < length; ++i)
+		{
+			hash ^= static_cast<unsigned char>(str[i]);
+			hash *= 1099511628211ull;
+		}
+		return static_cast<size_t>(hash);
+	}
+
+	void ArenaString::Allocate(LinearAllocator& allocator, const char* str)
+	{
+		assert(str);
+		Allocate(allocator, str, strlen(str));
+	}
+
+	void ArenaString::Allocate(LinearAllocator& allocator, const char* str, const size_t length)
+	{
+		_data = allocator.New<char>(length + 1);
+		_length = length;
+		memcpy(_data, str, length);
+		_data[length] = '\0';
+	}
+
+	void ArenaString::Free(LinearAllocator& allocator)
+	{
+		allocator.Free();
+		_data = nullptr;
+		_length = 0;
+	}
+
+	char& ArenaString::operator[](const size_t index)
+	{
+		assert(index < _length);
+		return _data[index];
+	}
+
+	const char* ArenaString::GetData() const
+	{
+		return _data;
+	}
+
+	size_t ArenaString::GetLength() const
+	{
+		return _length;
+	}
+
+	size_t ArenaString::GetHash() const
+	{
+		return HashString(_data, _length);
+	}
+
+	bool ArenaString::operator==(const ArenaString& other) const
+	{
+		return _length == other._length && (_length == 0 || memcmp(_data, other._data, _length) == 0);
+	}
+
+	bool ArenaString::operator==(const char* other) const
+	{
+		if (!other)
+			return false;
+		if (!_data)
+			return *other == '\0';
+		// Also compares the null terminator, so longer strings don't match.
+		return strncmp(_data, other, _length + 1) == 0;
+	}
+
+	bool ArenaString::operator!=(const ArenaString& other) const
+	{
+		return !operator==(other);
+	}
+
+	bool ArenaString::operator!=(const char* other) const
+	{
+		return !operator==(other);
+	}
+
+	ArenaString::operator const char* () const
+	{
+		return _data;
+	}
+}
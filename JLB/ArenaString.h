@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+
+namespace jlb
+{
+	class LinearAllocator;
+
+	/// <summary>
+	/// Hashes the characters of a string (FNV-1a).
+	/// </summary>
+	/// <param name="str">Characters to be hashed.</param>
+	/// <param name="length">Amount of characters.</param>
+	/// <returns>Hash of the characters.</returns>
+	[[nodiscard]] size_t HashString(const char* str, size_t length);
+
+	/// <summary>
+	/// String that copies its characters into memory from a linear allocator.<br>
+	/// Unlike StringView, the characters are copied, so the string does not depend on the lifetime of the source.<br>
+	/// Does not have ownership over the memory that it uses.
+	/// </summary>
+	class ArenaString final
+	{
+	public:
+		ArenaString() = default;
+		ArenaString(ArenaString& other) = delete;
+		ArenaString(ArenaString&& other) = delete;
+		ArenaString& operator=(ArenaString& other) = delete;
+		ArenaString& operator=(ArenaString&& other) = delete;
+
+		/// <summary>
+		/// Copies a null terminated string into memory from the allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="str">String to be copied.</param>
+		void Allocate(LinearAllocator& allocator, const char* str);
+		/// <summary>
+		/// Copies a range of characters into memory from the allocator. The copy is null terminated.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="str">Characters to be copied.</param>
+		/// <param name="length">Amount of characters to be copied.</param>
+		void Allocate(LinearAllocator& allocator, const char* str, size_t length);
+		/// <summary>
+		/// Frees the string from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		[[nodiscard]] char& operator[](size_t index);
+
+		/// <summary>
+		/// Returns the pointer to the null terminated characters.
+		/// </summary>
+		/// <returns>Pointer to the characters.</returns>
+		[[nodiscard]] const char* GetData() const;
+		/// <summary>
+		/// Gets the amount of characters, excluding the null terminator.
+		/// </summary>
+		/// <returns>Length of the string.</returns>
+		[[nodiscard]] size_t GetLength() const;
+		/// <summary>
+		/// Hashes the characters of the string.
+		/// </summary>
+		/// <returns>Hash of the string.</returns>
+		[[nodiscard]] size_t GetHash() const;
+
+		[[nodiscard]] bool operator==(const ArenaString& other) const;
+		[[nodiscard]] bool operator==(const char* other) const;
+		[[nodiscard]] bool operator!=(const ArenaString& other) const;
+		[[nodiscard]] bool operator!=(const char* other) const;
+
+		operator const char* () const;
+
+	private:
+		char* _data = nullptr;
+		size_t _length = 0;
+	};
+}
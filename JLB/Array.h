@@ -2,7 +2,9 @@
 #include <cassert>
 #include "LinearAllocator.h"
 #include "Iterator.h"
+#include "Kernels.h"
 #include <cstring>
+#include <type_traits>
 
 namespace jlb
 {
@@ -63,6 +65,15 @@ namespace jlb
 		[[nodiscard]] virtual Iterator<T> begin();
 		[[nodiscard]] virtual Iterator<T> end();
 
+	protected:
+		/// <summary>
+		/// Points the array to a different chunk of memory.<br>
+		/// Does not copy or free anything.
+		/// </summary>
+		/// <param name="memory">Memory to be managed.</param>
+		/// <param name="length">Length of the managed memory.</param>
+		void SetMemory(T* memory, size_t length);
+
 	private:
 		T* _memory = nullptr;
 		size_t _length = 0;
@@ -86,9 +97,7 @@ namespace jlb
 	{
 		_memory = allocator.New<T>(size);
 		_length = size;
-
-		for (size_t i = 0; i < size; ++i)
-			_memory[i] = fillValue;
+		Fill(_memory, size, fillValue);
 	}
 
 	template <typename T>
@@ -97,7 +106,11 @@ namespace jlb
 		_memory = allocator.New<T>(size);
 		_length = size;
 
-		memcpy(_memory, src, size * sizeof(T));
+		if constexpr (std::is_trivially_copyable_v<T>)
+			memcpy(_memory, src, size * sizeof(T));
+		else
+			for (size_t i = 0; i < size; ++i)
+				_memory[i] = src[i];
 	}
 
 	template <typename T>
@@ -121,23 +134,22 @@ namespace jlb
 		return _memory;
 	}
 
+	template <typename T>
+	void Array<T>::SetMemory(T* memory, const size_t length)
+	{
+		_memory = memory;
+		_length = length;
+	}
+
 	template <typename T>
 	Iterator<T> Array<T>::begin()
 	{
-		Iterator<T> it;
-		it.memory = _memory;
-		it.index = 0;
-		it.length = _length;
-		return it;
+		return Iterator<T>(_memory);
 	}
 
 	template <typename T>
 	Iterator<T> Array<T>::end()
 	{
-		Iterator<T> it;
-		it.memory = _memory;
-		it.index = _length;
-		it.length = _length;
-		return it;
+		return Iterator<T>(_memory + _length);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,821 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include "CacheLine.h"
+#include "LinearAllocator.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JLB_BTREE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace jlb
+{
+	/// <summary>
+	/// Key value pair returned when iterating over a BTree.
+	/// </summary>
+	template <typename K, typename V>
+	struct BTreeEntry final
+	{
+		const K& key;
+		V& value;
+	};
+
+	namespace btreeImpl
+	{
+		constexpr uint32_t NONE = UINT32_MAX;
+
+		// Counts the keys that are smaller than the key. Branchless, so that the compiler can vectorize it.
+		template <typename K>
+		[[nodiscard]] size_t CountLess(const K* keys, const size_t count, const K& key)
+		{
+			size_t result = 0;
+			for (size_t i = 0; i < count; ++i)
+				result += keys[i] < key;
+			return result;
+		}
+
+		// Counts the keys that are smaller than or equal to the key.
+		template <typename K>
+		[[nodiscard]] size_t CountLessEqual(const K* keys, const size_t count, const K& key)
+		{
+			size_t result = 0;
+			for (size_t i = 0; i < count; ++i)
+				result += !(key < keys[i]);
+			return result;
+		}
+
+#ifdef JLB_BTREE_SSE2
+		// Compares four keys at a time. Unsigned keys are compared as signed by flipping their sign bit.
+		template <bool Equal, bool Unsigned, typename K>
+		[[nodiscard]] size_t CountSse2(const K* keys, const size_t count, const K key)
+		{
+			const __m128i flip = _mm_set1_epi32(Unsigned ? INT32_MIN : 0);
+			const __m128i value = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(key)), flip);
+			size_t result = 0;
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), flip);
+				// Smaller or equal is the same as not greater.
+				const __m128i mask = Equal ? _mm_cmpgt_epi32(block, value) : _mm_cmplt_epi32(block, value);
+				const int bits = _mm_movemask_ps(_mm_castsi128_ps(mask));
+				const size_t matches = static_cast<size_t>((bits & 1) + (bits >> 1 & 1) + (bits >> 2 & 1) + (bits >> 3 & 1));
+				result += Equal ? 4 - matches : matches;
+			}
+			for (; i < count; ++i)
+				result += Equal ? !(key < keys[i]) : keys[i] < key;
+			return result;
+		}
+
+		[[nodiscard]] inline size_t CountLess(const int32_t* keys, const size_t count, const int32_t& key)
+		{
+			return CountSse2<false, false>(keys, count, key);
+		}
+
+		[[nodiscard]] inline size_t CountLess(const uint32_t* keys, const size_t count, const uint32_t& key)
+		{
+			return CountSse2<false, true>(keys, count, key);
+		}
+
+		[[nodiscard]] inline size_t CountLessEqual(const int32_t* keys, const size_t count, const int32_t& key)
+		{
+			return CountSse2<true, false>(keys, count, key);
+		}
+
+		[[nodiscard]] inline size_t CountLessEqual(const uint32_t* keys, const size_t count, const uint32_t& key)
+		{
+			return CountSse2<true, true>(keys, count, key);
+		}
+#endif
+
+		[[nodiscard]] constexpr size_t AlignUp(const size_t value, const size_t alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		// Largest amount of key value pairs that fit in a leaf of the given size.
+		template <typename K, typename V>
+		[[nodiscard]] constexpr size_t GetLeafCapacity(const size_t nodeSize)
+		{
+			size_t capacity = nodeSize / (sizeof(K) + sizeof(V));
+			while (capacity > 0 && AlignUp(AlignUp(AlignUp(2 * sizeof(uint32_t), alignof(K)) + capacity * sizeof(K), alignof(V)) +
+				capacity * sizeof(V), CACHE_LINE_SIZE) > nodeSize)
+				--capacity;
+			return capacity;
+		}
+
+		// Largest amount of keys that fit in an inner node of the given size, with one child more than keys.
+		template <typename K>
+		[[nodiscard]] constexpr size_t GetInnerCapacity(const size_t nodeSize)
+		{
+			size_t capacity = nodeSize / (sizeof(K) + sizeof(uint32_t));
+			while (capacity > 0 && AlignUp(AlignUp(AlignUp(sizeof(uint32_t), alignof(K)) + capacity * sizeof(K), alignof(uint32_t)) +
+				(capacity + 1) * sizeof(uint32_t), CACHE_LINE_SIZE) > nodeSize)
+				--capacity;
+			return capacity;
+		}
+	}
+
+	/// <summary>
+	/// Ordered map stored as a B+ tree, with the values in linked leaves.<br>
+	/// Nodes span a whole amount of cache lines and are aligned to them, and are searched with a vectorized count instead of a branchy binary search.<br>
+	/// Nodes come from a pool that is allocated up front, erased nodes are reused.<br>
+	/// Does not have ownership over the memory that it uses, and does not resize the capacity automatically.
+	/// </summary>
+	/// <typeparam name="K">Trivially copyable key type, ordered with operator&lt;.</typeparam>
+	/// <typeparam name="V">Trivially copyable value type.</typeparam>
+	/// <typeparam name="NodeSize">Size of a node in bytes, a multiple of the cache line size.</typeparam>
+	template <typename K, typename V, size_t NodeSize = CACHE_LINE_SIZE * 4>
+	class BTree final
+	{
+		static_assert(std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>, "Keys and values are moved with memmove.");
+		static_assert(NodeSize % CACHE_LINE_SIZE == 0, "Nodes should span whole cache lines.");
+
+	public:
+		static constexpr size_t LEAF_CAPACITY = btreeImpl::GetLeafCapacity<K, V>(NodeSize);
+		static constexpr size_t INNER_CAPACITY = btreeImpl::GetInnerCapacity<K>(NodeSize);
+		static_assert(LEAF_CAPACITY >= 4 && INNER_CAPACITY >= 4, "Nodes are too small for the key and value types.");
+
+		/// <summary>
+		/// Forward iterator over the key value pairs, in ascending order.
+		/// </summary>
+		class EntryIterator final
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = BTreeEntry<K, V>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = BTreeEntry<K, V>;
+
+			EntryIterator() = default;
+			EntryIterator(BTree* tree, uint32_t leaf, uint32_t index);
+
+			BTreeEntry<K, V> operator*() const;
+			EntryIterator& operator++();
+			EntryIterator operator++(int);
+
+			friend bool operator==(const EntryIterator& a, const EntryIterator& b)
+			{
+				return a._leaf == b._leaf && a._index == b._index;
+			}
+
+			friend bool operator!=(const EntryIterator& a, const EntryIterator& b)
+			{
+				return !(a == b);
+			}
+
+		private:
+			BTree* _tree = nullptr;
+			uint32_t _leaf = btreeImpl::NONE;
+			uint32_t _index = 0;
+		};
+
+		BTree() = default;
+		BTree(BTree& other) = delete;
+		BTree(BTree&& other) = delete;
+		BTree& operator=(BTree& other) = delete;
+		BTree& operator=(BTree&& other) = delete;
+
+		/// <summary>
+		/// Allocates enough nodes to store the capacity in the worst case, where every node is only half full.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="capacity">Maximum amount of key value pairs.</param>
+		void Allocate(LinearAllocator& allocator, size_t capacity);
+		/// <summary>
+		/// Frees the tree from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Inserts a key value pair, or replaces the value if the key is already in the tree.
+		/// </summary>
+		/// <param name="key">Key of the value.</param>
+		/// <param name="value">Value to be inserted.</param>
+		/// <returns>Inserted value.</returns>
+		V& Insert(const K& key, const V& value);
+		/// <summary>
+		/// Remove by key.
+		/// </summary>
+		/// <param name="key">Key of the value to be removed.</param>
+		/// <returns>If the key was in the tree.</returns>
+		bool Erase(const K& key);
+		/// <summary>
+		/// Removes all key value pairs.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Finds the value that belongs to the key.
+		/// </summary>
+		/// <param name="key">Key of the value.</param>
+		/// <returns>Pointer to the value, or nullptr if the key is not in the tree.</returns>
+		[[nodiscard]] V* Find(const K& key);
+		/// <summary>
+		/// Checks if the tree contains a certain key.
+		/// </summary>
+		[[nodiscard]] bool Contains(const K& key);
+		/// <summary>
+		/// Gets the value that belongs to the key. The key has to be in the tree.
+		/// </summary>
+		[[nodiscard]] V& operator[](const K& key);
+
+		/// <summary>
+		/// Gets an iterator to the first key that is not smaller than the given key.
+		/// </summary>
+		[[nodiscard]] EntryIterator LowerBound(const K& key);
+		/// <summary>
+		/// Calls the function for every pair with a key in [min, max], in ascending order.
+		/// </summary>
+		/// <param name="min">Smallest key in the range.</param>
+		/// <param name="max">Largest key in the range.</param>
+		/// <param name="function">Called as function(const K&amp; key, V&amp; value).</param>
+		template <typename Function>
+		void ForEachInRange(const K& min, const K& max, Function function);
+
+		/// <summary>
+		/// Gets the amount of key value pairs in the tree.
+		/// </summary>
+		[[nodiscard]] size_t GetCount() const;
+		/// <summary>
+		/// Gets the amount of nodes in use.
+		/// </summary>
+		[[nodiscard]] size_t GetNodeCount() const;
+		/// <summary>
+		/// Gets the amount of levels, including the leaves.
+		/// </summary>
+		[[nodiscard]] size_t GetDepth() const;
+
+		[[nodiscard]] EntryIterator begin();
+		[[nodiscard]] EntryIterator end();
+
+	private:
+		static constexpr size_t MIN_LEAF = LEAF_CAPACITY / 2;
+		static constexpr size_t MIN_INNER = INNER_CAPACITY / 2;
+		static constexpr size_t MAX_DEPTH = 32;
+
+		struct Leaf final
+		{
+			uint32_t count;
+			uint32_t next;
+			K keys[LEAF_CAPACITY];
+			V values[LEAF_CAPACITY];
+		};
+
+		struct Inner final
+		{
+			uint32_t count;
+			K keys[INNER_CAPACITY];
+			// Child i holds the keys smaller than key i, child i + 1 the keys that are equal or larger.
+			uint32_t children[INNER_CAPACITY + 1];
+		};
+
+		union alignas(CACHE_LINE_SIZE) Node
+		{
+			Leaf leaf;
+			Inner inner;
+			uint32_t nextFree;
+		};
+
+		static_assert(sizeof(Node) <= NodeSize);
+
+		// Node on the way from the root to a leaf, and the child that was taken.
+		struct Step final
+		{
+			uint32_t node;
+			uint32_t child;
+		};
+
+		Node* _nodes = nullptr;
+		uint32_t _nodeCapacity = 0;
+		// Nodes after this have never been used.
+		uint32_t _nodesUsed = 0;
+		uint32_t _freeNode = btreeImpl::NONE;
+		uint32_t _nodeCount = 0;
+		uint32_t _root = btreeImpl::NONE;
+		uint32_t _firstLeaf = btreeImpl::NONE;
+		uint32_t _depth = 0;
+		size_t _count = 0;
+
+		[[nodiscard]] uint32_t NewNode();
+		void FreeNode(uint32_t index);
+		// Descends to the leaf that could contain the key, and returns the depth of the leaf.
+		[[nodiscard]] size_t Descend(const K& key, Step* path);
+		void InsertIntoParent(Step* path, size_t depth, K key, uint32_t right);
+		void FixLeafUnderflow(Step* path, size_t depth);
+		void FixInnerUnderflow(Step* path, size_t depth);
+	};
+
+	template <typename K, typename V, size_t NodeSize>
+	BTree<K, V, NodeSize>::EntryIterator::EntryIterator(BTree* tree, const uint32_t leaf, const uint32_t index) :
+		_tree(tree), _leaf(leaf), _index(index)
+	{
+		// Iterators never point past the end of a leaf, so that they compare equal to the start of the next one.
+		if (_leaf != btreeImpl::NONE && _index == _tree->_nodes[_leaf].leaf.count)
+		{
+			_leaf = _tree->_nodes[_leaf].leaf.next;
+			_index = 0;
+		}
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	BTreeEntry<K, V> BTree<K, V, NodeSize>::EntryIterator::operator*() const
+	{
+		Leaf& leaf = _tree->_nodes[_leaf].leaf;
+		return { leaf.keys[_index], leaf.values[_index] };
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	typename BTree<K, V, NodeSize>::EntryIterator& BTree<K, V, NodeSize>::EntryIterator::operator++()
+	{
+		const Leaf& leaf = _tree->_nodes[_leaf].leaf;
+		if (++_index == leaf.count)
+		{
+			_leaf = leaf.next;
+			_index = 0;
+		}
+		return *this;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	typename BTree<K, V, NodeSize>::EntryIterator BTree<K, V, NodeSize>::EntryIterator::operator++(int)
+	{
+		EntryIterator temp = *this;
+		++*this;
+		return temp;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	void BTree<K, V, NodeSize>::Allocate(LinearAllocator& allocator, const size_t capacity)
+	{
+		assert(!_nodes);
+
+		// Worst case, every node is only half full.
+		size_t level = capacity / (MIN_LEAF > 0 ? MIN_LEAF : 1) + 1;
+		size_t nodeCount = level;
+		while (level > 1)
+		{
+			level = level / (MIN_INNER + 1) + 1;
+			nodeCount += level;
+		}
+		assert(nodeCount < btreeImpl::NONE);
+
+		// The linear allocator only aligns to sizeof(size_t), so align the nodes to their cache lines manually.
+		size_t space = sizeof(Node) * nodeCount + alignof(Node);
+		void* memory = allocator.Malloc(space);
+		_nodes = static_cast<Node*>(std::align(alignof(Node), sizeof(Node) * nodeCount, memory, space));
+		_nodeCapacity = static_cast<uint32_t>(nodeCount);
+		Clear();
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	void BTree<K, V, NodeSize>::Free(LinearAllocator& allocator)
+	{
+		allocator.Free();
+		_nodes = nullptr;
+		_nodeCapacity = 0;
+		Clear();
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	V& BTree<K, V, NodeSize>::Insert(const K& key, const V& value)
+	{
+		if (_root == btreeImpl::NONE)
+		{
+			_root = _firstLeaf = NewNode();
+			Leaf& leaf = _nodes[_root].leaf;
+			leaf.count = 0;
+			leaf.next = btreeImpl::NONE;
+			_depth = 1;
+		}
+
+		Step path[MAX_DEPTH];
+		const size_t depth = Descend(key, path);
+		uint32_t leafIndex = path[depth].node;
+		Leaf* leaf = &_nodes[leafIndex].leaf;
+		size_t index = btreeImpl::CountLess(leaf->keys, leaf->count, key);
+		if (index < leaf->count && !(key < leaf->keys[index]))
+			return leaf->values[index] = value;
+
+		if (leaf->count == LEAF_CAPACITY)
+		{
+			// Move the upper half into a new leaf, and continue with the half the key belongs in.
+			const uint32_t rightIndex = NewNode();
+			Leaf& right = _nodes[rightIndex].leaf;
+			leaf = &_nodes[leafIndex].leaf;
+			const size_t half = (LEAF_CAPACITY + 1) / 2;
+			right.count = static_cast<uint32_t>(LEAF_CAPACITY - half);
+			memcpy(right.keys, leaf->keys + half, right.count * sizeof(K));
+			memcpy(right.values, leaf->values + half, right.count * sizeof(V));
+			right.next = leaf->next;
+			leaf->next = rightIndex;
+			leaf->count = static_cast<uint32_t>(half);
+
+			if (index >= half)
+			{
+				index -= half;
+				leaf = &right;
+				leafIndex = rightIndex;
+			}
+			// Insert the key first, so that the separator is correct when the key becomes the first of the right leaf.
+			memmove(leaf->keys + index + 1, leaf->keys + index, (leaf->count - index) * sizeof(K));
+			memmove(leaf->values + index + 1, leaf->values + index, (leaf->count - index) * sizeof(V));
+			leaf->keys[index] = key;
+			leaf->values[index] = value;
+			++leaf->count;
+			++_count;
+
+			V& inserted = leaf->values[index];
+			InsertIntoParent(path, depth, right.keys[0], rightIndex);
+			return inserted;
+		}
+
+		memmove(leaf->keys + index + 1, leaf->keys + index, (leaf->count - index) * sizeof(K));
+		memmove(leaf->values + index + 1, leaf->values + index, (leaf->count - index) * sizeof(V));
+		leaf->keys[index] = key;
+		leaf->values[index] = value;
+		++leaf->count;
+		++_count;
+		return leaf->values[index];
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	bool BTree<K, V, NodeSize>::Erase(const K& key)
+	{
+		if (_root == btreeImpl::NONE)
+			return false;
+
+		Step path[MAX_DEPTH];
+		const size_t depth = Descend(key, path);
+		Leaf& leaf = _nodes[path[depth].node].leaf;
+		const size_t index = btreeImpl::CountLess(leaf.keys, leaf.count, key);
+		if (index == leaf.count || key < leaf.keys[index])
+			return false;
+
+		--leaf.count;
+		memmove(leaf.keys + index, leaf.keys + index + 1, (leaf.count - index) * sizeof(K));
+		memmove(leaf.values + index, leaf.values + index + 1, (leaf.count - index) * sizeof(V));
+		--_count;
+
+		// Separators do not have to be updated, as they stay smaller than or equal to the keys on their right.
+		if (depth == 0)
+		{
+			if (leaf.count == 0)
+				Clear();
+		}
+		else if (leaf.count < MIN_LEAF)
+			FixLeafUnderflow(path, depth);
+		return true;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	void BTree<K, V, NodeSize>::Clear()
+	{
+		_nodesUsed = 0;
+		_freeNode = btreeImpl::NONE;
+		_nodeCount = 0;
+		_root = btreeImpl::NONE;
+		_firstLeaf = btreeImpl::NONE;
+		_depth = 0;
+		_count = 0;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	V* BTree<K, V, NodeSize>::Find(const K& key)
+	{
+		if (_root == btreeImpl::NONE)
+			return nullptr;
+
+		uint32_t node = _root;
+		for (size_t level = 1; level < _depth; ++level)
+		{
+			const Inner& inner = _nodes[node].inner;
+			node = inner.children[btreeImpl::CountLessEqual(inner.keys, inner.count, key)];
+		}
+
+		Leaf& leaf = _nodes[node].leaf;
+		const size_t index = btreeImpl::CountLess(leaf.keys, leaf.count, key);
+		return index < leaf.count && !(key < leaf.keys[index]) ? &leaf.values[index] : nullptr;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	bool BTree<K, V, NodeSize>::Contains(const K& key)
+	{
+		return Find(key) != nullptr;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	V& BTree<K, V, NodeSize>::operator[](const K& key)
+	{
+		V* value = Find(key);
+		assert(value);
+		return *value;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	typename BTree<K, V, NodeSize>::EntryIterator BTree<K, V, NodeSize>::LowerBound(const K& key)
+	{
+		if (_root == btreeImpl::NONE)
+			return end();
+
+		Step path[MAX_DEPTH];
+		const size_t depth = Descend(key, path);
+		const Leaf& leaf = _nodes[path[depth].node].leaf;
+		return EntryIterator(this, path[depth].node, static_cast<uint32_t>(btreeImpl::CountLess(leaf.keys, leaf.count, key)));
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	template <typename Function>
+	void BTree<K, V, NodeSize>::ForEachInRange(const K& min, const K& max, Function function)
+	{
+		if (_root == btreeImpl::NONE)
+			return;
+
+		Step path[MAX_DEPTH];
+		const size_t depth = Descend(min, path);
+		uint32_t node = path[depth].node;
+		Leaf* leaf = &_nodes[node].leaf;
+		size_t index = btreeImpl::CountLess(leaf->keys, leaf->count, min);
+
+		// Walk the linked leaves, which are contiguous arrays of keys and values.
+		while (true)
+		{
+			for (; index < leaf->count; ++index)
+			{
+				if (max < leaf->keys[index])
+					return;
+				function(static_cast<const K&>(leaf->keys[index]), leaf->values[index]);
+			}
+			node = leaf->next;
+			if (node == btreeImpl::NONE)
+				return;
+			leaf = &_nodes[node].leaf;
+			index = 0;
+		}
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	size_t BTree<K, V, NodeSize>::GetCount() const
+	{
+		return _count;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	size_t BTree<K, V, NodeSize>::GetNodeCount() const
+	{
+		return _nodeCount;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	size_t BTree<K, V, NodeSize>::GetDepth() const
+	{
+		return _depth;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	typename BTree<K, V, NodeSize>::EntryIterator BTree<K, V, NodeSize>::begin()
+	{
+		return EntryIterator(this, _firstLeaf, 0);
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	typename BTree<K, V, NodeSize>::EntryIterator BTree<K, V, NodeSize>::end()
+	{
+		return EntryIterator(this, btreeImpl::NONE, 0);
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	uint32_t BTree<K, V, NodeSize>::NewNode()
+	{
+		uint32_t index = _freeNode;
+		if (index != btreeImpl::NONE)
+			_freeNode = _nodes[index].nextFree;
+		else
+		{
+			assert(_nodesUsed < _nodeCapacity);
+			index = _nodesUsed++;
+		}
+		++_nodeCount;
+		return index;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	void BTree<K, V, NodeSize>::FreeNode(const uint32_t index)
+	{
+		_nodes[index].nextFree = _freeNode;
+		_freeNode = index;
+		--_nodeCount;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	size_t BTree<K, V, NodeSize>::Descend(const K& key, Step* path)
+	{
+		uint32_t node = _root;
+		size_t level = 0;
+		for (; level + 1 < _depth; ++level)
+		{
+			const Inner& inner = _nodes[node].inner;
+			const uint32_t child = static_cast<uint32_t>(btreeImpl::CountLessEqual(inner.keys, inner.count, key));
+			path[level] = { node, child };
+			node = inner.children[child];
+		}
+		path[level] = { node, 0 };
+		return level;
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	void BTree<K, V, NodeSize>::InsertIntoParent(Step* path, size_t depth, K key, uint32_t right)
+	{
+		// Walk up while the parents are full, splitting them along the way.
+		while (depth > 0)
+		{
+			--depth;
+			const uint32_t parentIndex = path[depth].node;
+			Inner* parent = &_nodes[parentIndex].inner;
+			const size_t position = path[depth].child;
+
+			if (parent->count < INNER_CAPACITY)
+			{
+				memmove(parent->keys + position + 1, parent->keys + position, (parent->count - position) * sizeof(K));
+				memmove(parent->children + position + 2, parent->children + position + 1, (parent->count - position) * sizeof(uint32_t));
+				parent->keys[position] = key;
+				parent->children[position + 1] = right;
+				++parent->count;
+				return;
+			}
+
+			// Gather all keys and children, including the new one, and divide them over two nodes.
+			K keys[INNER_CAPACITY + 1];
+			uint32_t children[INNER_CAPACITY + 2];
+			memcpy(keys, parent->keys, position * sizeof(K));
+			keys[position] = key;
+			memcpy(keys + position + 1, parent->keys + position, (INNER_CAPACITY - position) * sizeof(K));
+			memcpy(children, parent->children, (position + 1) * sizeof(uint32_t));
+			children[position + 1] = right;
+			memcpy(children + position + 2, parent->children + position + 1, (INNER_CAPACITY - position) * sizeof(uint32_t));
+
+			const uint32_t siblingIndex = NewNode();
+			parent = &_nodes[parentIndex].inner;
+			Inner& sibling = _nodes[siblingIndex].inner;
+
+			// The middle key moves up instead of being copied.
+			const size_t half = (INNER_CAPACITY + 1) / 2;
+			parent->count = static_cast<uint32_t>(half);
+			memcpy(parent->keys, keys, half * sizeof(K));
+			memcpy(parent->children, children, (half + 1) * sizeof(uint32_t));
+			sibling.count = static_cast<uint32_t>(INNER_CAPACITY - half);
+			memcpy(sibling.keys, keys + half + 1, sibling.count * sizeof(K));
+			memcpy(sibling.children, children + half + 1, (sibling.count + 1) * sizeof(uint32_t));
+
+			key = keys[half];
+			right = siblingIndex;
+		}
+
+		// The root has been split, so the tree grows a level.
+		const uint32_t rootIndex = NewNode();
+		Inner& root = _nodes[rootIndex].inner;
+		root.count = 1;
+		root.keys[0] = key;
+		root.children[0] = _root;
+		root.children[1] = right;
+		_root = rootIndex;
+		++_depth;
+		assert(_depth < MAX_DEPTH);
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	void BTree<K, V, NodeSize>::FixLeafUnderflow(Step* path, const size_t depth)
+	{
+		const uint32_t leafIndex = path[depth].node;
+		Leaf& leaf = _nodes[leafIndex].leaf;
+		Inner& parent = _nodes[path[depth - 1].node].inner;
+		const size_t position = path[depth - 1].child;
+
+		// Borrow from a sibling that has values to spare.
+		if (position > 0)
+		{
+			Leaf& left = _nodes[parent.children[position - 1]].leaf;
+			if (left.count > MIN_LEAF)
+			{
+				memmove(leaf.keys + 1, leaf.keys, leaf.count * sizeof(K));
+				memmove(leaf.values + 1, leaf.values, leaf.count * sizeof(V));
+				--left.count;
+				leaf.keys[0] = left.keys[left.count];
+				leaf.values[0] = left.values[left.count];
+				++leaf.count;
+				parent.keys[position - 1] = leaf.keys[0];
+				return;
+			}
+		}
+		if (position < parent.count)
+		{
+			Leaf& right = _nodes[parent.children[position + 1]].leaf;
+			if (right.count > MIN_LEAF)
+			{
+				leaf.keys[leaf.count] = right.keys[0];
+				leaf.values[leaf.count] = right.values[0];
+				++leaf.count;
+				--right.count;
+				memmove(right.keys, right.keys + 1, right.count * sizeof(K));
+				memmove(right.values, right.values + 1, right.count * sizeof(V));
+				parent.keys[position] = right.keys[0];
+				return;
+			}
+		}
+
+		// Merge with a sibling, always into the leftmost of the two so that the leaf links stay intact.
+		const size_t separator = position > 0 ? position - 1 : position;
+		Leaf& target = _nodes[parent.children[separator]].leaf;
+		const uint32_t sourceIndex = parent.children[separator + 1];
+		Leaf& source = _nodes[sourceIndex].leaf;
+		memcpy(target.keys + target.count, source.keys, source.count * sizeof(K));
+		memcpy(target.values + target.count, source.values, source.count * sizeof(V));
+		target.count += source.count;
+		target.next = source.next;
+		FreeNode(sourceIndex);
+
+		memmove(parent.keys + separator, parent.keys + separator + 1, (parent.count - separator - 1) * sizeof(K));
+		memmove(parent.children + separator + 1, parent.children + separator + 2, (parent.count - separator - 1) * sizeof(uint32_t));
+		--parent.count;
+		FixInnerUnderflow(path, depth - 1);
+	}
+
+	template <typename K, typename V, size_t NodeSize>
+	void BTree<K, V, NodeSize>::FixInnerUnderflow(Step* path, const size_t depth)
+	{
+		const uint32_t nodeIndex = path[depth].node;
+		Inner& node = _nodes[nodeIndex].inner;
+
+		if (depth == 0)
+		{
+			// A root without keys only has a single child left, which becomes the new root.
+			if (node.count == 0)
+			{
+				_root = node.children[0];
+				FreeNode(nodeIndex);
+				--_depth;
+			}
+			return;
+		}
+		if (node.count >= MIN_INNER)
+			return;
+
+		Inner& parent = _nodes[path[depth - 1].node].inner;
+		const size_t position = path[depth - 1].child;
+
+		// Rotate a key and child through the parent from a sibling that has keys to spare.
+		if (position > 0)
+		{
+			Inner& left = _nodes[parent.children[position - 1]].inner;
+			if (left.count > MIN_INNER)
+			{
+				memmove(node.keys + 1, node.keys, node.count * sizeof(K));
+				memmove(node.children + 1, node.children, (node.count + 1) * sizeof(uint32_t));
+				node.keys[0] = parent.keys[position - 1];
+				node.children[0] = left.children[left.count];
+				++node.count;
+				parent.keys[position - 1] = left.keys[left.count - 1];
+				--left.count;
+				return;
+			}
+		}
+		if (position < parent.count)
+		{
+			Inner& right = _nodes[parent.children[position + 1]].inner;
+			if (right.count > MIN_INNER)
+			{
+				node.keys[node.count] = parent.keys[position];
+				node.children[node.count + 1] = right.children[0];
+				++node.count;
+				parent.keys[position] = right.keys[0];
+				memmove(right.keys, right.keys + 1, (right.count - 1) * sizeof(K));
+				memmove(right.children, right.children + 1, right.count * sizeof(uint32_t));
+				--right.count;
+				return;
+			}
+		}
+
+		// Merge with a sibling, pulling the separator down between them.
+		const size_t separator = position > 0 ? position - 1 : position;
+		Inner& target = _nodes[parent.children[separator]].inner;
+		const uint32_t sourceIndex = parent.children[separator + 1];
+		Inner& source = _nodes[sourceIndex].inner;
+		target.keys[target.count] = parent.keys[separator];
+		memcpy(target.keys + target.count + 1, source.keys, source.count * sizeof(K));
+		memcpy(target.children + target.count + 1, source.children, (source.count + 1) * sizeof(uint32_t));
+		target.count += source.count + 1;
+		FreeNode(sourceIndex);
+
+		memmove(parent.keys + separator, parent.keys + separator + 1, (parent.count - separator - 1) * sizeof(K));
+		memmove(parent.children + separator + 1, parent.children + separator + 2, (parent.count - separator - 1) * sizeof(uint32_t));
+		--parent.count;
+		FixInnerUnderflow(path, depth - 1);
+	}
+}
@@ -0,0 +1,181 @@
+#include "BitArray.h"
+#include <cassert>
+#include "Kernels.h"
+#include "LinearAllocator.h"
+
+namespace jlb
+{
+	void BitArray::Allocate(LinearAllocator& allocator, const size_t length, const bool value)
+	{
+		_length = length;
+		_wordCount = (length + BITS_PER_WORD - 1) / BITS_PER_WORD;
+		_words = allocator.New<uint64_t>(_wordCount);
+		value ? SetAll() : ResetAll();
+	}
+
+	void BitArray::Free(LinearAllocator& allocator)
+	{
+		allocator.Free();
+		_words = nullptr;
+		_length = 0;
+		_wordCount = 0;
+	}
+
+	void BitArray::Set(const size_t index)
+	{
+		assert(index < _length);
+		_words[index / BITS_PER_WORD] |= uint64_t(1) << index % BITS_PER_WORD;
+	}
+
+	void BitArray::Set(const size_t index, const bool value)
+	{
+		assert(index < _length);
+		// Branchless: clear the bit, then or in the new value.
+		const size_t shift = index % BITS_PER_WORD;
+		uint64_t& word = _words[index / BITS_PER_WORD];
+		word = (word & ~(uint64_t(1) << shift)) | static_cast<uint64_t>(value) << shift;
+	}
+
+	void BitArray::Reset(const size_t index)
+	{
+		assert(index < _length);
+		_words[index / BITS_PER_WORD] &= ~(uint64_t(1) << index % BITS_PER_WORD);
+	}
+
+	void BitArray::Flip(const size_t index)
+	{
+		assert(index < _length);
+		_words[index / BITS_PER_WORD] ^= uint64_t(1) << index % BITS_PER_WORD;
+	}
+
+	bool BitArray::Test(const size_t index) const
+	{
+		assert(index < _length);
+		return _words[index / BITS_PER_WORD] >> index % BITS_PER_WORD & 1;
+	}
+
+	bool BitArray::operator[](const size_t index) const
+	{
+		return Test(index);
+	}
+
+	void BitArray::SetAll()
+	{
+		if (_wordCount == 0)
+			return;
+		Fill(_words, _wordCount, ~uint64_t(0));
+		// Keep the unused bits unset, so that counting and scanning can work on whole words.
+		_words[_wordCount - 1] &= GetLastWordMask();
+	}
+
+	void BitArray::ResetAll()
+	{
+		Fill(_words, _wordCount, uint64_t(0));
+	}
+
+	size_t BitArray::Count() const
+	{
+		return PopCount(_words, _wordCount);
+	}
+
+	bool BitArray::Any() const
+	{
+		for (size_t i = 0; i < _wordCount; ++i)
+			if (_words[i])
+				return true;
+		return false;
+	}
+
+	size_t BitArray::FindFirstSet() const
+	{
+		return FindNextSet(0);
+	}
+
+	size_t BitArray::FindNextSet(const size_t start) const
+	{
+		if (start >= _length)
+			return SIZE_MAX;
+
+		// Mask out the bits before the start in the first word.
+		size_t i = start / BITS_PER_WORD;
+		uint64_t word = _words[i] & ~uint64_t(0) << start % BITS_PER_WORD;
+		while (true)
+		{
+			if (word)
+				return i * BITS_PER_WORD + bitArrayImpl::CountTrailingZeros(word);
+			if (++i == _wordCount)
+				return SIZE_MAX;
+			word = _words[i];
+		}
+	}
+
+	size_t BitArray::FindNextUnset(const size_t start) const
+	{
+		if (start >= _length)
+			return SIZE_MAX;
+
+		size_t i = start / BITS_PER_WORD;
+		uint64_t word = ~_words[i] & ~uint64_t(0) << start % BITS_PER_WORD;
+		while (true)
+		{
+			if (word)
+			{
+				// The unused bits of the last word show up as unset.
+				const size_t index = i * BITS_PER_WORD + bitArrayImpl::CountTrailingZeros(word);
+				return index < _length ? index : SIZE_MAX;
+			}
+			if (++i == _wordCount)
+				return SIZE_MAX;
+			word = ~_words[i];
+		}
+	}
+
+	void BitArray::And(const BitArray& other)
+	{
+		assert(_length == other._length);
+		for (size_t i = 0; i < _wordCount; ++i)
+			_words[i] &= other._words[i];
+	}
+
+	void BitArray::Or(const BitArray& other)
+	{
+		assert(_length == other._length);
+		for (size_t i = 0; i < _wordCount; ++i)
+			_words[i] |= other._words[i];
+	}
+
+	void BitArray::Xor(const BitArray& other)
+	{
+		assert(_length == other._length);
+		for (size_t i = 0; i < _wordCount; ++i)
+			_words[i] ^= other._words[i];
+	}
+
+	void BitArray::AndNot(const BitArray& other)
+	{
+		assert(_length == other._length);
+		for (size_t i = 0; i < _wordCount; ++i)
+			_words[i] &= ~other._words[i];
+	}
+
+	size_t BitArray::GetLength() const
+	{
+		return _length;
+	}
+
+	size_t BitArray::GetWordCount() const
+	{
+		return _wordCount;
+	}
+
+	uint64_t* BitArray::GetData()
+	{
+		return _words;
+	}
+
+	uint64_t BitArray::GetLastWordMask() const
+	{
+		const size_t used = _length % BITS_PER_WORD;
+		return used == 0 ? ~uint64_t(0) : (uint64_t(1) << used) - 1;
+	}
+}
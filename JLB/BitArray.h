@@ -0,0 +1,160 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace jlb
+{
+	class LinearAllocator;
+
+	namespace bitArrayImpl
+	{
+		// Index of the lowest set bit. The word cannot be zero.
+		[[nodiscard]] inline uint32_t CountTrailingZeros(const uint64_t word)
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			// Two 32 bit scans, so that it also works on 32 bit targets.
+			unsigned long index;
+			if (_BitScanForward(&index, static_cast<unsigned long>(word)))
+				return index;
+			_BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+			return index + 32;
+#else
+			return __builtin_ctzll(word);
+#endif
+		}
+	}
+
+	/// <summary>
+	/// Array of booleans that stores every value as a single bit, packed in 64 bit words.<br>
+	/// Counting and scanning are done a word at a time.<br>
+	/// Does not have ownership over the memory that it uses.
+	/// </summary>
+	class BitArray final
+	{
+	public:
+		static constexpr size_t BITS_PER_WORD = 64;
+
+		BitArray() = default;
+		BitArray(BitArray& other) = delete;
+		BitArray(BitArray&& other) = delete;
+		BitArray& operator=(BitArray& other) = delete;
+		BitArray& operator=(BitArray&& other) = delete;
+
+		/// <summary>
+		/// Allocates the words to store the bits in.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="length">Amount of bits.</param>
+		/// <param name="value">Value every bit will be initialized with.</param>
+		void Allocate(LinearAllocator& allocator, size_t length, bool value = false);
+		/// <summary>
+		/// Frees the array from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		void Set(size_t index);
+		void Set(size_t index, bool value);
+		void Reset(size_t index);
+		void Flip(size_t index);
+		[[nodiscard]] bool Test(size_t index) const;
+		[[nodiscard]] bool operator[](size_t index) const;
+
+		/// <summary>
+		/// Sets every bit to true.
+		/// </summary>
+		void SetAll();
+		/// <summary>
+		/// Sets every bit to false.
+		/// </summary>
+		void ResetAll();
+
+		/// <summary>
+		/// Counts the bits that are set.
+		/// </summary>
+		/// <returns>Amount of set bits.</returns>
+		[[nodiscard]] size_t Count() const;
+		/// <summary>
+		/// Checks if any bit is set.
+		/// </summary>
+		/// <returns>If any bit is set.</returns>
+		[[nodiscard]] bool Any() const;
+
+		/// <summary>
+		/// Finds the first set bit.
+		/// </summary>
+		/// <returns>Index of the first set bit, or SIZE_MAX if there is none.</returns>
+		[[nodiscard]] size_t FindFirstSet() const;
+		/// <summary>
+		/// Finds the first set bit from a certain index onwards.
+		/// </summary>
+		/// <param name="start">Index from where to start looking, including itself.</param>
+		/// <returns>Index of the set bit, or SIZE_MAX if there is none.</returns>
+		[[nodiscard]] size_t FindNextSet(size_t start) const;
+		/// <summary>
+		/// Finds the first bit that is not set from a certain index onwards.
+		/// </summary>
+		/// <param name="start">Index from where to start looking, including itself.</param>
+		/// <returns>Index of the unset bit, or SIZE_MAX if there is none.</returns>
+		[[nodiscard]] size_t FindNextUnset(size_t start = 0) const;
+		/// <summary>
+		/// Calls the function with the index of every set bit, in ascending order.
+		/// </summary>
+		template <typename Function>
+		void ForEachSet(Function function) const;
+
+		/// <summary>
+		/// Keeps only the bits that are also set in the other array. Both arrays need to have the same length.
+		/// </summary>
+		void And(const BitArray& other);
+		/// <summary>
+		/// Sets the bits that are set in the other array. Both arrays need to have the same length.
+		/// </summary>
+		void Or(const BitArray& other);
+		/// <summary>
+		/// Flips the bits that are set in the other array. Both arrays need to have the same length.
+		/// </summary>
+		void Xor(const BitArray& other);
+		/// <summary>
+		/// Clears the bits that are set in the other array. Both arrays need to have the same length.
+		/// </summary>
+		void AndNot(const BitArray& other);
+
+		/// <summary>
+		/// Gets the amount of bits in the array.
+		/// </summary>
+		/// <returns>Amount of bits.</returns>
+		[[nodiscard]] size_t GetLength() const;
+		/// <summary>
+		/// Gets the amount of words the bits are stored in.
+		/// </summary>
+		/// <returns>Amount of words.</returns>
+		[[nodiscard]] size_t GetWordCount() const;
+		/// <summary>
+		/// Get a raw pointer to the words. The unused bits of the last word have to stay unset.
+		/// </summary>
+		/// <returns>Raw pointer to the words.</returns>
+		[[nodiscard]] uint64_t* GetData();
+
+	private:
+		uint64_t* _words = nullptr;
+		size_t _length = 0;
+		size_t _wordCount = 0;
+
+		[[nodiscard]] uint64_t GetLastWordMask() const;
+	};
+
+	template <typename Function>
+	void BitArray::ForEachSet(Function function) const
+	{
+		for (size_t i = 0; i < _wordCount; ++i)
+		{
+			// Remove the lowest set bit every iteration.
+			for (uint64_t word = _words[i]; word; word &= word - 1)
+				function(i * BITS_PER_WORD + bitArrayImpl::CountTrailingZeros(word));
+		}
+	}
+}
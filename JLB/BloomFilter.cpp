@@ -0,0 +1,116 @@
+#include "BloomFilter.h"
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include "Kernels.h"
+#include "LinearAllocator.h"
+
+namespace jlb
+{
+	void BloomFilter::Allocate(LinearAllocator& allocator, const size_t capacity, const double falsePositiveRate)
+	{
+		assert(falsePositiveRate > 0 && falsePositiveRate < 1);
+
+		// The rate only goes down when blocks are added, so search for the smallest amount that is good enough.
+		size_t min = 1;
+		size_t max = capacity > 0 ? capacity : 1;
+		while (min < max)
+		{
+			const size_t mid = min + (max - min) / 2;
+			if (EstimateFalsePositiveRate(mid, capacity) <= falsePositiveRate)
+				max = mid;
+			else
+				min = mid + 1;
+		}
+		_blockCount = min;
+
+		// Align the blocks, so that none of them straddles two cache lines.
+		size_t space = _blockCount * BLOCK_SIZE + BLOCK_SIZE;
+		void* memory = allocator.Malloc(space);
+		_blocks = static_cast<uint32_t*>(std::align(BLOCK_SIZE, _blockCount * BLOCK_SIZE, memory, space));
+		Clear();
+	}
+
+	void BloomFilter::Free(LinearAllocator& allocator)
+	{
+		allocator.Free();
+		_blocks = nullptr;
+		_blockCount = 0;
+		_count = 0;
+	}
+
+	void BloomFilter::Insert(const size_t hash)
+	{
+		uint32_t blockHash;
+		uint32_t* block = _blocks + GetBlockIndex(hash, blockHash) * kernelsImpl::BLOOM_BLOCK_WORDS;
+		for (size_t i = 0; i < kernelsImpl::BLOOM_BLOCK_WORDS; ++i)
+			block[i] |= uint32_t(1) << (blockHash * kernelsImpl::BLOOM_SALTS[i] >> 27);
+		++_count;
+	}
+
+	bool BloomFilter::MayContain(const size_t hash) const
+	{
+		uint32_t blockHash;
+		const size_t index = GetBlockIndex(hash, blockHash);
+		return kernelsImpl::BloomBlockContains(_blocks + index * kernelsImpl::BLOOM_BLOCK_WORDS, blockHash);
+	}
+
+	void BloomFilter::Clear()
+	{
+		memset(_blocks, 0, _blockCount * BLOCK_SIZE);
+		_count = 0;
+	}
+
+	size_t BloomFilter::GetCount() const
+	{
+		return _count;
+	}
+
+	size_t BloomFilter::GetBlockCount() const
+	{
+		return _blockCount;
+	}
+
+	double BloomFilter::GetFalsePositiveRate() const
+	{
+		return EstimateFalsePositiveRate(_blockCount, _count);
+	}
+
+	double BloomFilter::EstimateFalsePositiveRate(const size_t blockCount, const size_t count)
+	{
+		// The amount of hashes per block follows a Poisson distribution, and every hash sets one of the 32 bits of each word.
+		// A lookup is a false positive if the eight bits it selects in its block have all been set.
+		const double mean = static_cast<double>(count) / static_cast<double>(blockCount);
+		// With more hashes than bits in a block, nearly every lookup is a false positive.
+		if (mean > BLOCK_SIZE * 8)
+			return 1;
+
+		const auto end = static_cast<size_t>(mean + 10 * std::sqrt(mean) + 20);
+		double probability = std::exp(-mean);
+		double rate = 0;
+		for (size_t i = 0; i < end; ++i)
+		{
+			rate += probability * std::pow(1 - std::pow(31.0 / 32.0, static_cast<double>(i)), kernelsImpl::BLOOM_BLOCK_WORDS);
+			probability *= mean / static_cast<double>(i + 1);
+		}
+		return rate;
+	}
+
+	size_t BloomFilter::GetBlockIndex(const size_t hash, uint32_t& outBlockHash) const
+	{
+		assert(_blocks);
+
+		// Mix the hash, so that hashes like the identity of an integer spread over the blocks and bits as well.
+		uint64_t mixed = hash;
+		mixed ^= mixed >> 33;
+		mixed *= 0xff51afd7ed558ccdULL;
+		mixed ^= mixed >> 33;
+		mixed *= 0xc4ceb9fe1a85ec53ULL;
+		mixed ^= mixed >> 33;
+
+		// Map the upper half onto the blocks with a multiply instead of a modulo, the lower half selects the bits.
+		outBlockHash = static_cast<uint32_t>(mixed);
+		return static_cast<size_t>((mixed >> 32) * _blockCount >> 32);
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace jlb
+{
+	class LinearAllocator;
+
+	/// <summary>
+	/// Approximate set of hashes that never gives false negatives, used to skip lookups of values that are not stored.<br>
+	/// Split block Bloom filter: every hash selects a single 32 byte block, and sets one bit in each of its eight words,
+	/// so a lookup touches one cache line and is tested with a single vector instruction.<br>
+	/// Hashes cannot be removed, clear and reinsert to get rid of them.<br>
+	/// Does not have ownership over the memory that it uses.
+	/// </summary>
+	class BloomFilter final
+	{
+	public:
+		static constexpr size_t BLOCK_SIZE = 32;
+
+		BloomFilter() = default;
+		BloomFilter(BloomFilter& other) = delete;
+		BloomFilter(BloomFilter&& other) = delete;
+		BloomFilter& operator=(BloomFilter& other) = delete;
+		BloomFilter& operator=(BloomFilter&& other) = delete;
+
+		/// <summary>
+		/// Allocates the smallest amount of blocks that keeps the false positive rate below the target when full.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="capacity">Amount of hashes that will be inserted.</param>
+		/// <param name="falsePositiveRate">Chance that a hash that has not been inserted is reported as contained, between 0 and 1.</param>
+		void Allocate(LinearAllocator& allocator, size_t capacity, double falsePositiveRate = 0.01);
+		/// <summary>
+		/// Frees the filter from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Adds a hash to the filter.
+		/// </summary>
+		/// <param name="hash">Hash of the value, does not need to be well distributed.</param>
+		void Insert(size_t hash);
+		/// <summary>
+		/// Checks if a hash might have been inserted.
+		/// </summary>
+		/// <param name="hash">Hash of the value.</param>
+		/// <returns>False if the hash has definitely not been inserted.</returns>
+		[[nodiscard]] bool MayContain(size_t hash) const;
+		/// <summary>
+		/// Removes all hashes.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Gets the amount of hashes inserted since the last clear, including duplicates.
+		/// </summary>
+		[[nodiscard]] size_t GetCount() const;
+		/// <summary>
+		/// Gets the amount of 32 byte blocks.
+		/// </summary>
+		[[nodiscard]] size_t GetBlockCount() const;
+		/// <summary>
+		/// Estimates the false positive rate for the current amount of hashes.
+		/// </summary>
+		[[nodiscard]] double GetFalsePositiveRate() const;
+		/// <summary>
+		/// Estimates the false positive rate of a filter.
+		/// </summary>
+		/// <param name="blockCount">Amount of blocks in the filter.</param>
+		/// <param name="count">Amount of unique hashes inserted.</param>
+		[[nodiscard]] static double EstimateFalsePositiveRate(size_t blockCount, size_t count);
+
+	private:
+		uint32_t* _blocks = nullptr;
+		size_t _blockCount = 0;
+		size_t _count = 0;
+
+		// Selects the block, and the hash that is used to select the bits inside of it.
+		[[nodiscard]] size_t GetBlockIndex(size_t hash, uint32_t& outBlockHash) const;
+	};
+}
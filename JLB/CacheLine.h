@@ -0,0 +1,9 @@
+#pragma once
+#include <cstddef>
+
+namespace jlb
+{
+	// Size in bytes of a single cache line.
+	// Data that is written to by different threads should be aligned to this to prevent false sharing.
+	constexpr size_t CACHE_LINE_SIZE = 64;
+}
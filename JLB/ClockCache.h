@@ -0,0 +1,336 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include "Array.h"
+#include "BitArray.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Operation counters of a ClockCache.
+	/// </summary>
+	struct CacheStats final
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+		// Values that were not in the cache yet when they were put.
+		size_t inserts = 0;
+		size_t evictions = 0;
+
+		/// <summary>
+		/// Gets the fraction of the lookups that found their value.
+		/// </summary>
+		[[nodiscard]] double GetHitRate() const;
+	};
+
+	/// <summary>
+	/// Cache with a fixed capacity that evicts values with the CLOCK policy, an approximation of least recently used.<br>
+	/// Values live in slots that the clock hand sweeps over, every slot has a referenced bit that is set when it is used
+	/// and gives it a second chance when the hand passes by.<br>
+	/// Keys are found through an open addressing index of slot numbers, so nothing is allocated after Allocate.<br>
+	/// Does not have ownership over the memory that it uses.
+	/// </summary>
+	/// <typeparam name="K">Key type, compared with operator==.</typeparam>
+	/// <typeparam name="V">Value type.</typeparam>
+	template <typename K, typename V>
+	class ClockCache final
+	{
+	public:
+		// Function used to get a hash value from a key.
+		size_t(*hasher)(const K& key) = nullptr;
+
+		ClockCache() = default;
+		ClockCache(ClockCache& other) = delete;
+		ClockCache(ClockCache&& other) = delete;
+		ClockCache& operator=(ClockCache& other) = delete;
+		ClockCache& operator=(ClockCache&& other) = delete;
+
+		/// <summary>
+		/// Allocates the slots, and an index with at least twice as many entries to keep the probes short.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="capacity">Maximum amount of values.</param>
+		void Allocate(LinearAllocator& allocator, size_t capacity);
+		/// <summary>
+		/// Frees the cache from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Finds the value that belongs to the key, and marks it as recently used.
+		/// </summary>
+		/// <param name="key">Key of the value.</param>
+		/// <returns>Pointer to the value, or nullptr if it is not cached.</returns>
+		[[nodiscard]] V* Get(const K& key);
+		/// <summary>
+		/// Caches a value, or replaces it if the key is already cached.<br>
+		/// When the cache is full, the value the clock hand finds first without a second chance is evicted.
+		/// </summary>
+		/// <param name="key">Key of the value.</param>
+		/// <param name="value">Value to be cached.</param>
+		/// <returns>Cached value.</returns>
+		V& Put(const K& key, const V& value);
+		/// <summary>
+		/// Remove by key.
+		/// </summary>
+		/// <param name="key">Key of the value to be removed.</param>
+		/// <returns>If the key was cached.</returns>
+		bool Erase(const K& key);
+		/// <summary>
+		/// Removes all values. Does not reset the statistics.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Checks if a key is cached, without counting it as a lookup or marking it as used.
+		/// </summary>
+		[[nodiscard]] bool Contains(const K& key);
+		/// <summary>
+		/// Gets the amount of cached values.
+		/// </summary>
+		[[nodiscard]] size_t GetCount() const;
+		/// <summary>
+		/// Gets the maximum amount of cached values.
+		/// </summary>
+		[[nodiscard]] size_t GetCapacity() const;
+
+		/// <summary>
+		/// Gets the hits, misses and evictions since the last reset.
+		/// </summary>
+		[[nodiscard]] const CacheStats& GetStats() const;
+		/// <summary>
+		/// Resets the operation counters.
+		/// </summary>
+		void ResetStats();
+
+	private:
+		static constexpr uint32_t EMPTY = UINT32_MAX;
+
+		// Index entries store the lower bits of the hash, so that most mismatches are found without comparing keys.
+		struct IndexEntry final
+		{
+			uint32_t slot = EMPTY;
+			uint32_t hash = 0;
+		};
+
+		Array<IndexEntry> _index{};
+		Array<K> _keys{};
+		Array<V> _values{};
+		BitArray _referenced{};
+		size_t _indexMask = 0;
+		size_t _count = 0;
+		size_t _hand = 0;
+		CacheStats _stats{};
+
+		[[nodiscard]] uint32_t GetHash(const K& key) const;
+		// Gets the position of the key in the index, or SIZE_MAX if it is not cached.
+		[[nodiscard]] size_t FindPosition(const K& key, uint32_t hash);
+		void AddToIndex(uint32_t slot, uint32_t hash);
+		void RemoveFromIndex(size_t position);
+		// Moves the clock hand to the first slot without a second chance, and removes its value.
+		[[nodiscard]] uint32_t Evict();
+	};
+
+	inline double CacheStats::GetHitRate() const
+	{
+		const size_t lookups = hits + misses;
+		return lookups > 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0;
+	}
+
+	template <typename K, typename V>
+	void ClockCache<K, V>::Allocate(LinearAllocator& allocator, const size_t capacity)
+	{
+		assert(capacity > 0 && capacity < EMPTY);
+
+		size_t indexLength = 1;
+		while (indexLength < capacity * 2)
+			indexLength *= 2;
+		_index.Allocate(allocator, indexLength);
+		_keys.Allocate(allocator, capacity);
+		_values.Allocate(allocator, capacity);
+		_referenced.Allocate(allocator, capacity);
+		_indexMask = indexLength - 1;
+		_count = 0;
+		_hand = 0;
+	}
+
+	template <typename K, typename V>
+	void ClockCache<K, V>::Free(LinearAllocator& allocator)
+	{
+		_referenced.Free(allocator);
+		_values.Free(allocator);
+		_keys.Free(allocator);
+		_index.Free(allocator);
+		_indexMask = 0;
+		_count = 0;
+		_hand = 0;
+	}
+
+	template <typename K, typename V>
+	V* ClockCache<K, V>::Get(const K& key)
+	{
+		const size_t position = FindPosition(key, GetHash(key));
+		if (position == SIZE_MAX)
+		{
+			++_stats.misses;
+			return nullptr;
+		}
+
+		++_stats.hits;
+		const uint32_t slot = _index[position].slot;
+		_referenced.Set(slot);
+		return &_values[slot];
+	}
+
+	template <typename K, typename V>
+	V& ClockCache<K, V>::Put(const K& key, const V& value)
+	{
+		const uint32_t hash = GetHash(key);
+		const size_t position = FindPosition(key, hash);
+		if (position != SIZE_MAX)
+		{
+			const uint32_t slot = _index[position].slot;
+			_referenced.Set(slot);
+			return _values[slot] = value;
+		}
+
+		const uint32_t slot = _count < _keys.GetLength() ? static_cast<uint32_t>(_count++) : Evict();
+		_keys[slot] = key;
+		_values[slot] = value;
+		// New values start without a second chance, so that values that are only used once are evicted first.
+		_referenced.Reset(slot);
+		AddToIndex(slot, hash);
+		++_stats.inserts;
+		return _values[slot];
+	}
+
+	template <typename K, typename V>
+	bool ClockCache<K, V>::Erase(const K& key)
+	{
+		const size_t position = FindPosition(key, GetHash(key));
+		if (position == SIZE_MAX)
+			return false;
+
+		const uint32_t slot = _index[position].slot;
+		RemoveFromIndex(position);
+
+		// Keep the slots dense by moving the last value into the gap.
+		const auto last = static_cast<uint32_t>(--_count);
+		if (slot != last)
+		{
+			const size_t lastPosition = FindPosition(_keys[last], GetHash(_keys[last]));
+			_index[lastPosition].slot = slot;
+			_keys[slot] = _keys[last];
+			_values[slot] = _values[last];
+			_referenced.Set(slot, _referenced.Test(last));
+		}
+		return true;
+	}
+
+	template <typename K, typename V>
+	void ClockCache<K, V>::Clear()
+	{
+		for (auto& entry : _index)
+			entry = {};
+		_count = 0;
+		_hand = 0;
+	}
+
+	template <typename K, typename V>
+	bool ClockCache<K, V>::Contains(const K& key)
+	{
+		return FindPosition(key, GetHash(key)) != SIZE_MAX;
+	}
+
+	template <typename K, typename V>
+	size_t ClockCache<K, V>::GetCount() const
+	{
+		return _count;
+	}
+
+	template <typename K, typename V>
+	size_t ClockCache<K, V>::GetCapacity() const
+	{
+		return _keys.GetLength();
+	}
+
+	template <typename K, typename V>
+	const CacheStats& ClockCache<K, V>::GetStats() const
+	{
+		return _stats;
+	}
+
+	template <typename K, typename V>
+	void ClockCache<K, V>::ResetStats()
+	{
+		_stats = {};
+	}
+
+	template <typename K, typename V>
+	uint32_t ClockCache<K, V>::GetHash(const K& key) const
+	{
+		assert(hasher);
+		return static_cast<uint32_t>(hasher(key));
+	}
+
+	template <typename K, typename V>
+	size_t ClockCache<K, V>::FindPosition(const K& key, const uint32_t hash)
+	{
+		// The index is never more than half full, so a probe always ends at an empty entry.
+		for (size_t position = hash & _indexMask;; position = (position + 1) & _indexMask)
+		{
+			const IndexEntry& entry = _index[position];
+			if (entry.slot == EMPTY)
+				return SIZE_MAX;
+			if (entry.hash == hash && _keys[entry.slot] == key)
+				return position;
+		}
+	}
+
+	template <typename K, typename V>
+	void ClockCache<K, V>::AddToIndex(const uint32_t slot, const uint32_t hash)
+	{
+		size_t position = hash & _indexMask;
+		while (_index[position].slot != EMPTY)
+			position = (position + 1) & _indexMask;
+		_index[position] = { slot, hash };
+	}
+
+	template <typename K, typename V>
+	void ClockCache<K, V>::RemoveFromIndex(size_t position)
+	{
+		// Shift the entries that come after it back, so that no lookup stops early at the gap.
+		size_t next = (position + 1) & _indexMask;
+		while (_index[next].slot != EMPTY)
+		{
+			// An entry can only move back if that does not put it in front of its home position.
+			const size_t home = _index[next].hash & _indexMask;
+			if (((next - home) & _indexMask) >= ((next - position) & _indexMask))
+			{
+				_index[position] = _index[next];
+				position = next;
+			}
+			next = (next + 1) & _indexMask;
+		}
+		_index[position] = {};
+	}
+
+	template <typename K, typename V>
+	uint32_t ClockCache<K, V>::Evict()
+	{
+		const size_t capacity = _keys.GetLength();
+		// Every slot that the hand passes loses its second chance, so this ends within one full sweep.
+		while (_referenced.Test(_hand))
+		{
+			_referenced.Reset(_hand);
+			_hand = _hand + 1 == capacity ? 0 : _hand + 1;
+		}
+
+		const auto slot = static_cast<uint32_t>(_hand);
+		_hand = _hand + 1 == capacity ? 0 : _hand + 1;
+		RemoveFromIndex(FindPosition(_keys[slot], GetHash(_keys[slot])));
+		++_stats.evictions;
+		return slot;
+	}
+}
@@ -0,0 +1,57 @@
+#include "ContainerStats.h"
+
+#ifdef JLB_CONTAINER_STATS
+namespace jlb
+{
+	namespace
+	{
+		void WriteHistogram(FILE* file, const char* name, const char* metric, const ProbeHistogram& histogram)
+		{
+			fprintf(file, "%s,%s_count,%zu\n", name, metric, histogram.count);
+			fprintf(file, "%s,%s_mean,%f\n", name, metric, histogram.GetMean());
+			fprintf(file, "%s,%s_max,%zu\n", name, metric, histogram.max);
+			for (size_t i = 0; i < JLB_PROBE_HISTOGRAM_SIZE; ++i)
+				if (histogram.buckets[i] > 0)
+					fprintf(file, "%s,%s_%zu%s,%zu\n", name, metric, i,
+						i + 1 == JLB_PROBE_HISTOGRAM_SIZE ? "+" : "", histogram.buckets[i]);
+		}
+	}
+
+	void ProbeHistogram::Record(const size_t length)
+	{
+		++count;
+		total += length;
+		max = length > max ? length : max;
+		++buckets[length < JLB_PROBE_HISTOGRAM_SIZE ? length : JLB_PROBE_HISTOGRAM_SIZE - 1];
+	}
+
+	double ProbeHistogram::GetMean() const
+	{
+		return count > 0 ? static_cast<double>(total) / static_cast<double>(count) : 0;
+	}
+
+	void WriteCsv(FILE* file, const char* name, const HashMapStats& stats)
+	{
+		WriteHistogram(file, name, "hit", stats.hits);
+		WriteHistogram(file, name, "miss", stats.misses);
+		WriteHistogram(file, name, "insert", stats.inserts);
+		fprintf(file, "%s,erases,%zu\n", name, stats.erases);
+	}
+
+	void WriteCsv(FILE* file, const char* name, const HashMapLayout& layout)
+	{
+		fprintf(file, "%s,count,%zu\n", name, layout.count);
+		fprintf(file, "%s,capacity,%zu\n", name, layout.capacity);
+		fprintf(file, "%s,load_factor,%f\n", name, layout.loadFactor);
+		fprintf(file, "%s,longest_cluster,%zu\n", name, layout.longestCluster);
+		WriteHistogram(file, name, "probe", layout.probes);
+	}
+
+	void WriteCsv(FILE* file, const char* name, const HeapStats& stats)
+	{
+		fprintf(file, "%s,swaps,%zu\n", name, stats.swaps);
+		WriteHistogram(file, name, "sift_up", stats.siftUps);
+		WriteHistogram(file, name, "sift_down", stats.siftDowns);
+	}
+}
+#endif
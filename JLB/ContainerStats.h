@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdio>
+
+// Define JLB_CONTAINER_STATS in every translation unit to let HashMap and Heap count what their operations cost.
+// When it is not defined, the counters are compiled out and the containers keep their original layout.
+#ifdef JLB_CONTAINER_STATS
+
+// Amount of buckets in a probe histogram. The last bucket also counts everything that is longer.
+#ifndef JLB_PROBE_HISTOGRAM_SIZE
+#define JLB_PROBE_HISTOGRAM_SIZE 16
+#endif
+
+namespace jlb
+{
+	/// <summary>
+	/// Distribution of lengths, like the amount of slots a HashMap lookup had to inspect.
+	/// </summary>
+	struct ProbeHistogram final
+	{
+		size_t count = 0;
+		size_t total = 0;
+		size_t max = 0;
+		// Bucket N counts lengths of N, the last bucket counts everything from there on.
+		size_t buckets[JLB_PROBE_HISTOGRAM_SIZE]{};
+
+		void Record(size_t length);
+		[[nodiscard]] double GetMean() const;
+	};
+
+	/// <summary>
+	/// Operation counters of a HashMap. Probe lengths are the amount of slots inspected, so a direct hit has a length of 1.
+	/// </summary>
+	struct HashMapStats final
+	{
+		// Lookups that found the value, including the ones done by Erase.
+		ProbeHistogram hits{};
+		// Lookups that did not find the value, including the ones done by Insert.
+		ProbeHistogram misses{};
+		// Slots inspected to find an empty slot for a new value.
+		ProbeHistogram inserts{};
+		size_t erases = 0;
+	};
+
+	/// <summary>
+	/// Snapshot of how the values of a HashMap are spread over its slots.
+	/// </summary>
+	struct HashMapLayout final
+	{
+		size_t count = 0;
+		size_t capacity = 0;
+		double loadFactor = 0;
+		// Slots a lookup inspects to find every stored value.
+		ProbeHistogram probes{};
+		// Longest run of occupied slots.
+		size_t longestCluster = 0;
+	};
+
+	/// <summary>
+	/// Operation counters of a Heap. Sift depths are the amount of swaps a single insert or pop needed.
+	/// </summary>
+	struct HeapStats final
+	{
+		size_t swaps = 0;
+		ProbeHistogram siftUps{};
+		ProbeHistogram siftDowns{};
+	};
+
+	/// <summary>
+	/// Writes the counters as CSV rows of container,metric,value, so that multiple containers can share a file.
+	/// </summary>
+	/// <param name="file">File opened for writing.</param>
+	/// <param name="name">Name of the container.</param>
+	/// <param name="stats">Counters to write.</param>
+	void WriteCsv(FILE* file, const char* name, const HashMapStats& stats);
+	/// <summary>
+	/// Writes the layout as CSV rows of container,metric,value.
+	/// </summary>
+	void WriteCsv(FILE* file, const char* name, const HashMapLayout& layout);
+	/// <summary>
+	/// Writes the counters as CSV rows of container,metric,value.
+	/// </summary>
+	void WriteCsv(FILE* file, const char* name, const HeapStats& stats);
+}
+#endif
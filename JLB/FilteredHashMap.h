@@ -0,0 +1,144 @@
+#pragma once
+#include "BloomFilter.h"
+#include "HashMap.h"
+
+namespace jlb
+{
+	class SnapshotWriter;
+	class SnapshotReader;
+
+	/// <summary>
+	/// HashMap with a BloomFilter in front of it, so that most lookups of values that are not stored
+	/// are rejected with a single cache line access instead of a scan through the table.<br>
+	/// Erased values stay in the filter, which only makes it less effective. Call RebuildFilter after erasing a lot of values.<br>
+	/// The HashMap is not a public base, so that values cannot be inserted around the filter.
+	/// </summary>
+	template <typename T>
+	class FilteredHashMap final : HashMap<T>
+	{
+	public:
+		/// <summary>
+		/// Allocates the table and the filter.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="size">Size of the table.</param>
+		/// <param name="falsePositiveRate">Chance that the filter lets a missing value through to the table when it is full.</param>
+		void Allocate(LinearAllocator& allocator, size_t size, double falsePositiveRate);
+		void Allocate(LinearAllocator& allocator, size_t size, const KeyPair<T>& fillValue = {}) override;
+		void Allocate(LinearAllocator& allocator, size_t size, KeyPair<T>* src) override;
+		void Free(LinearAllocator& allocator) override;
+
+		/// <summary>
+		/// Inserts a value into the hashset. Does not store duplicates.
+		/// </summary>
+		/// <param name="value">Value to be inserted.</param>
+		void Insert(T& value);
+		/// <summary>
+		/// Inserts a value into the hashset. Does not store duplicates.
+		/// </summary>
+		/// <param name="value">Value to be inserted.</param>
+		void Insert(T&& value);
+		/// <summary>
+		/// Checks if the HashMap contains a certain value, only searching the table if the filter cannot rule it out.
+		/// </summary>
+		/// <param name="value">Value to be checked.</param>
+		/// <returns>If the HashMap contains the value.</returns>
+		[[nodiscard]] bool Contains(T& value);
+
+		/// <summary>
+		/// Clears the filter and inserts the values that are still stored, removing the ones that have been erased.
+		/// </summary>
+		void RebuildFilter();
+		/// <summary>
+		/// Gets the filter in front of the table.
+		/// </summary>
+		[[nodiscard]] const BloomFilter& GetFilter() const;
+
+		using HashMap<T>::hasher;
+		using HashMap<T>::Erase;
+		using HashMap<T>::GetCount;
+#ifdef JLB_CONTAINER_STATS
+		using HashMap<T>::GetStats;
+		using HashMap<T>::ResetStats;
+		using HashMap<T>::GetLayout;
+#endif
+
+	private:
+		// Reads and writes the table through the HashMap, and rebuilds the filter afterwards.
+		friend class SnapshotWriter;
+		friend class SnapshotReader;
+
+		// Rate used when the map is allocated through the Array interface.
+		static constexpr double DEFAULT_FALSE_POSITIVE_RATE = 0.01;
+
+		BloomFilter _filter{};
+	};
+
+	template <typename T>
+	void FilteredHashMap<T>::Allocate(LinearAllocator& allocator, const size_t size, const double falsePositiveRate)
+	{
+		HashMap<T>::Allocate(allocator, size);
+		_filter.Allocate(allocator, size, falsePositiveRate);
+	}
+
+	template <typename T>
+	void FilteredHashMap<T>::Allocate(LinearAllocator& allocator, const size_t size, const KeyPair<T>& fillValue)
+	{
+		HashMap<T>::Allocate(allocator, size, fillValue);
+		_filter.Allocate(allocator, size, DEFAULT_FALSE_POSITIVE_RATE);
+		RebuildFilter();
+	}
+
+	template <typename T>
+	void FilteredHashMap<T>::Allocate(LinearAllocator& allocator, const size_t size, KeyPair<T>* src)
+	{
+		HashMap<T>::Allocate(allocator, size, src);
+		_filter.Allocate(allocator, size, DEFAULT_FALSE_POSITIVE_RATE);
+		RebuildFilter();
+	}
+
+	template <typename T>
+	void FilteredHashMap<T>::Free(LinearAllocator& allocator)
+	{
+		_filter.Free(allocator);
+		HashMap<T>::Free(allocator);
+	}
+
+	template <typename T>
+	void FilteredHashMap<T>::Insert(T& value)
+	{
+		assert(this->hasher);
+		_filter.Insert(this->hasher(value));
+		HashMap<T>::Insert(value);
+	}
+
+	template <typename T>
+	void FilteredHashMap<T>::Insert(T&& value)
+	{
+		Insert(value);
+	}
+
+	template <typename T>
+	bool FilteredHashMap<T>::Contains(T& value)
+	{
+		assert(this->hasher);
+		if (!_filter.MayContain(this->hasher(value)))
+			return false;
+		return HashMap<T>::Contains(value);
+	}
+
+	template <typename T>
+	void FilteredHashMap<T>::RebuildFilter()
+	{
+		_filter.Clear();
+		for (auto& keyPair : *static_cast<Array<KeyPair<T>>*>(this))
+			if (keyPair.key != SIZE_MAX)
+				_filter.Insert(this->hasher(keyPair.value));
+	}
+
+	template <typename T>
+	const BloomFilter& FilteredHashMap<T>::GetFilter() const
+	{
+		return _filter;
+	}
+}
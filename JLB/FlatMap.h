@@ -0,0 +1,308 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include "Algorithms.h"
+#include "Span.h"
+#include "Vector.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Ordered map that stores its keys and values in two separate sorted arrays.<br>
+	/// Lookups are a branchless binary search over the keys only, which keeps them cache friendly for read-mostly tables.<br>
+	/// Insertions and removals shift the values behind them, so prefer Build for filling the map.<br>
+	/// Does not have ownership over the memory that it uses, and does not resize the capacity automatically.
+	/// </summary>
+	/// <typeparam name="K">Key type, ordered with operator&lt;.</typeparam>
+	/// <typeparam name="V">Value type.</typeparam>
+	template <typename K, typename V>
+	class FlatMap final
+	{
+	public:
+		FlatMap() = default;
+		FlatMap(FlatMap& other) = delete;
+		FlatMap(FlatMap&& other) = delete;
+		FlatMap& operator=(FlatMap& other) = delete;
+		FlatMap& operator=(FlatMap&& other) = delete;
+
+		/// <summary>
+		/// Allocates the key and value arrays.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="capacity">Maximum amount of key value pairs.</param>
+		void Allocate(LinearAllocator& allocator, size_t capacity);
+		/// <summary>
+		/// Frees the map from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Replaces the contents of the map with unsorted key value pairs, in O(n log n).<br>
+		/// When a key occurs more than once, the last value is kept.
+		/// </summary>
+		/// <param name="allocator">Allocator used for a temporary buffer.</param>
+		/// <param name="keys">Keys, in any order.</param>
+		/// <param name="values">Values that belong to the keys.</param>
+		/// <param name="count">Amount of pairs. Cannot exceed the capacity.</param>
+		void Build(LinearAllocator& allocator, const K* keys, const V* values, size_t count);
+		/// <summary>
+		/// Inserts a key value pair, or replaces the value if the key is already in the map.
+		/// </summary>
+		/// <param name="key">Key of the value.</param>
+		/// <param name="value">Value to be inserted.</param>
+		/// <returns>Inserted value.</returns>
+		V& Insert(const K& key, const V& value);
+		/// <summary>
+		/// Remove by key.
+		/// </summary>
+		/// <param name="key">Key of the value to be removed.</param>
+		/// <returns>If the key was in the map.</returns>
+		bool Erase(const K& key);
+		/// <summary>
+		/// Removes all key value pairs.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Finds the value that belongs to the key.
+		/// </summary>
+		/// <param name="key">Key of the value.</param>
+		/// <returns>Pointer to the value, or nullptr if the key is not in the map.</returns>
+		[[nodiscard]] V* Find(const K& key);
+		/// <summary>
+		/// Checks if the map contains a certain key.
+		/// </summary>
+		/// <param name="key">Key to be checked.</param>
+		/// <returns>If the map contains the key.</returns>
+		[[nodiscard]] bool Contains(const K& key);
+		/// <summary>
+		/// Gets the value that belongs to the key. The key has to be in the map.
+		/// </summary>
+		/// <param name="key">Key of the value.</param>
+		/// <returns>Value that belongs to the key.</returns>
+		[[nodiscard]] V& operator[](const K& key);
+
+		/// <summary>
+		/// Finds the index of the first key that is not smaller than the given key.
+		/// </summary>
+		/// <param name="key">Key to compare with.</param>
+		/// <returns>Index of the key, or the count if all keys are smaller.</returns>
+		[[nodiscard]] size_t LowerBound(const K& key);
+		/// <summary>
+		/// Finds the index of the first key that is larger than the given key.
+		/// </summary>
+		/// <param name="key">Key to compare with.</param>
+		/// <returns>Index of the key, or the count if no key is larger.</returns>
+		[[nodiscard]] size_t UpperBound(const K& key);
+		/// <summary>
+		/// Calls the function for every pair with a key in [min, max], in ascending order.
+		/// </summary>
+		/// <param name="min">Smallest key in the range.</param>
+		/// <param name="max">Largest key in the range.</param>
+		/// <param name="function">Called as function(const K&amp; key, V&amp; value).</param>
+		template <typename Function>
+		void ForEachInRange(const K& min, const K& max, Function function);
+
+		/// <summary>
+		/// Gets a view over the sorted keys.
+		/// </summary>
+		[[nodiscard]] Span<K> GetKeys();
+		/// <summary>
+		/// Gets a view over the values, in the same order as the keys.
+		/// </summary>
+		[[nodiscard]] Span<V> GetValues();
+
+		/// <summary>
+		/// Gets the amount of key value pairs in the map.
+		/// </summary>
+		/// <returns>Amount of key value pairs in the map.</returns>
+		[[nodiscard]] size_t GetCount() const;
+		/// <summary>
+		/// Gets the maximum amount of key value pairs in the map.
+		/// </summary>
+		/// <returns>Capacity of the map.</returns>
+		[[nodiscard]] size_t GetCapacity() const;
+
+	private:
+		Vector<K> _keys{};
+		Vector<V> _values{};
+	};
+
+	template <typename K, typename V>
+	void FlatMap<K, V>::Allocate(LinearAllocator& allocator, const size_t capacity)
+	{
+		_keys.Allocate(allocator, capacity);
+		_values.Allocate(allocator, capacity);
+	}
+
+	template <typename K, typename V>
+	void FlatMap<K, V>::Free(LinearAllocator& allocator)
+	{
+		_values.Free(allocator);
+		_keys.Free(allocator);
+	}
+
+	template <typename K, typename V>
+	void FlatMap<K, V>::Build(LinearAllocator& allocator, const K* keys, const V* values, const size_t count)
+	{
+		assert(count <= _keys.GetLength());
+		assert(count <= UINT32_MAX);
+		Clear();
+		if (count == 0)
+			return;
+
+		// Sort the indices instead of the pairs, so that the input does not have to be modified.
+		// Ties are ordered by index, so the last occurrence of a key ends up last.
+		uint32_t* indices = allocator.New<uint32_t>(count);
+		for (size_t i = 0; i < count; ++i)
+			indices[i] = static_cast<uint32_t>(i);
+		auto compare = [keys](const uint32_t a, const uint32_t b)
+		{
+			if (keys[a] < keys[b])
+				return true;
+			if (keys[b] < keys[a])
+				return false;
+			return a < b;
+		};
+		algorithmsImpl::Sort(indices, indices + count, compare);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint32_t index = indices[i];
+			const size_t last = _keys.GetCount();
+			if (last > 0 && !(_keys[last - 1] < keys[index]))
+			{
+				_values[last - 1] = values[index];
+				continue;
+			}
+			_keys.Add(K(keys[index]));
+			_values.Add(V(values[index]));
+		}
+
+		allocator.Free();
+	}
+
+	template <typename K, typename V>
+	V& FlatMap<K, V>::Insert(const K& key, const V& value)
+	{
+		const size_t index = LowerBound(key);
+		if (index < _keys.GetCount() && !(key < _keys[index]))
+			return _values[index] = value;
+
+		_keys.InsertAt(index, K(key));
+		return _values.InsertAt(index, V(value));
+	}
+
+	template <typename K, typename V>
+	bool FlatMap<K, V>::Erase(const K& key)
+	{
+		const size_t index = LowerBound(key);
+		if (index == _keys.GetCount() || key < _keys[index])
+			return false;
+
+		_keys.RemoveAtStable(index);
+		_values.RemoveAtStable(index);
+		return true;
+	}
+
+	template <typename K, typename V>
+	void FlatMap<K, V>::Clear()
+	{
+		_keys.Clear();
+		_values.Clear();
+	}
+
+	template <typename K, typename V>
+	V* FlatMap<K, V>::Find(const K& key)
+	{
+		const size_t index = LowerBound(key);
+		if (index == _keys.GetCount() || key < _keys[index])
+			return nullptr;
+		return &_values[index];
+	}
+
+	template <typename K, typename V>
+	bool FlatMap<K, V>::Contains(const K& key)
+	{
+		return Find(key) != nullptr;
+	}
+
+	template <typename K, typename V>
+	V& FlatMap<K, V>::operator[](const K& key)
+	{
+		V* value = Find(key);
+		assert(value);
+		return *value;
+	}
+
+	template <typename K, typename V>
+	size_t FlatMap<K, V>::LowerBound(const K& key)
+	{
+		const K* data = _keys.GetData();
+		size_t count = _keys.GetCount();
+		if (count == 0)
+			return 0;
+
+		// Halve the range every step by moving the base, which compiles to a conditional move instead of a branch.
+		const K* base = data;
+		while (count > 1)
+		{
+			const size_t half = count / 2;
+			base = base[half] < key ? base + half : base;
+			count -= half;
+		}
+		return static_cast<size_t>(base - data) + (*base < key);
+	}
+
+	template <typename K, typename V>
+	size_t FlatMap<K, V>::UpperBound(const K& key)
+	{
+		const K* data = _keys.GetData();
+		size_t count = _keys.GetCount();
+		if (count == 0)
+			return 0;
+
+		const K* base = data;
+		while (count > 1)
+		{
+			const size_t half = count / 2;
+			base = key < base[half] ? base : base + half;
+			count -= half;
+		}
+		return static_cast<size_t>(base - data) + !(key < *base);
+	}
+
+	template <typename K, typename V>
+	template <typename Function>
+	void FlatMap<K, V>::ForEachInRange(const K& min, const K& max, Function function)
+	{
+		const size_t end = UpperBound(max);
+		for (size_t i = LowerBound(min); i < end; ++i)
+			function(static_cast<const K&>(_keys[i]), _values[i]);
+	}
+
+	template <typename K, typename V>
+	Span<K> FlatMap<K, V>::GetKeys()
+	{
+		return { _keys.GetData(), _keys.GetCount() };
+	}
+
+	template <typename K, typename V>
+	Span<V> FlatMap<K, V>::GetValues()
+	{
+		return { _values.GetData(), _values.GetCount() };
+	}
+
+	template <typename K, typename V>
+	size_t FlatMap<K, V>::GetCount() const
+	{
+		return _keys.GetCount();
+	}
+
+	template <typename K, typename V>
+	size_t FlatMap<K, V>::GetCapacity() const
+	{
+		return _keys.GetLength();
+	}
+}
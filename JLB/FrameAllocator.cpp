@@ -0,0 +1,72 @@
+#include "FrameAllocator.h"
+#include <cassert>
+#include <new>
+
+namespace jlb
+{
+	void FrameAllocator::Allocate(LinearAllocator& allocator, const size_t frameCount, size_t frameSize)
+	{
+		assert(frameCount > 0);
+		assert(!_frames);
+
+		// Keep every region aligned like the allocator itself.
+		frameSize = (frameSize + sizeof(size_t) - 1) / sizeof(size_t) * sizeof(size_t);
+		_frames = allocator.New<LinearAllocator>(frameCount);
+		auto memory = static_cast<char*>(allocator.Malloc(frameCount * frameSize));
+		for (size_t i = 0; i < frameCount; ++i)
+			new (&_frames[i]) LinearAllocator(memory + i * frameSize, frameSize);
+
+		_frameCount = frameCount;
+		_current = 0;
+		_frameIndex = 0;
+	}
+
+	void FrameAllocator::Free(LinearAllocator& allocator)
+	{
+		for (size_t i = 0; i < _frameCount; ++i)
+			_frames[i].~LinearAllocator();
+		allocator.Free();
+		allocator.Free();
+
+		_frames = nullptr;
+		_frameCount = 0;
+	}
+
+	LinearAllocator& FrameAllocator::BeginFrame()
+	{
+		assert(_frames);
+		_current = _current + 1 == _frameCount ? 0 : _current + 1;
+		++_frameIndex;
+
+		LinearAllocator& frame = _frames[_current];
+		frame.Clear();
+		return frame;
+	}
+
+	LinearAllocator& FrameAllocator::GetCurrent()
+	{
+		assert(_frames);
+		return _frames[_current];
+	}
+
+	LinearAllocator& FrameAllocator::GetPrevious(const size_t framesAgo)
+	{
+		assert(framesAgo < _frameCount);
+		return _frames[(_current + _frameCount - framesAgo) % _frameCount];
+	}
+
+	void* FrameAllocator::Malloc(const size_t size)
+	{
+		return GetCurrent().Malloc(size);
+	}
+
+	uint64_t FrameAllocator::GetFrameIndex() const
+	{
+		return _frameIndex;
+	}
+
+	size_t FrameAllocator::GetFrameCount() const
+	{
+		return _frameCount;
+	}
+}
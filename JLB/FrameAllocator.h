@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include "LinearAllocator.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Rotates between multiple linear allocators, one for every frame that can be in flight at the same time.<br>
+	/// Memory allocated during a frame stays valid until the same region is reused, frame count frames later,
+	/// so per frame data can be handed to the GPU or network without copying it into a separately managed buffer.<br>
+	/// Starting a frame only resets the oldest region, which takes constant time.<br>
+	/// Does not have ownership over the memory that it uses.
+	/// </summary>
+	class FrameAllocator final
+	{
+	public:
+		FrameAllocator() = default;
+		FrameAllocator(FrameAllocator& other) = delete;
+		FrameAllocator(FrameAllocator&& other) = delete;
+		FrameAllocator& operator=(FrameAllocator& other) = delete;
+		FrameAllocator& operator=(FrameAllocator&& other) = delete;
+
+		/// <summary>
+		/// Allocates all the regions as a single block.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="frameCount">Amount of frames that can be in flight, like 2 for double and 3 for triple buffering.</param>
+		/// <param name="frameSize">Size of the region of every frame.</param>
+		void Allocate(LinearAllocator& allocator, size_t frameCount, size_t frameSize);
+		/// <summary>
+		/// Frees the regions from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Starts a new frame by clearing the region of the oldest frame.<br>
+		/// Everything that has been allocated frame count frames ago becomes invalid.
+		/// </summary>
+		/// <returns>Allocator of the new frame.</returns>
+		LinearAllocator& BeginFrame();
+		/// <summary>
+		/// Gets the allocator of the current frame. Containers can be allocated from it without ever being freed.
+		/// </summary>
+		[[nodiscard]] LinearAllocator& GetCurrent();
+		/// <summary>
+		/// Gets the allocator of an earlier frame that is still in flight.
+		/// </summary>
+		/// <param name="framesAgo">0 for the current frame, up to frame count - 1.</param>
+		[[nodiscard]] LinearAllocator& GetPrevious(size_t framesAgo);
+
+		/// <summary>
+		/// Allocates from the current frame.
+		/// </summary>
+		/// <param name="size">The size of the to be allocated memory.</param>
+		/// <returns>Pointer to the allocated memory, valid for frame count frames.</returns>
+		[[nodiscard]] void* Malloc(size_t size);
+		/// <summary>
+		/// Allocates one or multiple classes of type T from the current frame. Does not call constructors.
+		/// </summary>
+		template <typename T>
+		[[nodiscard]] T* New(size_t count = 1);
+
+		/// <summary>
+		/// Gets the amount of frames that have been started.
+		/// </summary>
+		[[nodiscard]] uint64_t GetFrameIndex() const;
+		/// <summary>
+		/// Gets the amount of frames that can be in flight.
+		/// </summary>
+		[[nodiscard]] size_t GetFrameCount() const;
+
+	private:
+		LinearAllocator* _frames = nullptr;
+		size_t _frameCount = 0;
+		size_t _current = 0;
+		uint64_t _frameIndex = 0;
+	};
+
+	template <typename T>
+	T* FrameAllocator::New(const size_t count)
+	{
+		return GetCurrent().New<T>(count);
+	}
+}
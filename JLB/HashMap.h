@@ -1,9 +1,12 @@
 ﻿#pragma once
 #include "Array.h"
 #include "KeyPair.h"
+#include "ContainerStats.h"
 
 namespace jlb
 {
+	class SnapshotReader;
+
 	/// <summary>
 	/// Data container that that prioritizes quick lookup speed.
 	/// </summary>
@@ -36,25 +39,65 @@ namespace jlb
 		/// <param name="value">Value to be removed.</param>
 		void Erase(T& value);
 
+		/// <summary>
+		/// Allocates the slots of the HashMap. Any values from an earlier allocation are forgotten.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="size">Amount of slots.</param>
+		/// <param name="fillValue">The slots will be initialized with this value.</param>
+		void Allocate(LinearAllocator& allocator, size_t size, const KeyPair<T>& fillValue = {}) override;
+		using Array<KeyPair<T>>::Allocate;
+
 		/// <summary>
 		/// Gets the amount of values in the HashMap.
 		/// </summary>
 		/// <returns>Amount of values in the HashMap.</returns>
 		[[nodiscard]] size_t GetCount() const;
 
+#ifdef JLB_CONTAINER_STATS
+		/// <summary>
+		/// Gets the probe lengths of every operation since the last reset.
+		/// </summary>
+		[[nodiscard]] const HashMapStats& GetStats() const;
+		/// <summary>
+		/// Resets the operation counters.
+		/// </summary>
+		void ResetStats();
+		/// <summary>
+		/// Scans the table to measure how well the hasher spreads the values.
+		/// </summary>
+		/// <returns>Load factor, clustering and the probe lengths of all the stored values.</returns>
+		[[nodiscard]] HashMapLayout GetLayout();
+#endif
+
 	protected:
 		[[nodiscard]] size_t GetHash(T& value);
 		[[nodiscard]] bool Contains(T& value, size_t& outIndex);
 		void _Insert(T& value);
+		// Inserts a value that is known to not be in the HashMap yet, skipping the lookup.
+		void _InsertNew(T& value);
 
 		KeyPair<T>& operator[](size_t index) override;
 		Iterator<KeyPair<T>> begin() override;
 		Iterator<KeyPair<T>> end() override;
 
 	private:
+		// Restores the count after reading the values straight into the memory.
+		friend class SnapshotReader;
+
 		size_t _count = 0;
+#ifdef JLB_CONTAINER_STATS
+		HashMapStats _stats{};
+#endif
 	};
 
+	template <typename T>
+	void HashMap<T>::Allocate(LinearAllocator& allocator, const size_t size, const KeyPair<T>& fillValue)
+	{
+		Array<KeyPair<T>>::Allocate(allocator, size, fillValue);
+		_count = 0;
+	}
+
 	template <typename T>
 	void HashMap<T>::Insert(T& value)
 	{
@@ -95,6 +138,9 @@ namespace jlb
 		// Move the key group one place backwards by swapping the first and last index.
 		Array<KeyPair<T>>::Swap(index, index + i - 1);
 		--_count;
+#ifdef JLB_CONTAINER_STATS
+		++_stats.erases;
+#endif
 	}
 
 	template <typename T>
@@ -110,6 +156,55 @@ namespace jlb
 		return _count;
 	}
 
+#ifdef JLB_CONTAINER_STATS
+	template <typename T>
+	const HashMapStats& HashMap<T>::GetStats() const
+	{
+		return _stats;
+	}
+
+	template <typename T>
+	void HashMap<T>::ResetStats()
+	{
+		_stats = {};
+	}
+
+	template <typename T>
+	HashMapLayout HashMap<T>::GetLayout()
+	{
+		const size_t length = Array<KeyPair<T>>::GetLength();
+		HashMapLayout layout{};
+		layout.count = _count;
+		layout.capacity = length;
+		layout.loadFactor = length > 0 ? static_cast<double>(_count) / static_cast<double>(length) : 0;
+		if (_count == 0)
+			return layout;
+
+		// Start right after an empty slot, so that no cluster wraps around the end of the table.
+		size_t start = 0;
+		while (start < length && Array<KeyPair<T>>::operator[](start).key != SIZE_MAX)
+			++start;
+
+		size_t cluster = 0;
+		for (size_t i = 1; i <= length; ++i)
+		{
+			const size_t index = (start + i) % length;
+			const size_t key = Array<KeyPair<T>>::operator[](index).key;
+			if (key == SIZE_MAX)
+			{
+				cluster = 0;
+				continue;
+			}
+
+			++cluster;
+			layout.longestCluster = cluster > layout.longestCluster ? cluster : layout.longestCluster;
+			// The key is the home slot of the value.
+			layout.probes.Record((index + length - key) % length + 1);
+		}
+		return layout;
+	}
+#endif
+
 	template <typename T>
 	size_t HashMap<T>::GetHash(T& value)
 	{
@@ -139,11 +234,17 @@ namespace jlb
 			// We have to compare the values due to the fact that one hash might be generated more than once.
 			if (keyPair.value == value)
 			{
+#ifdef JLB_CONTAINER_STATS
+				_stats.hits.Record(i + 1);
+#endif
 				outIndex = index;
 				return true;
 			}
 		}
 
+#ifdef JLB_CONTAINER_STATS
+		_stats.misses.Record(length);
+#endif
 		return false;
 	}
 
@@ -157,6 +258,15 @@ namespace jlb
 		if (Contains(value))
 			return;
 
+		_InsertNew(value);
+	}
+
+	template <typename T>
+	void HashMap<T>::_InsertNew(T& value)
+	{
+		const size_t length = Array<KeyPair<T>>::GetLength();
+		assert(_count < length);
+
 		const size_t hash = GetHash(value);
 
 		for (size_t i = 0; i < length; ++i)
@@ -170,6 +280,9 @@ namespace jlb
 			keyPair.key = hash;
 			keyPair.value = value;
 			++_count;
+#ifdef JLB_CONTAINER_STATS
+			_stats.inserts.Record(i + 1);
+#endif
 			break;
 		}
 	}
@@ -2,9 +2,12 @@
 #include <cassert>
 #include "Array.h"
 #include "KeyPair.h"
+#include "ContainerStats.h"
 
 namespace jlb
 {
+	class SnapshotReader;
+
 	/// <summary>
 	/// Binary tree that can be used to quickly sort data based on the key value.
 	/// </summary>
@@ -47,8 +50,25 @@ namespace jlb
 		/// <returns>Amount of values in the Heap.</returns>
 		[[nodiscard]] size_t GetCount() const;
 
+#ifdef JLB_CONTAINER_STATS
+		/// <summary>
+		/// Gets the swaps and sift depths of every operation since the last reset.
+		/// </summary>
+		[[nodiscard]] const HeapStats& GetStats() const;
+		/// <summary>
+		/// Resets the operation counters.
+		/// </summary>
+		void ResetStats();
+#endif
+
 	private:
+		// Restores the count after reading the values straight into the memory.
+		friend class SnapshotReader;
+
 		size_t _count = 0;
+#ifdef JLB_CONTAINER_STATS
+		HeapStats _stats{};
+#endif
 
 		void _Insert(T& value);
 		void HeapifyBottomToTop(uint32_t index);
@@ -64,6 +84,7 @@ namespace jlb
 	void Heap<T>::Allocate(LinearAllocator& allocator, const size_t size, const KeyPair<T>& fillValue)
 	{
 		Array<KeyPair<T>>::Allocate(allocator, size + 1, fillValue);
+		_count = 0;
 	}
 
 	template <typename T>
@@ -88,7 +109,13 @@ namespace jlb
 		auto& keyPair = data[_count];
 		keyPair.key = hasher(value);
 		keyPair.value = value;
+#ifdef JLB_CONTAINER_STATS
+		const size_t swaps = _stats.swaps;
+#endif
 		HeapifyBottomToTop(_count);
+#ifdef JLB_CONTAINER_STATS
+		_stats.siftUps.Record(_stats.swaps - swaps);
+#endif
 	}
 
 	template <typename T>
@@ -109,7 +136,13 @@ namespace jlb
 		const T value = data[1].value;
 		data[1] = data[_count--];
 
+#ifdef JLB_CONTAINER_STATS
+		const size_t swaps = _stats.swaps;
+#endif
 		HeapifyTopToBottom(1);
+#ifdef JLB_CONTAINER_STATS
+		_stats.siftDowns.Record(_stats.swaps - swaps);
+#endif
 		return value;
 	}
 
@@ -125,6 +158,20 @@ namespace jlb
 		return _count;
 	}
 
+#ifdef JLB_CONTAINER_STATS
+	template <typename T>
+	const HeapStats& Heap<T>::GetStats() const
+	{
+		return _stats;
+	}
+
+	template <typename T>
+	void Heap<T>::ResetStats()
+	{
+		_stats = {};
+	}
+#endif
+
 	template <typename T>
 	void Heap<T>::HeapifyBottomToTop(const uint32_t index)
 	{
@@ -176,6 +223,9 @@ namespace jlb
 		KeyPair<T> temp = data[a];
 		data[a] = data[b];
 		data[b] = temp;
+#ifdef JLB_CONTAINER_STATS
+		++_stats.swaps;
+#endif
 	}
 
 	template <typename T>
@@ -0,0 +1,24 @@
+#pragma once
+#include "Stack.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Stack that stores up to N values inside of the object itself, so it does not need an allocator.
+	/// </summary>
+	template <typename T, size_t N>
+	class InlineStack final : public Stack<T>
+	{
+	public:
+		InlineStack();
+
+	private:
+		T _buffer[N]{};
+	};
+
+	template <typename T, size_t N>
+	InlineStack<T, N>::InlineStack()
+	{
+		Array<T>::SetMemory(_buffer, N);
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Vector.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Vector that stores up to N values inside of the object itself, so it does not need an allocator.<br>
+	/// Optionally spills over into a linear allocator once the inline capacity is exceeded.
+	/// </summary>
+	template <typename T, size_t N>
+	class InlineVector final : public Vector<T>
+	{
+	public:
+		InlineVector();
+		/// <param name="spillAllocator">Allocator to move to once the inline capacity is exceeded.</param>
+		explicit InlineVector(LinearAllocator& spillAllocator);
+
+		/// <summary>
+		/// Frees the memory that has been spilled into the allocator, if any, and moves back to the inline memory.<br>
+		/// Clears the vector.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator) override;
+
+		/// <summary>
+		/// Checks if the vector has moved from the inline memory to the allocator.
+		/// </summary>
+		/// <returns>If the vector has moved to the allocator.</returns>
+		[[nodiscard]] bool IsSpilled();
+
+	private:
+		T _buffer[N]{};
+	};
+
+	template <typename T, size_t N>
+	InlineVector<T, N>::InlineVector()
+	{
+		Array<T>::SetMemory(_buffer, N);
+	}
+
+	template <typename T, size_t N>
+	InlineVector<T, N>::InlineVector(LinearAllocator& spillAllocator) : InlineVector()
+	{
+		Vector<T>::SetSpillAllocator(spillAllocator);
+	}
+
+	template <typename T, size_t N>
+	void InlineVector<T, N>::Free(LinearAllocator& allocator)
+	{
+		if (IsSpilled())
+		{
+			allocator.Release(Array<T>::GetData(), Array<T>::GetLength() * sizeof(T));
+			Array<T>::SetMemory(_buffer, N);
+			Vector<T>::SetSpillAllocator(allocator);
+		}
+		Vector<T>::Clear();
+	}
+
+	template <typename T, size_t N>
+	bool InlineVector<T, N>::IsSpilled()
+	{
+		return Array<T>::GetData() != _buffer;
+	}
+}
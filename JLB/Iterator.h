@@ -1,67 +1,161 @@
 ﻿#pragma once
-#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
 
 namespace jlb
 {
 	/// <summary>
-	/// Standard iterator for data containers like vectors/arrays.
+	/// Standard iterator for data containers like vectors/arrays.<br>
+	/// Only holds a pointer to the current value, and satisfies the random access (and from C++20, contiguous) iterator requirements, 
+	/// so it can be used with standard library algorithms and compiles down to a raw pointer loop.
 	/// </summary>
 	template <typename T>
 	class Iterator final
 	{
 	public:
-		// Start of iteration.
-		T* memory = nullptr;
-		// Length of iteration.
-		size_t length = 0;
-		// Current index of iteration (relative to begin).
-		size_t index = 0;
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+		using iterator_concept = std::contiguous_iterator_tag;
+#endif
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::remove_cv_t<T>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T*;
+		using reference = T&;
+
+		// Current value of iteration.
+		T* ptr = nullptr;
+
+		Iterator() = default;
+		explicit Iterator(T* ptr);
 
 		T& operator*() const;
-		T& operator->() const;
+		T* operator->() const;
+		T& operator[](difference_type offset) const;
 
-		const Iterator& operator++();
+		Iterator& operator++();
 		Iterator operator++(int);
+		Iterator& operator--();
+		Iterator operator--(int);
+		Iterator& operator+=(difference_type offset);
+		Iterator& operator-=(difference_type offset);
+
+		friend Iterator operator+(const Iterator& it, const difference_type offset)
+		{
+			return Iterator(it.ptr + offset);
+		}
+
+		friend Iterator operator+(const difference_type offset, const Iterator& it)
+		{
+			return Iterator(it.ptr + offset);
+		}
+
+		friend Iterator operator-(const Iterator& it, const difference_type offset)
+		{
+			return Iterator(it.ptr - offset);
+		}
+
+		friend difference_type operator-(const Iterator& a, const Iterator& b)
+		{
+			return a.ptr - b.ptr;
+		}
 
 		friend bool operator==(const Iterator& a, const Iterator& b)
 		{
-			return a.index == b.index;
-		};
+			return a.ptr == b.ptr;
+		}
+
+		friend bool operator!=(const Iterator& a, const Iterator& b)
+		{
+			return a.ptr != b.ptr;
+		}
+
+		friend bool operator<(const Iterator& a, const Iterator& b)
+		{
+			return a.ptr < b.ptr;
+		}
 
-		friend bool operator!= (const Iterator& a, const Iterator& b)
+		friend bool operator>(const Iterator& a, const Iterator& b)
 		{
-			return !(a == b);
+			return a.ptr > b.ptr;
+		}
+
+		friend bool operator<=(const Iterator& a, const Iterator& b)
+		{
+			return a.ptr <= b.ptr;
+		}
+
+		friend bool operator>=(const Iterator& a, const Iterator& b)
+		{
+			return a.ptr >= b.ptr;
 		}
 	};
 
+	template <typename T>
+	Iterator<T>::Iterator(T* ptr) : ptr(ptr)
+	{
+
+	}
+
 	template <typename T>
 	T& Iterator<T>::operator*() const
 	{
-		assert(memory);
-		assert(index <= length);
-		return memory[index];
+		return *ptr;
+	}
+
+	template <typename T>
+	T* Iterator<T>::operator->() const
+	{
+		return ptr;
 	}
 
 	template <typename T>
-	T& Iterator<T>::operator->() const
+	T& Iterator<T>::operator[](const difference_type offset) const
 	{
-		assert(memory);
-		assert(index <= length);
-		return memory[index];
+		return ptr[offset];
 	}
 
 	template <typename T>
-	const Iterator<T>& Iterator<T>::operator++()
+	Iterator<T>& Iterator<T>::operator++()
 	{
-		++index;
+		++ptr;
 		return *this;
 	}
 
 	template <typename T>
 	Iterator<T> Iterator<T>::operator++(int)
 	{
-		Iterator temp(memory, length, index);
-		++index;
+		Iterator temp = *this;
+		++ptr;
+		return temp;
+	}
+
+	template <typename T>
+	Iterator<T>& Iterator<T>::operator--()
+	{
+		--ptr;
+		return *this;
+	}
+
+	template <typename T>
+	Iterator<T> Iterator<T>::operator--(int)
+	{
+		Iterator temp = *this;
+		--ptr;
 		return temp;
 	}
+
+	template <typename T>
+	Iterator<T>& Iterator<T>::operator+=(const difference_type offset)
+	{
+		ptr += offset;
+		return *this;
+	}
+
+	template <typename T>
+	Iterator<T>& Iterator<T>::operator-=(const difference_type offset)
+	{
+		ptr -= offset;
+		return *this;
+	}
 }
\ No newline at end of file
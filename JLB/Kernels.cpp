@@ -0,0 +1,837 @@
+#include "Kernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define JLB_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC allows intrinsics for any instruction set without changing the compiler flags.
+#define JLB_TARGET(instructionSet)
+#else
+// Other compilers need to be told which functions are allowed to use the instruction set.
+#define JLB_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#endif
+#endif
+
+namespace jlb
+{
+	namespace kernelsImpl
+	{
+		namespace
+		{
+			// Scalar implementations, used for the remaining values and on CPUs without vector support.
+
+			template <typename T>
+			[[nodiscard]] size_t FindScalar(const T* src, const size_t count, const T value, size_t i = 0)
+			{
+				for (; i < count; ++i)
+					if (src[i] == value)
+						return i;
+				return SIZE_MAX;
+			}
+
+			template <typename T>
+			[[nodiscard]] size_t CountScalar(const T* src, const size_t count, const T value, size_t i = 0)
+			{
+				size_t n = 0;
+				for (; i < count; ++i)
+					n += src[i] == value;
+				return n;
+			}
+
+			template <typename T>
+			void MinMaxScalar(const T* src, const size_t count, T& outMin, T& outMax, size_t i = 0)
+			{
+				for (; i < count; ++i)
+				{
+					outMin = src[i] < outMin ? src[i] : outMin;
+					outMax = outMax < src[i] ? src[i] : outMax;
+				}
+			}
+
+			template <typename T, typename Sum>
+			[[nodiscard]] Sum SumScalar(const T* src, const size_t count, Sum sum = {}, size_t i = 0)
+			{
+				for (; i < count; ++i)
+					sum += src[i];
+				return sum;
+			}
+
+			template <typename T>
+			void MinMaxScalarEntry(const T* src, const size_t count, T& outMin, T& outMax)
+			{
+				outMin = src[0];
+				outMax = src[0];
+				MinMaxScalar(src, count, outMin, outMax, 1);
+			}
+
+			[[nodiscard]] uint64_t PopCountScalar(uint64_t word)
+			{
+				// Counts the bits in parallel within the word.
+				word -= (word >> 1) & 0x5555555555555555ull;
+				word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+				word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+				return (word * 0x0101010101010101ull) >> 56;
+			}
+
+			[[nodiscard]] size_t PopCountScalar(const uint64_t* src, const size_t count, size_t i = 0)
+			{
+				size_t n = 0;
+				for (; i < count; ++i)
+					n += PopCountScalar(src[i]);
+				return n;
+			}
+
+			// Byte kernels, used for string processing.
+
+			[[nodiscard]] size_t FindByteScalar(const char* src, const size_t count, const char value, const size_t i = 0)
+			{
+				// The C library already does this many bytes at a time.
+				if (i >= count)
+					return SIZE_MAX;
+				const void* found = memchr(src + i, value, count - i);
+				return found ? static_cast<size_t>(static_cast<const char*>(found) - src) : SIZE_MAX;
+			}
+
+			[[nodiscard]] size_t FindAnyByteScalar(const char* src, const size_t count, const char* set, const size_t setCount, size_t i = 0)
+			{
+				bool table[256]{};
+				for (size_t j = 0; j < setCount; ++j)
+					table[static_cast<unsigned char>(set[j])] = true;
+				for (; i < count; ++i)
+					if (table[static_cast<unsigned char>(src[i])])
+						return i;
+				return SIZE_MAX;
+			}
+
+			[[nodiscard]] size_t FindBytesScalar(const char* src, const size_t count, const char* pattern, const size_t patternCount, size_t i = 0)
+			{
+				if (patternCount == 0)
+					return i <= count ? i : SIZE_MAX;
+				if (patternCount > count)
+					return SIZE_MAX;
+
+				// Jump between occurrences of the first character, then compare the rest.
+				const size_t last = count - patternCount;
+				while (i <= last)
+				{
+					const size_t found = FindByteScalar(src, last + 1, pattern[0], i);
+					if (found == SIZE_MAX)
+						return SIZE_MAX;
+					if (memcmp(src + found + 1, pattern + 1, patternCount - 1) == 0)
+						return found;
+					i = found + 1;
+				}
+				return SIZE_MAX;
+			}
+
+			[[nodiscard]] size_t MismatchScalar(const char* a, const char* b, const size_t count, size_t i = 0)
+			{
+				for (; i < count; ++i)
+					if (a[i] != b[i])
+						return i;
+				return SIZE_MAX;
+			}
+
+			[[nodiscard]] bool BloomBlockContainsScalar(const uint32_t* block, const uint32_t hash)
+			{
+				uint32_t missing = 0;
+				for (size_t i = 0; i < BLOOM_BLOCK_WORDS; ++i)
+				{
+					const uint32_t bit = uint32_t(1) << (hash * BLOOM_SALTS[i] >> 27);
+					missing |= ~block[i] & bit;
+				}
+				return missing == 0;
+			}
+
+#ifdef JLB_X86
+			[[nodiscard]] uint32_t CountTrailingZeros(const uint32_t mask)
+			{
+#if defined(_MSC_VER) && !defined(__clang__)
+				unsigned long index;
+				_BitScanForward(&index, mask);
+				return index;
+#else
+				return __builtin_ctz(mask);
+#endif
+			}
+
+			[[nodiscard]] uint32_t PopCount(uint32_t mask)
+			{
+				// Only used on small lane masks, so no need for the popcnt instruction.
+				uint32_t count = 0;
+				while (mask)
+				{
+					mask &= mask - 1;
+					++count;
+				}
+				return count;
+			}
+
+			// SSE4.1 implementations, 4 values per step.
+
+			JLB_TARGET("sse4.1") size_t FindSse41(const int32_t* src, const size_t count, const int32_t value)
+			{
+				const __m128i target = _mm_set1_epi32(value);
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+					const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, target)));
+					if (mask)
+						return i + CountTrailingZeros(mask);
+				}
+				return FindScalar(src, count, value, i);
+			}
+
+			JLB_TARGET("sse4.1") size_t FindSse41(const float* src, const size_t count, const float value)
+			{
+				const __m128 target = _mm_set1_ps(value);
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(&src[i]), target));
+					if (mask)
+						return i + CountTrailingZeros(mask);
+				}
+				return FindScalar(src, count, value, i);
+			}
+
+			JLB_TARGET("sse4.1") size_t CountSse41(const int32_t* src, const size_t count, const int32_t value)
+			{
+				const __m128i target = _mm_set1_epi32(value);
+				size_t n = 0;
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+					n += PopCount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, target))));
+				}
+				return n + CountScalar(src, count, value, i);
+			}
+
+			JLB_TARGET("sse4.1") size_t CountSse41(const float* src, const size_t count, const float value)
+			{
+				const __m128 target = _mm_set1_ps(value);
+				size_t n = 0;
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+					n += PopCount(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(&src[i]), target)));
+				return n + CountScalar(src, count, value, i);
+			}
+
+			JLB_TARGET("sse4.1") void MinMaxSse41(const int32_t* src, const size_t count, int32_t& outMin, int32_t& outMax)
+			{
+				outMin = src[0];
+				outMax = src[0];
+				if (count < 4)
+				{
+					MinMaxScalar(src, count, outMin, outMax, 1);
+					return;
+				}
+
+				__m128i min = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+				__m128i max = min;
+				size_t i = 4;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+					min = _mm_min_epi32(min, values);
+					max = _mm_max_epi32(max, values);
+				}
+
+				alignas(16) int32_t mins[4];
+				alignas(16) int32_t maxs[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(mins), min);
+				_mm_store_si128(reinterpret_cast<__m128i*>(maxs), max);
+				MinMaxScalar(mins, 4, outMin, outMax);
+				MinMaxScalar(maxs, 4, outMin, outMax);
+				MinMaxScalar(src, count, outMin, outMax, i);
+			}
+
+			JLB_TARGET("sse4.1") void MinMaxSse41(const float* src, const size_t count, float& outMin, float& outMax)
+			{
+				outMin = src[0];
+				outMax = src[0];
+				if (count < 4)
+				{
+					MinMaxScalar(src, count, outMin, outMax, 1);
+					return;
+				}
+
+				__m128 min = _mm_loadu_ps(src);
+				__m128 max = min;
+				size_t i = 4;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128 values = _mm_loadu_ps(&src[i]);
+					min = _mm_min_ps(min, values);
+					max = _mm_max_ps(max, values);
+				}
+
+				alignas(16) float mins[4];
+				alignas(16) float maxs[4];
+				_mm_store_ps(mins, min);
+				_mm_store_ps(maxs, max);
+				MinMaxScalar(mins, 4, outMin, outMax);
+				MinMaxScalar(maxs, 4, outMin, outMax);
+				MinMaxScalar(src, count, outMin, outMax, i);
+			}
+
+			JLB_TARGET("sse4.1") int64_t SumSse41(const int32_t* src, const size_t count)
+			{
+				// Widen to 64 bit lanes to prevent overflow.
+				__m128i sum = _mm_setzero_si128();
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+					sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(values));
+					sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(_mm_srli_si128(values, 8)));
+				}
+
+				alignas(16) int64_t sums[2];
+				_mm_store_si128(reinterpret_cast<__m128i*>(sums), sum);
+				return SumScalar(src, count, sums[0] + sums[1], i);
+			}
+
+			JLB_TARGET("sse4.1") float SumSse41(const float* src, const size_t count)
+			{
+				__m128 sum = _mm_setzero_ps();
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+					sum = _mm_add_ps(sum, _mm_loadu_ps(&src[i]));
+
+				alignas(16) float sums[4];
+				_mm_store_ps(sums, sum);
+				return SumScalar(src, count, sums[0] + sums[1] + sums[2] + sums[3], i);
+			}
+
+			// SSE byte implementations, 16 bytes per step.
+
+			JLB_TARGET("sse4.1") size_t FindByteSse41(const char* src, const size_t count, const char value)
+			{
+				const __m128i target = _mm_set1_epi8(value);
+				size_t i = 0;
+				for (; i + 16 <= count; i += 16)
+				{
+					const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+					const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(values, target));
+					if (mask)
+						return i + CountTrailingZeros(mask);
+				}
+				return FindByteScalar(src, count, value, i);
+			}
+
+			JLB_TARGET("sse4.1") size_t FindAnyByteSse41(const char* src, const size_t count, const char* set, const size_t setCount)
+			{
+				// Large sets are faster with a lookup table.
+				if (setCount > 8)
+					return FindAnyByteScalar(src, count, set, setCount);
+
+				__m128i targets[8];
+				for (size_t j = 0; j < setCount; ++j)
+					targets[j] = _mm_set1_epi8(set[j]);
+
+				size_t i = 0;
+				for (; i + 16 <= count; i += 16)
+				{
+					const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+					__m128i matches = _mm_setzero_si128();
+					for (size_t j = 0; j < setCount; ++j)
+						matches = _mm_or_si128(matches, _mm_cmpeq_epi8(values, targets[j]));
+					const int mask = _mm_movemask_epi8(matches);
+					if (mask)
+						return i + CountTrailingZeros(mask);
+				}
+				return FindAnyByteScalar(src, count, set, setCount, i);
+			}
+
+			JLB_TARGET("sse4.1") size_t FindBytesSse41(const char* src, const size_t count, const char* pattern, const size_t patternCount)
+			{
+				if (patternCount < 2 || patternCount > count)
+					return FindBytesScalar(src, count, pattern, patternCount);
+
+				// Only positions where both the first and the last character match are compared in full.
+				const __m128i first = _mm_set1_epi8(pattern[0]);
+				const __m128i last = _mm_set1_epi8(pattern[patternCount - 1]);
+				const size_t end = count - patternCount + 1;
+				size_t i = 0;
+				for (; i + 16 <= end; i += 16)
+				{
+					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i + patternCount - 1]));
+					uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+					while (mask)
+					{
+						const size_t index = i + CountTrailingZeros(mask);
+						if (memcmp(src + index + 1, pattern + 1, patternCount - 2) == 0)
+							return index;
+						mask &= mask - 1;
+					}
+				}
+				return FindBytesScalar(src, count, pattern, patternCount, i);
+			}
+
+			JLB_TARGET("sse4.1") size_t MismatchSse41(const char* a, const char* b, const size_t count)
+			{
+				size_t i = 0;
+				for (; i + 16 <= count; i += 16)
+				{
+					const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a[i]));
+					const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b[i]));
+					const uint32_t mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & 0xFFFF;
+					if (mask)
+						return i + CountTrailingZeros(mask);
+				}
+				return MismatchScalar(a, b, count, i);
+			}
+
+			JLB_TARGET("sse4.1") size_t PopCountSse41(const uint64_t* src, const size_t count)
+			{
+				// Look up the bit count of every nibble, then sum the bytes per 64 bit lane.
+				const __m128i lookup = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+				const __m128i nibble = _mm_set1_epi8(0x0F);
+				__m128i sum = _mm_setzero_si128();
+				size_t i = 0;
+				for (; i + 2 <= count; i += 2)
+				{
+					const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+					const __m128i low = _mm_shuffle_epi8(lookup, _mm_and_si128(values, nibble));
+					const __m128i high = _mm_shuffle_epi8(lookup, _mm_and_si128(_mm_srli_epi16(values, 4), nibble));
+					sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_add_epi8(low, high), _mm_setzero_si128()));
+				}
+
+				alignas(16) uint64_t sums[2];
+				_mm_store_si128(reinterpret_cast<__m128i*>(sums), sum);
+				return static_cast<size_t>(sums[0] + sums[1]) + PopCountScalar(src, count, i);
+			}
+
+			JLB_TARGET("sse4.1") bool BloomBlockContainsSse41(const uint32_t* block, const uint32_t hash)
+			{
+				// SSE has no variable shifts, so build 1 << n by putting n in the exponent of a float and converting it back.
+				// 2^31 does not fit in an int32, but converts to 0x80000000, which is the same bit.
+				const __m128i value = _mm_set1_epi32(static_cast<int32_t>(hash));
+				const __m128i bias = _mm_set1_epi32(127);
+				const __m128i* salts = reinterpret_cast<const __m128i*>(BLOOM_SALTS);
+				const __m128i* words = reinterpret_cast<const __m128i*>(block);
+				const __m128i lowShift = _mm_srli_epi32(_mm_mullo_epi32(value, _mm_loadu_si128(salts)), 27);
+				const __m128i highShift = _mm_srli_epi32(_mm_mullo_epi32(value, _mm_loadu_si128(salts + 1)), 27);
+				const __m128i low = _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(lowShift, bias), 23)));
+				const __m128i high = _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(highShift, bias), 23)));
+				return _mm_testc_si128(_mm_loadu_si128(words), low) & _mm_testc_si128(_mm_loadu_si128(words + 1), high);
+			}
+
+			// AVX2 implementations, 8 values per step.
+
+			JLB_TARGET("avx2") size_t FindAvx2(const int32_t* src, const size_t count, const int32_t value)
+			{
+				const __m256i target = _mm256_set1_epi32(value);
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+					const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(values, target)));
+					if (mask)
+						return i + CountTrailingZeros(mask);
+				}
+				return FindScalar(src, count, value, i);
+			}
+
+			JLB_TARGET("avx2") size_t FindAvx2(const float* src, const size_t count, const float value)
+			{
+				const __m256 target = _mm256_set1_ps(value);
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(&src[i]), target, _CMP_EQ_OQ));
+					if (mask)
+						return i + CountTrailingZeros(mask);
+				}
+				return FindScalar(src, count, value, i);
+			}
+
+			JLB_TARGET("avx2") size_t CountAvx2(const int32_t* src, const size_t count, const int32_t value)
+			{
+				const __m256i target = _mm256_set1_epi32(value);
+				size_t n = 0;
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+					n += PopCount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(values, target))));
+				}
+				return n + CountScalar(src, count, value, i);
+			}
+
+			JLB_TARGET("avx2") size_t CountAvx2(const float* src, const size_t count, const float value)
+			{
+				const __m256 target = _mm256_set1_ps(value);
+				size_t n = 0;
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+					n += PopCount(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(&src[i]), target, _CMP_EQ_OQ)));
+				return n + CountScalar(src, count, value, i);
+			}
+
+			JLB_TARGET("avx2") void MinMaxAvx2(const int32_t* src, const size_t count, int32_t& outMin, int32_t& outMax)
+			{
+				outMin = src[0];
+				outMax = src[0];
+				if (count < 8)
+				{
+					MinMaxScalar(src, count, outMin, outMax, 1);
+					return;
+				}
+
+				__m256i min = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+				__m256i max = min;
+				size_t i = 8;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+					min = _mm256_min_epi32(min, values);
+					max = _mm256_max_epi32(max, values);
+				}
+
+				alignas(32) int32_t mins[8];
+				alignas(32) int32_t maxs[8];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(mins), min);
+				_mm256_store_si256(reinterpret_cast<__m256i*>(maxs), max);
+				MinMaxScalar(mins, 8, outMin, outMax);
+				MinMaxScalar(maxs, 8, outMin, outMax);
+				MinMaxScalar(src, count, outMin, outMax, i);
+			}
+
+			JLB_TARGET("avx2") void MinMaxAvx2(const float* src, const size_t count, float& outMin, float& outMax)
+			{
+				outMin = src[0];
+				outMax = src[0];
+				if (count < 8)
+				{
+					MinMaxScalar(src, count, outMin, outMax, 1);
+					return;
+				}
+
+				__m256 min = _mm256_loadu_ps(src);
+				__m256 max = min;
+				size_t i = 8;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256 values = _mm256_loadu_ps(&src[i]);
+					min = _mm256_min_ps(min, values);
+					max = _mm256_max_ps(max, values);
+				}
+
+				alignas(32) float mins[8];
+				alignas(32) float maxs[8];
+				_mm256_store_ps(mins, min);
+				_mm256_store_ps(maxs, max);
+				MinMaxScalar(mins, 8, outMin, outMax);
+				MinMaxScalar(maxs, 8, outMin, outMax);
+				MinMaxScalar(src, count, outMin, outMax, i);
+			}
+
+			JLB_TARGET("avx2") int64_t SumAvx2(const int32_t* src, const size_t count)
+			{
+				// Widen to 64 bit lanes to prevent overflow.
+				__m256i sum = _mm256_setzero_si256();
+				size_t i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+					sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(values)));
+					sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(values, 1)));
+				}
+
+				alignas(32) int64_t sums[4];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(sums), sum);
+				return SumScalar(src, count, sums[0] + sums[1] + sums[2] + sums[3], i);
+			}
+
+			JLB_TARGET("avx2") float SumAvx2(const float* src, const size_t count)
+			{
+				// Two accumulators to hide the latency of the additions.
+				__m256 sumA = _mm256_setzero_ps();
+				__m256 sumB = _mm256_setzero_ps();
+				size_t i = 0;
+				for (; i + 16 <= count; i += 16)
+				{
+					sumA = _mm256_add_ps(sumA, _mm256_loadu_ps(&src[i]));
+					sumB = _mm256_add_ps(sumB, _mm256_loadu_ps(&src[i + 8]));
+				}
+
+				alignas(32) float sums[8];
+				_mm256_store_ps(sums, _mm256_add_ps(sumA, sumB));
+				float sum = 0;
+				for (const float f : sums)
+					sum += f;
+				return SumScalar(src, count, sum, i);
+			}
+
+			JLB_TARGET("avx2") size_t PopCountAvx2(const uint64_t* src, const size_t count)
+			{
+				// Look up the bit count of every nibble, then sum the bytes per 64 bit lane.
+				const __m256i lookup = _mm256_setr_epi8(
+					0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+					0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+				const __m256i nibble = _mm256_set1_epi8(0x0F);
+				__m256i sum = _mm256_setzero_si256();
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+					const __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(values, nibble));
+					const __m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(values, 4), nibble));
+					sum = _mm256_add_epi64(sum, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+				}
+
+				alignas(32) uint64_t sums[4];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(sums), sum);
+				return static_cast<size_t>(sums[0] + sums[1] + sums[2] + sums[3]) + PopCountScalar(src, count, i);
+			}
+
+			// AVX2 byte implementations, 32 bytes per step.
+
+			JLB_TARGET("avx2") size_t FindByteAvx2(const char* src, const size_t count, const char value)
+			{
+				const __m256i target = _mm256_set1_epi8(value);
+				size_t i = 0;
+				for (; i + 32 <= count; i += 32)
+				{
+					const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+					const uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(values, target));
+					if (mask)
+						return i + CountTrailingZeros(mask);
+				}
+				return FindByteScalar(src, count, value, i);
+			}
+
+			JLB_TARGET("avx2") size_t FindAnyByteAvx2(const char* src, const size_t count, const char* set, const size_t setCount)
+			{
+				// Large sets are faster with a lookup table.
+				if (setCount > 8)
+					return FindAnyByteScalar(src, count, set, setCount);
+
+				__m256i targets[8];
+				for (size_t j = 0; j < setCount; ++j)
+					targets[j] = _mm256_set1_epi8(set[j]);
+
+				size_t i = 0;
+				for (; i + 32 <= count; i += 32)
+				{
+					const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+					__m256i matches = _mm256_setzero_si256();
+					for (size_t j = 0; j < setCount; ++j)
+						matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(values, targets[j]));
+					const uint32_t mask = _mm256_movemask_epi8(matches);
+					if (mask)
+						return i + CountTrailingZeros(mask);
+				}
+				return FindAnyByteScalar(src, count, set, setCount, i);
+			}
+
+			JLB_TARGET("avx2") size_t FindBytesAvx2(const char* src, const size_t count, const char* pattern, const size_t patternCount)
+			{
+				if (patternCount < 2 || patternCount > count)
+					return FindBytesScalar(src, count, pattern, patternCount);
+
+				// Only positions where both the first and the last character match are compared in full.
+				const __m256i first = _mm256_set1_epi8(pattern[0]);
+				const __m256i last = _mm256_set1_epi8(pattern[patternCount - 1]);
+				const size_t end = count - patternCount + 1;
+				size_t i = 0;
+				for (; i + 32 <= end; i += 32)
+				{
+					const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+					const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i + patternCount - 1]));
+					uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+					while (mask)
+					{
+						const size_t index = i + CountTrailingZeros(mask);
+						if (memcmp(src + index + 1, pattern + 1, patternCount - 2) == 0)
+							return index;
+						mask &= mask - 1;
+					}
+				}
+				return FindBytesScalar(src, count, pattern, patternCount, i);
+			}
+
+			JLB_TARGET("avx2") size_t MismatchAvx2(const char* a, const char* b, const size_t count)
+			{
+				size_t i = 0;
+				for (; i + 32 <= count; i += 32)
+				{
+					const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a[i]));
+					const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b[i]));
+					const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+					if (mask)
+						return i + CountTrailingZeros(mask);
+				}
+				return MismatchScalar(a, b, count, i);
+			}
+
+			JLB_TARGET("avx2") bool BloomBlockContainsAvx2(const uint32_t* block, const uint32_t hash)
+			{
+				const __m256i salts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(BLOOM_SALTS));
+				const __m256i shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int32_t>(hash)), salts), 27);
+				const __m256i bits = _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+				// Sets the carry flag if every bit of the mask is also set in the block.
+				return _mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), bits);
+			}
+
+			[[nodiscard]] bool HasAvx2()
+			{
+#if defined(_MSC_VER) && !defined(__clang__)
+				int info[4];
+				__cpuid(info, 0);
+				if (info[0] < 7)
+					return false;
+
+				// The OS has to save the AVX registers on context switches.
+				__cpuid(info, 1);
+				const bool osxsave = info[2] & (1 << 27);
+				if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+					return false;
+
+				__cpuidex(info, 7, 0);
+				return info[1] & (1 << 5);
+#else
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("avx2");
+#endif
+			}
+
+			[[nodiscard]] bool HasSse41()
+			{
+#if defined(_MSC_VER) && !defined(__clang__)
+				int info[4];
+				__cpuid(info, 1);
+				return info[2] & (1 << 19);
+#else
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("sse4.1");
+#endif
+			}
+#endif
+		}
+
+		// Picks the fastest implementation the CPU supports.
+#ifdef JLB_X86
+#define JLB_DISPATCH(Function, avx2, sse41, scalar) \
+		(HasAvx2() ? static_cast<Function>(avx2) : HasSse41() ? static_cast<Function>(sse41) : static_cast<Function>(scalar))
+#else
+#define JLB_DISPATCH(Function, avx2, sse41, scalar) static_cast<Function>(scalar)
+#endif
+
+		size_t Find(const int32_t* src, const size_t count, const int32_t value)
+		{
+			using Function = size_t(*)(const int32_t*, size_t, int32_t);
+			static const Function function = JLB_DISPATCH(Function, FindAvx2, FindSse41, 
+				[](const int32_t* src, const size_t count, const int32_t value) { return FindScalar(src, count, value); });
+			return function(src, count, value);
+		}
+
+		size_t Find(const float* src, const size_t count, const float value)
+		{
+			using Function = size_t(*)(const float*, size_t, float);
+			static const Function function = JLB_DISPATCH(Function, FindAvx2, FindSse41,
+				[](const float* src, const size_t count, const float value) { return FindScalar(src, count, value); });
+			return function(src, count, value);
+		}
+
+		size_t Count(const int32_t* src, const size_t count, const int32_t value)
+		{
+			using Function = size_t(*)(const int32_t*, size_t, int32_t);
+			static const Function function = JLB_DISPATCH(Function, CountAvx2, CountSse41,
+				[](const int32_t* src, const size_t count, const int32_t value) { return CountScalar(src, count, value); });
+			return function(src, count, value);
+		}
+
+		size_t Count(const float* src, const size_t count, const float value)
+		{
+			using Function = size_t(*)(const float*, size_t, float);
+			static const Function function = JLB_DISPATCH(Function, CountAvx2, CountSse41,
+				[](const float* src, const size_t count, const float value) { return CountScalar(src, count, value); });
+			return function(src, count, value);
+		}
+
+		void MinMax(const int32_t* src, const size_t count, int32_t& outMin, int32_t& outMax)
+		{
+			using Function = void(*)(const int32_t*, size_t, int32_t&, int32_t&);
+			static const Function function = JLB_DISPATCH(Function, MinMaxAvx2, MinMaxSse41, MinMaxScalarEntry<int32_t>);
+			function(src, count, outMin, outMax);
+		}
+
+		void MinMax(const float* src, const size_t count, float& outMin, float& outMax)
+		{
+			using Function = void(*)(const float*, size_t, float&, float&);
+			static const Function function = JLB_DISPATCH(Function, MinMaxAvx2, MinMaxSse41, MinMaxScalarEntry<float>);
+			function(src, count, outMin, outMax);
+		}
+
+		int64_t Sum(const int32_t* src, const size_t count)
+		{
+			using Function = int64_t(*)(const int32_t*, size_t);
+			static const Function function = JLB_DISPATCH(Function, SumAvx2, SumSse41,
+				([](const int32_t* src, const size_t count) { return SumScalar<int32_t, int64_t>(src, count); }));
+			return function(src, count);
+		}
+
+		float Sum(const float* src, const size_t count)
+		{
+			using Function = float(*)(const float*, size_t);
+			static const Function function = JLB_DISPATCH(Function, SumAvx2, SumSse41,
+				([](const float* src, const size_t count) { return SumScalar<float, float>(src, count); }));
+			return function(src, count);
+		}
+
+		size_t PopCount(const uint64_t* src, const size_t count)
+		{
+			using Function = size_t(*)(const uint64_t*, size_t);
+			static const Function function = JLB_DISPATCH(Function, PopCountAvx2, PopCountSse41,
+				[](const uint64_t* src, const size_t count) { return PopCountScalar(src, count); });
+			return function(src, count);
+		}
+
+		size_t FindByte(const char* src, const size_t count, const char value)
+		{
+			using Function = size_t(*)(const char*, size_t, char);
+			static const Function function = JLB_DISPATCH(Function, FindByteAvx2, FindByteSse41,
+				[](const char* src, const size_t count, const char value) { return FindByteScalar(src, count, value); });
+			return function(src, count, value);
+		}
+
+		size_t FindAnyByte(const char* src, const size_t count, const char* set, const size_t setCount)
+		{
+			using Function = size_t(*)(const char*, size_t, const char*, size_t);
+			static const Function function = JLB_DISPATCH(Function, FindAnyByteAvx2, FindAnyByteSse41,
+				[](const char* src, const size_t count, const char* set, const size_t setCount) { return FindAnyByteScalar(src, count, set, setCount); });
+			return function(src, count, set, setCount);
+		}
+
+		size_t FindBytes(const char* src, const size_t count, const char* pattern, const size_t patternCount)
+		{
+			using Function = size_t(*)(const char*, size_t, const char*, size_t);
+			static const Function function = JLB_DISPATCH(Function, FindBytesAvx2, FindBytesSse41,
+				[](const char* src, const size_t count, const char* pattern, const size_t patternCount) { return FindBytesScalar(src, count, pattern, patternCount); });
+			return function(src, count, pattern, patternCount);
+		}
+
+		size_t Mismatch(const char* a, const char* b, const size_t count)
+		{
+			using Function = size_t(*)(const char*, const char*, size_t);
+			static const Function function = JLB_DISPATCH(Function, MismatchAvx2, MismatchSse41,
+				[](const char* a, const char* b, const size_t count) { return MismatchScalar(a, b, count); });
+			return function(a, b, count);
+		}
+
+		bool BloomBlockContains(const uint32_t* block, const uint32_t hash)
+		{
+			using Function = bool(*)(const uint32_t*, uint32_t);
+			static const Function function = JLB_DISPATCH(Function, BloomBlockContainsAvx2, BloomBlockContainsSse41,
+				[](const uint32_t* block, const uint32_t hash) { return BloomBlockContainsScalar(block, hash); });
+			return function(block, hash);
+		}
+	}
+}
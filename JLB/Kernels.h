@@ -0,0 +1,354 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace jlb
+{
+	template <typename T>
+	class Array;
+
+	/// <summary>
+	/// Type returned by Sum. Integers are summed as 64 bit integers to prevent overflow.
+	/// </summary>
+	template <typename T>
+	using SumType = std::conditional_t<std::is_integral_v<T>, std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>, T>;
+
+	namespace kernelsImpl
+	{
+		// Vectorized kernels, implemented in Kernels.cpp.
+		// These pick the best implementation the CPU supports the first time they are called.
+		[[nodiscard]] size_t Find(const int32_t* src, size_t count, int32_t value);
+		[[nodiscard]] size_t Find(const float* src, size_t count, float value);
+		[[nodiscard]] size_t Count(const int32_t* src, size_t count, int32_t value);
+		[[nodiscard]] size_t Count(const float* src, size_t count, float value);
+		void MinMax(const int32_t* src, size_t count, int32_t& outMin, int32_t& outMax);
+		void MinMax(const float* src, size_t count, float& outMin, float& outMax);
+		[[nodiscard]] int64_t Sum(const int32_t* src, size_t count);
+		[[nodiscard]] float Sum(const float* src, size_t count);
+		[[nodiscard]] size_t PopCount(const uint64_t* src, size_t count);
+		[[nodiscard]] size_t FindByte(const char* src, size_t count, char value);
+		[[nodiscard]] size_t FindAnyByte(const char* src, size_t count, const char* set, size_t setCount);
+		[[nodiscard]] size_t FindBytes(const char* src, size_t count, const char* pattern, size_t patternCount);
+		[[nodiscard]] size_t Mismatch(const char* a, const char* b, size_t count);
+		// Checks if every bit that the hash selects in a BloomFilter block is set.
+		[[nodiscard]] bool BloomBlockContains(const uint32_t* block, uint32_t hash);
+
+		// A BloomFilter block sets one bit per word, selected by the top 5 bits of the hash multiplied by the salt of that word.
+		constexpr size_t BLOOM_BLOCK_WORDS = 8;
+		alignas(32) constexpr uint32_t BLOOM_SALTS[BLOOM_BLOCK_WORDS] =
+		{
+			0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+		};
+
+		// If T has a vectorized implementation.
+		template <typename T>
+		constexpr bool IS_VECTORIZED = std::is_same_v<T, int32_t> || std::is_same_v<T, float>;
+		// If values of T can be compared for equality by comparing their bits.
+		template <typename T>
+		constexpr bool IS_BITWISE_COMPARABLE = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+		// If T can use the byte kernels.
+		template <typename T>
+		constexpr bool IS_BYTE = IS_BITWISE_COMPARABLE<T> && sizeof(T) == 1;
+
+		template <typename T>
+		[[nodiscard]] char ToByte(const T& value)
+		{
+			static_assert(sizeof(T) == 1);
+			char byte;
+			memcpy(&byte, &value, 1);
+			return byte;
+		}
+
+		template <typename T>
+		[[nodiscard]] int32_t ToInt32Bits(const T& value)
+		{
+			static_assert(sizeof(T) == sizeof(int32_t));
+			int32_t bits;
+			memcpy(&bits, &value, sizeof(int32_t));
+			return bits;
+		}
+	}
+
+	/// <summary>
+	/// Sets every value in the range to the given value.
+	/// </summary>
+	/// <param name="dst">Start of the range.</param>
+	/// <param name="count">Amount of values in the range.</param>
+	/// <param name="value">Value to fill the range with.</param>
+	template <typename T>
+	void Fill(T* dst, const size_t count, const T& value)
+	{
+		if constexpr (sizeof(T) == 1 && std::is_trivially_copyable_v<T>)
+		{
+			unsigned char byte;
+			memcpy(&byte, &value, 1);
+			if (count > 0)
+				memset(dst, byte, count);
+		}
+		else
+		{
+			// Simple enough for the compiler to vectorize.
+			for (size_t i = 0; i < count; ++i)
+				dst[i] = value;
+		}
+	}
+
+	/// <summary>
+	/// Finds the first value in the range that is equal to the given value.
+	/// </summary>
+	/// <param name="src">Start of the range.</param>
+	/// <param name="count">Amount of values in the range.</param>
+	/// <param name="value">Value to look for.</param>
+	/// <returns>Index of the first equal value, or SIZE_MAX if there is none.</returns>
+	template <typename T>
+	[[nodiscard]] size_t Find(const T* src, const size_t count, const T& value)
+	{
+		if constexpr (kernelsImpl::IS_VECTORIZED<T>)
+			return kernelsImpl::Find(src, count, value);
+		else if constexpr (kernelsImpl::IS_BITWISE_COMPARABLE<T> && sizeof(T) == sizeof(int32_t))
+			return kernelsImpl::Find(reinterpret_cast<const int32_t*>(src), count, kernelsImpl::ToInt32Bits(value));
+		else if constexpr (kernelsImpl::IS_BYTE<T>)
+			return kernelsImpl::FindByte(reinterpret_cast<const char*>(src), count, kernelsImpl::ToByte(value));
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+				if (src[i] == value)
+					return i;
+			return SIZE_MAX;
+		}
+	}
+
+	/// <summary>
+	/// Counts the values in the range that are equal to the given value.
+	/// </summary>
+	/// <param name="src">Start of the range.</param>
+	/// <param name="count">Amount of values in the range.</param>
+	/// <param name="value">Value to count.</param>
+	/// <returns>Amount of equal values.</returns>
+	template <typename T>
+	[[nodiscard]] size_t Count(const T* src, const size_t count, const T& value)
+	{
+		if constexpr (kernelsImpl::IS_VECTORIZED<T>)
+			return kernelsImpl::Count(src, count, value);
+		else if constexpr (kernelsImpl::IS_BITWISE_COMPARABLE<T> && sizeof(T) == sizeof(int32_t))
+			return kernelsImpl::Count(reinterpret_cast<const int32_t*>(src), count, kernelsImpl::ToInt32Bits(value));
+		else
+		{
+			size_t n = 0;
+			for (size_t i = 0; i < count; ++i)
+				n += src[i] == value;
+			return n;
+		}
+	}
+
+	/// <summary>
+	/// Finds the smallest and largest value in the range.<br>
+	/// The result is unspecified if the range contains NaN values.
+	/// </summary>
+	/// <param name="src">Start of the range. Cannot be empty.</param>
+	/// <param name="count">Amount of values in the range.</param>
+	/// <param name="outMin">Smallest value.</param>
+	/// <param name="outMax">Largest value.</param>
+	template <typename T>
+	void MinMax(const T* src, const size_t count, T& outMin, T& outMax)
+	{
+		assert(count > 0);
+		if constexpr (kernelsImpl::IS_VECTORIZED<T>)
+			kernelsImpl::MinMax(src, count, outMin, outMax);
+		else
+		{
+			outMin = src[0];
+			outMax = src[0];
+			for (size_t i = 1; i < count; ++i)
+			{
+				outMin = src[i] < outMin ? src[i] : outMin;
+				outMax = outMax < src[i] ? src[i] : outMax;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Adds up all the values in the range.<br>
+	/// Floating point values are summed in multiple lanes, so the rounding can differ slightly from a sequential sum.
+	/// </summary>
+	/// <param name="src">Start of the range.</param>
+	/// <param name="count">Amount of values in the range.</param>
+	/// <returns>Sum of all the values.</returns>
+	template <typename T>
+	[[nodiscard]] SumType<T> Sum(const T* src, const size_t count)
+	{
+		if constexpr (kernelsImpl::IS_VECTORIZED<T>)
+			return kernelsImpl::Sum(src, count);
+		else
+		{
+			SumType<T> sum{};
+			for (size_t i = 0; i < count; ++i)
+				sum += src[i];
+			return sum;
+		}
+	}
+
+	/// <summary>
+	/// Checks if two ranges hold equal values.
+	/// </summary>
+	/// <param name="a">Start of the first range.</param>
+	/// <param name="b">Start of the second range.</param>
+	/// <param name="count">Amount of values in both ranges.</param>
+	/// <returns>If all the values are equal.</returns>
+	template <typename T>
+	[[nodiscard]] bool Compare(const T* a, const T* b, const size_t count)
+	{
+		// The C library compares memory many bytes at a time.
+		if constexpr (kernelsImpl::IS_BITWISE_COMPARABLE<T>)
+			return count == 0 || memcmp(a, b, count * sizeof(T)) == 0;
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+				if (!(a[i] == b[i]))
+					return false;
+			return true;
+		}
+	}
+
+	/// <summary>
+	/// Counts the set bits in the range.
+	/// </summary>
+	/// <param name="src">Start of the range.</param>
+	/// <param name="count">Amount of words in the range.</param>
+	/// <returns>Amount of set bits.</returns>
+	[[nodiscard]] inline size_t PopCount(const uint64_t* src, const size_t count)
+	{
+		return kernelsImpl::PopCount(src, count);
+	}
+
+	/// <summary>
+	/// Finds the first value in the range that is equal to any of the values in the set.
+	/// </summary>
+	/// <param name="src">Start of the range.</param>
+	/// <param name="count">Amount of values in the range.</param>
+	/// <param name="set">Values to look for.</param>
+	/// <param name="setCount">Amount of values to look for.</param>
+	/// <returns>Index of the first value that is in the set, or SIZE_MAX if there is none.</returns>
+	template <typename T>
+	[[nodiscard]] size_t FindAny(const T* src, const size_t count, const T* set, const size_t setCount)
+	{
+		if constexpr (kernelsImpl::IS_BYTE<T>)
+			return kernelsImpl::FindAnyByte(reinterpret_cast<const char*>(src), count, reinterpret_cast<const char*>(set), setCount);
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+				for (size_t j = 0; j < setCount; ++j)
+					if (src[i] == set[j])
+						return i;
+			return SIZE_MAX;
+		}
+	}
+
+	/// <summary>
+	/// Finds the first occurrence of a pattern in the range.
+	/// </summary>
+	/// <param name="src">Start of the range.</param>
+	/// <param name="count">Amount of values in the range.</param>
+	/// <param name="pattern">Values to look for, in order.</param>
+	/// <param name="patternCount">Amount of values in the pattern.</param>
+	/// <returns>Index where the pattern starts, or SIZE_MAX if there is none.</returns>
+	template <typename T>
+	[[nodiscard]] size_t Search(const T* src, const size_t count, const T* pattern, const size_t patternCount)
+	{
+		if constexpr (kernelsImpl::IS_BYTE<T>)
+			return kernelsImpl::FindBytes(reinterpret_cast<const char*>(src), count, reinterpret_cast<const char*>(pattern), patternCount);
+		else
+		{
+			if (patternCount > count)
+				return SIZE_MAX;
+			for (size_t i = 0; i + patternCount <= count; ++i)
+				if (Compare(&src[i], pattern, patternCount))
+					return i;
+			return SIZE_MAX;
+		}
+	}
+
+	/// <summary>
+	/// Finds the first position where two ranges hold different values.
+	/// </summary>
+	/// <param name="a">Start of the first range.</param>
+	/// <param name="b">Start of the second range.</param>
+	/// <param name="count">Amount of values in both ranges.</param>
+	/// <returns>Index of the first difference, or SIZE_MAX if all the values are equal.</returns>
+	template <typename T>
+	[[nodiscard]] size_t Mismatch(const T* a, const T* b, const size_t count)
+	{
+		if constexpr (kernelsImpl::IS_BYTE<T>)
+			return kernelsImpl::Mismatch(reinterpret_cast<const char*>(a), reinterpret_cast<const char*>(b), count);
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+				if (!(a[i] == b[i]))
+					return i;
+			return SIZE_MAX;
+		}
+	}
+
+	/// <summary>
+	/// Sets every value between begin() and end() to the given value.
+	/// </summary>
+	template <typename T>
+	void Fill(Array<T>& array, const T& value)
+	{
+		Fill(array.GetData(), static_cast<size_t>(array.end() - array.begin()), value);
+	}
+
+	/// <summary>
+	/// Finds the first value between begin() and end() that is equal to the given value.
+	/// </summary>
+	/// <returns>Index of the first equal value, or SIZE_MAX if there is none.</returns>
+	template <typename T>
+	[[nodiscard]] size_t Find(Array<T>& array, const T& value)
+	{
+		return Find(array.GetData(), static_cast<size_t>(array.end() - array.begin()), value);
+	}
+
+	/// <summary>
+	/// Counts the values between begin() and end() that are equal to the given value.
+	/// </summary>
+	/// <returns>Amount of equal values.</returns>
+	template <typename T>
+	[[nodiscard]] size_t Count(Array<T>& array, const T& value)
+	{
+		return Count(array.GetData(), static_cast<size_t>(array.end() - array.begin()), value);
+	}
+
+	/// <summary>
+	/// Finds the smallest and largest value between begin() and end(). Cannot be empty.
+	/// </summary>
+	template <typename T>
+	void MinMax(Array<T>& array, T& outMin, T& outMax)
+	{
+		MinMax(array.GetData(), static_cast<size_t>(array.end() - array.begin()), outMin, outMax);
+	}
+
+	/// <summary>
+	/// Adds up all the values between begin() and end().
+	/// </summary>
+	/// <returns>Sum of all the values.</returns>
+	template <typename T>
+	[[nodiscard]] SumType<T> Sum(Array<T>& array)
+	{
+		return Sum(array.GetData(), static_cast<size_t>(array.end() - array.begin()));
+	}
+
+	/// <summary>
+	/// Checks if the values between begin() and end() of two arrays are equal.
+	/// </summary>
+	/// <returns>If both arrays hold the same amount of values, and all of them are equal.</returns>
+	template <typename T>
+	[[nodiscard]] bool Compare(Array<T>& a, Array<T>& b)
+	{
+		const size_t count = a.end() - a.begin();
+		return count == static_cast<size_t>(b.end() - b.begin()) && Compare(a.GetData(), b.GetData(), count);
+	}
+}
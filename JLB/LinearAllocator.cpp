@@ -1,6 +1,11 @@
 ﻿#include "LinearAllocator.h"
-#include <malloc.h>
+#include <cstdlib>
 #include <cassert>
+#include <cstdint>
+#ifdef JLB_ALLOCATOR_STATS
+#include <cstdio>
+#include <cstring>
+#endif
 
 namespace jlb
 {
@@ -10,11 +15,29 @@ namespace jlb
 	{
 		// Allocate N size_t chunks.
 		_memory = reinterpret_cast<size_t*>(malloc(_size * sizeof(size_t)));
+#ifdef JLB_ALLOCATOR_STATS
+		_tags[0].tag = "untagged";
+#endif
+	}
+
+	LinearAllocator::LinearAllocator(void* memory, const size_t size, const size_t used) :
+		// Round down, the last partial chunk does not belong to the allocator.
+		_memory(static_cast<size_t*>(memory)), _size(size / sizeof(size_t)), _current(ToChunkSize(used)), _external(true)
+	{
+		assert(reinterpret_cast<uintptr_t>(memory) % alignof(size_t) == 0);
+		assert(_current < _size || _size == 0);
+#ifdef JLB_ALLOCATOR_STATS
+		_tags[0].tag = "untagged";
+		_stats.usedBytes = _current * sizeof(size_t);
+		_stats.peakBytes = _stats.usedBytes;
+		_tags[0].usedBytes = _stats.usedBytes;
+#endif
 	}
 
 	LinearAllocator::~LinearAllocator()
 	{
-		free(_memory);
+		if (!_external)
+			free(_memory);
 	}
 
 	void* LinearAllocator::Malloc(size_t size)
@@ -29,6 +52,11 @@ namespace jlb
 		// Move N steps forward and store the size of this allocation in the furthest chunk.
 		_current += size;
 		_memory[_current] = size;
+#ifdef JLB_ALLOCATOR_STATS
+		_memory[_current] |= static_cast<size_t>(_tag) << _tagShift;
+		TrackUsage(_tag, 0, size + 1);
+		Trace(AllocatorEvent::Malloc, _tag, _current - size, size);
+#endif
 		// Increment by one due to the extra size metadata.
 		++_current;
 
@@ -39,8 +67,84 @@ namespace jlb
 	{
 		// Assert if there is anything to free.
 		assert(_current > 0);
-		// Move N places back, based on the amount of memory allocated during the last Malloc.
-		_current -= _memory[_current - 1] + 1;
+		// Free the last allocation, and any allocations that have been released while they were buried underneath it.
+		do
+		{
+			const size_t metadata = _memory[_current - 1];
+			const size_t size = metadata & _sizeMask;
+			// Move N places back, based on the amount of memory allocated during the Malloc.
+			_current -= size + 1;
+#ifdef JLB_ALLOCATOR_STATS
+			const auto tag = static_cast<uint32_t>((metadata & _tagMask) >> _tagShift);
+			TrackUsage(tag, size + 1, 0);
+			Trace(AllocatorEvent::Free, tag, _current, size);
+#endif
+		} while (_current > 0 && (_memory[_current - 1] & _releasedFlag));
+	}
+
+	bool LinearAllocator::IsTop(const void* ptr) const
+	{
+		if (_current == 0)
+			return false;
+		// The newest allocation starts N chunks before its size metadata.
+		return ptr == &_memory[_current - 1 - (_memory[_current - 1] & _sizeMask)];
+	}
+
+	bool LinearAllocator::TryResize(const void* ptr, size_t size)
+	{
+		if (!IsTop(ptr))
+			return false;
+
+		// Check if there still is enough free space, starting from the beginning of the allocation.
+		size = ToChunkSize(size);
+		const size_t metadata = _memory[_current - 1];
+		const size_t start = _current - 1 - (metadata & _sizeMask);
+		if (size + start + 1 >= _size)
+			return false;
+
+		// Move the size metadata to the new end of the allocation.
+		_current = start + size;
+		_memory[_current] = size | (metadata & _tagMask);
+#ifdef JLB_ALLOCATOR_STATS
+		const auto tag = static_cast<uint32_t>((metadata & _tagMask) >> _tagShift);
+		TrackUsage(tag, (metadata & _sizeMask) + 1, size + 1);
+		Trace(AllocatorEvent::Resize, tag, start, size);
+#endif
+		++_current;
+		return true;
+	}
+
+	void LinearAllocator::Release(const void* ptr, const size_t size)
+	{
+		if (IsTop(ptr))
+		{
+			Free();
+			return;
+		}
+
+		// Mark the size metadata, so that Free will skip over this allocation.
+		const size_t start = static_cast<const size_t*>(ptr) - _memory;
+		size_t& metadata = _memory[start + ToChunkSize(size)];
+		assert((metadata & _sizeMask) == ToChunkSize(size));
+		metadata |= _releasedFlag;
+#ifdef JLB_ALLOCATOR_STATS
+		Trace(AllocatorEvent::Release, static_cast<uint32_t>((metadata & _tagMask) >> _tagShift), start, ToChunkSize(size));
+#endif
+	}
+
+	void LinearAllocator::Clear()
+	{
+#ifdef JLB_ALLOCATOR_STATS
+		if (_current > 0)
+		{
+			Trace(AllocatorEvent::Free, 0, 0, _current);
+			_stats.usedBytes = 0;
+			++_stats.freeCount;
+			for (size_t i = 0; i < _tagCount; ++i)
+				_tags[i].usedBytes = 0;
+		}
+#endif
+		_current = 0;
 	}
 
 	size_t LinearAllocator::GetAvailableMemorySpace() const
@@ -48,9 +152,143 @@ namespace jlb
 		return (_size - _current - 1) * sizeof(size_t);
 	}
 
+	size_t LinearAllocator::GetUsedMemorySpace() const
+	{
+		return _current * sizeof(size_t);
+	}
+
 	size_t LinearAllocator::ToChunkSize(const size_t size)
 	{
 		// Rounds up to the nearest integer.
 		return size / sizeof(size_t) + (size % sizeof(size_t) > 0);
 	}
+
+#ifdef JLB_ALLOCATOR_STATS
+	LinearAllocator::TagScope::TagScope(LinearAllocator& allocator, const char* tag) :
+		_allocator(allocator), _previous(allocator._tag)
+	{
+		allocator._tag = allocator.FindOrAddTag(tag);
+	}
+
+	LinearAllocator::TagScope::~TagScope()
+	{
+		_allocator._tag = _previous;
+	}
+
+	const AllocatorStats& LinearAllocator::GetStats() const
+	{
+		return _stats;
+	}
+
+	size_t LinearAllocator::GetTagCount() const
+	{
+		return _tagCount;
+	}
+
+	const AllocatorTagStats& LinearAllocator::GetTagStats(const size_t index) const
+	{
+		assert(index < _tagCount);
+		return _tags[index];
+	}
+
+	const AllocatorTagStats* LinearAllocator::FindTagStats(const char* tag) const
+	{
+		if (!tag)
+			return &_tags[0];
+		for (size_t i = 1; i < _tagCount; ++i)
+			if (_tags[i].tag == tag || strcmp(_tags[i].tag, tag) == 0)
+				return &_tags[i];
+		return nullptr;
+	}
+
+	size_t LinearAllocator::GetTraceCount() const
+	{
+		return _traceSequence < JLB_ALLOCATOR_TRACE_SIZE ? static_cast<size_t>(_traceSequence) : JLB_ALLOCATOR_TRACE_SIZE;
+	}
+
+	const AllocatorTraceEvent& LinearAllocator::GetTraceEvent(const size_t index) const
+	{
+		assert(index < GetTraceCount());
+		const uint64_t sequence = _traceSequence - GetTraceCount() + index;
+		return _trace[sequence % JLB_ALLOCATOR_TRACE_SIZE];
+	}
+
+	bool LinearAllocator::DumpTrace(const char* path) const
+	{
+		FILE* file = fopen(path, "w");
+		if (!file)
+			return false;
+
+		static constexpr const char* eventNames[] = { "malloc", "free", "resize", "release" };
+		fprintf(file, "sequence,event,tag,offset,bytes\n");
+		const size_t count = GetTraceCount();
+		for (size_t i = 0; i < count; ++i)
+		{
+			const AllocatorTraceEvent& event = GetTraceEvent(i);
+			fprintf(file, "%llu,%s,%s,%zu,%zu\n", static_cast<unsigned long long>(event.sequence),
+				eventNames[static_cast<size_t>(event.event)], _tags[event.tag].tag, event.offset, event.size);
+		}
+
+		fprintf(file, "\ntag,used,peak,total,mallocs\n");
+		for (size_t i = 0; i < _tagCount; ++i)
+		{
+			const AllocatorTagStats& tag = _tags[i];
+			fprintf(file, "%s,%zu,%zu,%zu,%zu\n", tag.tag, tag.usedBytes, tag.peakBytes, tag.totalBytes, tag.mallocCount);
+		}
+		fprintf(file, "total,%zu,%zu,,%zu\n", _stats.usedBytes, _stats.peakBytes, _stats.mallocCount);
+
+		return fclose(file) == 0;
+	}
+
+	uint32_t LinearAllocator::FindOrAddTag(const char* tag)
+	{
+		if (!tag)
+			return 0;
+		// Tags are usually string literals, so compare the pointers first before falling back to the contents.
+		for (size_t i = 1; i < _tagCount; ++i)
+			if (_tags[i].tag == tag || strcmp(_tags[i].tag, tag) == 0)
+				return static_cast<uint32_t>(i);
+
+		// When out of tags, the allocations are counted as untagged.
+		assert(_tagCount < JLB_ALLOCATOR_MAX_TAGS);
+		if (_tagCount == JLB_ALLOCATOR_MAX_TAGS)
+			return 0;
+		_tags[_tagCount].tag = tag;
+		return static_cast<uint32_t>(_tagCount++);
+	}
+
+	void LinearAllocator::TrackUsage(const uint32_t tag, const size_t oldSize, const size_t newSize)
+	{
+		// Sizes are in chunks, including the size metadata.
+		const size_t oldBytes = oldSize * sizeof(size_t);
+		const size_t newBytes = newSize * sizeof(size_t);
+		AllocatorTagStats& tagStats = _tags[tag];
+
+		_stats.usedBytes = _stats.usedBytes - oldBytes + newBytes;
+		tagStats.usedBytes = tagStats.usedBytes - oldBytes + newBytes;
+		if (newBytes > oldBytes)
+			tagStats.totalBytes += newBytes - oldBytes;
+		if (oldSize == 0)
+		{
+			++_stats.mallocCount;
+			++tagStats.mallocCount;
+		}
+		if (newSize == 0)
+			++_stats.freeCount;
+
+		_stats.peakBytes = _stats.usedBytes > _stats.peakBytes ? _stats.usedBytes : _stats.peakBytes;
+		tagStats.peakBytes = tagStats.usedBytes > tagStats.peakBytes ? tagStats.usedBytes : tagStats.peakBytes;
+	}
+
+	void LinearAllocator::Trace(const AllocatorEvent event, const uint32_t tag, const size_t offset, const size_t size)
+	{
+		// Overwrite the oldest event when the ring buffer is full.
+		AllocatorTraceEvent& traceEvent = _trace[_traceSequence % JLB_ALLOCATOR_TRACE_SIZE];
+		traceEvent.sequence = _traceSequence++;
+		traceEvent.event = event;
+		traceEvent.tag = tag;
+		traceEvent.offset = offset * sizeof(size_t);
+		traceEvent.size = size * sizeof(size_t);
+	}
+#endif
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 ﻿#pragma once
+#include <cstddef>
+#include "AllocatorStats.h"
 
 namespace jlb
 {
@@ -12,6 +14,14 @@ namespace jlb
 	{
 	public:
 		explicit LinearAllocator(size_t size);
+		/// <summary>
+		/// Allocates from memory that is owned by something else, like a memory mapped file.
+		/// </summary>
+		/// <param name="memory">Memory to allocate from, aligned to at least sizeof(size_t).</param>
+		/// <param name="size">Size of the memory.</param>
+		/// <param name="used">Amount of memory that is already in use by an earlier allocator with the same memory,
+		/// as returned by its GetUsedMemorySpace. Its allocations can be freed as if they were made by this allocator.</param>
+		LinearAllocator(void* memory, size_t size, size_t used = 0);
 		~LinearAllocator();
 
 		LinearAllocator(LinearAllocator& other) = delete;
@@ -31,6 +41,32 @@ namespace jlb
 		/// Does not call destructors.
 		/// </summary>
 		void Free();
+		/// <summary>
+		/// Checks if the pointer points to the newest allocation.
+		/// </summary>
+		/// <param name="ptr">Pointer returned by Malloc.</param>
+		/// <returns>If the pointer points to the newest allocation.</returns>
+		[[nodiscard]] bool IsTop(const void* ptr) const;
+		/// <summary>
+		/// Tries to resize the newest allocation in place, without moving or copying any memory.
+		/// </summary>
+		/// <param name="ptr">Pointer returned by Malloc.</param>
+		/// <param name="size">The new size of the allocation.</param>
+		/// <returns>False if the pointer is not the newest allocation or if there is not enough free space.</returns>
+		[[nodiscard]] bool TryResize(const void* ptr, size_t size);
+		/// <summary>
+		/// Marks an allocation as no longer in use.<br>
+		/// If it is the newest allocation it is freed immediately, 
+		/// otherwise it is freed as soon as everything on top of it has been freed.
+		/// </summary>
+		/// <param name="ptr">Pointer returned by Malloc.</param>
+		/// <param name="size">The size that was used to allocate the memory.</param>
+		void Release(const void* ptr, size_t size);
+		/// <summary>
+		/// Frees all allocations at once, in constant time.<br>
+		/// Does not call destructors.
+		/// </summary>
+		void Clear();
 
 		/// <summary>
 		/// Wrapper method for Malloc. Immediately casts the allocated memory to one or multiple classes of type T.<br>
@@ -47,14 +83,103 @@ namespace jlb
 		/// </summary>
 		/// <returns></returns>
 		[[nodiscard]] size_t GetAvailableMemorySpace() const;
+		/// <summary>
+		/// Returns the amount of memory in use, including the size metadata of every allocation.
+		/// </summary>
+		[[nodiscard]] size_t GetUsedMemorySpace() const;
+
+#ifdef JLB_ALLOCATOR_STATS
+		/// <summary>
+		/// Attributes all allocations made during its lifetime to a tag. Scopes can be nested.<br>
+		/// Use the JLB_ALLOCATOR_TAG macro, so that the scope disappears when statistics are disabled.
+		/// </summary>
+		class TagScope final
+		{
+		public:
+			TagScope(LinearAllocator& allocator, const char* tag);
+			~TagScope();
+
+			TagScope(TagScope& other) = delete;
+			TagScope(TagScope&& other) = delete;
+			TagScope& operator=(TagScope& other) = delete;
+			TagScope& operator=(TagScope&& other) = delete;
+
+		private:
+			LinearAllocator& _allocator;
+			uint32_t _previous;
+		};
+
+		/// <summary>
+		/// Gets the current and peak usage, and the amount of allocations made so far.
+		/// </summary>
+		[[nodiscard]] const AllocatorStats& GetStats() const;
+		/// <summary>
+		/// Gets the amount of tags that have been used, including the untagged tag at index 0.
+		/// </summary>
+		[[nodiscard]] size_t GetTagCount() const;
+		/// <summary>
+		/// Gets the usage of a single tag.
+		/// </summary>
+		/// <param name="index">Index of the tag, smaller than the tag count.</param>
+		[[nodiscard]] const AllocatorTagStats& GetTagStats(size_t index) const;
+		/// <summary>
+		/// Gets the usage of a single tag.
+		/// </summary>
+		/// <param name="tag">Name of the tag, or nullptr for the untagged allocations.</param>
+		/// <returns>Usage of the tag, or nullptr if the tag has never been used.</returns>
+		[[nodiscard]] const AllocatorTagStats* FindTagStats(const char* tag) const;
+		/// <summary>
+		/// Gets the amount of events stored in the trace, which is capped at JLB_ALLOCATOR_TRACE_SIZE.
+		/// </summary>
+		[[nodiscard]] size_t GetTraceCount() const;
+		/// <summary>
+		/// Gets an event from the trace, where index 0 is the oldest event that is still stored.
+		/// </summary>
+		/// <param name="index">Index of the event, smaller than the trace count.</param>
+		[[nodiscard]] const AllocatorTraceEvent& GetTraceEvent(size_t index) const;
+		/// <summary>
+		/// Writes the trace as CSV, oldest event first, followed by the usage of every tag.
+		/// </summary>
+		/// <param name="path">Path of the file that will be overwritten.</param>
+		/// <returns>False if the file could not be written.</returns>
+		bool DumpTrace(const char* path) const;
+#endif
 
 	private:
+		// Flag used in the size metadata to mark allocations that have been released, but not yet freed.
+		static constexpr size_t _releasedFlag = ~(~static_cast<size_t>(0) >> 1);
+#ifdef JLB_ALLOCATOR_STATS
+		// The tag of every allocation is stored in the bits below the released flag, so that it can be found again when it is freed.
+		static constexpr size_t _tagShift = sizeof(size_t) * 8 - 8;
+		static constexpr size_t _tagMask = static_cast<size_t>(0x7F) << _tagShift;
+		static_assert(JLB_ALLOCATOR_MAX_TAGS <= 0x80, "Tag index does not fit in the size metadata.");
+#else
+		static constexpr size_t _tagMask = 0;
+#endif
+		// Masks out the flags of the size metadata, leaving the size of the allocation in chunks.
+		static constexpr size_t _sizeMask = ~(_releasedFlag | _tagMask);
+
 		// Pointer to the big chunk of memory, from which everything is allocated.
 		size_t* _memory = nullptr;
 		// The total size of the big chunk of memory.
 		size_t _size = 0;
 		// The current memory index where new allocations will take place.
 		size_t _current = 0;
+		// If the memory is owned by something else, and should not be freed by the allocator.
+		bool _external = false;
+
+#ifdef JLB_ALLOCATOR_STATS
+		AllocatorStats _stats{};
+		AllocatorTagStats _tags[JLB_ALLOCATOR_MAX_TAGS]{};
+		size_t _tagCount = 1;
+		uint32_t _tag = 0;
+		AllocatorTraceEvent _trace[JLB_ALLOCATOR_TRACE_SIZE]{};
+		uint64_t _traceSequence = 0;
+
+		[[nodiscard]] uint32_t FindOrAddTag(const char* tag);
+		void TrackUsage(uint32_t tag, size_t oldSize, size_t newSize);
+		void Trace(AllocatorEvent event, uint32_t tag, size_t offset, size_t size);
+#endif
 
 		/// <summary>
 		/// Converts device size into chunk size.<br>
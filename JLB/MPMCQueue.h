@@ -0,0 +1,201 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include "LinearAllocator.h"
+#include "CacheLine.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Bounded first-in-first-out queue that can be used by any amount of producer and consumer threads.<br>
+	/// Lock-free: every slot carries a sequence number that tells producers and consumers whose turn it is,
+	/// so threads only contend on a single compare-and-swap.
+	/// </summary>
+	template <typename T>
+	class MPMCQueue final
+	{
+	public:
+		MPMCQueue() = default;
+		MPMCQueue(MPMCQueue& other) = delete;
+		MPMCQueue(MPMCQueue&& other) = delete;
+		MPMCQueue& operator=(MPMCQueue& other) = delete;
+		MPMCQueue& operator=(MPMCQueue&& other) = delete;
+
+		/// <summary>
+		/// Allocates the ring buffer. Not thread safe.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="capacity">Minimum capacity of the queue. Will be rounded up to a power of two.</param>
+		void Allocate(LinearAllocator& allocator, size_t capacity);
+		/// <summary>
+		/// Frees the ring buffer from the linear allocator. Not thread safe.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Add a value to the back of the queue.
+		/// </summary>
+		/// <param name="value">Value to be added.</param>
+		/// <returns>False if the queue is full.</returns>
+		[[nodiscard]] bool TryEnqueue(const T& value);
+		/// <summary>
+		/// Add as many values as possible to the back of the queue.<br>
+		/// Values from other producers can end up in between.
+		/// </summary>
+		/// <param name="src">Values to be added.</param>
+		/// <param name="count">Amount of values to be added.</param>
+		/// <returns>Amount of values that have been added.</returns>
+		size_t TryEnqueue(const T* src, size_t count);
+		/// <summary>
+		/// Get and remove the front value of the queue.
+		/// </summary>
+		/// <param name="outValue">Front value of the queue.</param>
+		/// <returns>False if the queue is empty.</returns>
+		[[nodiscard]] bool TryDequeue(T& outValue);
+		/// <summary>
+		/// Get and remove as many values as possible from the front of the queue.
+		/// </summary>
+		/// <param name="dst">Destination for the removed values.</param>
+		/// <param name="count">Maximum amount of values to be removed.</param>
+		/// <returns>Amount of values that have been removed.</returns>
+		size_t TryDequeue(T* dst, size_t count);
+
+		/// <summary>
+		/// Gets the maximum amount of values the queue can hold.
+		/// </summary>
+		/// <returns>Capacity of the queue.</returns>
+		[[nodiscard]] size_t GetCapacity() const;
+
+	private:
+		struct Cell final
+		{
+			std::atomic<size_t> sequence;
+			T value;
+		};
+
+		// Shared, but only written to during allocation.
+		Cell* _cells = nullptr;
+		size_t _mask = 0;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> _enqueuePos{ 0 };
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> _dequeuePos{ 0 };
+	};
+
+	template <typename T>
+	void MPMCQueue<T>::Allocate(LinearAllocator& allocator, const size_t capacity)
+	{
+		assert(capacity > 1);
+
+		// Round up to a power of two, so that indices can be wrapped with a mask.
+		size_t length = 2;
+		while (length < capacity)
+			length *= 2;
+
+		_cells = allocator.New<Cell>(length);
+		_mask = length - 1;
+
+		// Each cell starts out ready to be written to at the position equal to its index.
+		for (size_t i = 0; i < length; ++i)
+			new (&_cells[i].sequence) std::atomic<size_t>(i);
+
+		_enqueuePos.store(0, std::memory_order_relaxed);
+		_dequeuePos.store(0, std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	void MPMCQueue<T>::Free(LinearAllocator& allocator)
+	{
+		allocator.Free();
+	}
+
+	template <typename T>
+	bool MPMCQueue<T>::TryEnqueue(const T& value)
+	{
+		Cell* cell;
+		size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			cell = &_cells[pos & _mask];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const auto diff = static_cast<ptrdiff_t>(sequence - pos);
+
+			// The cell is free for this position, try to claim it.
+			if (diff == 0)
+			{
+				if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			// The cell still holds a value from the previous lap, so the queue is full.
+			else if (diff < 0)
+				return false;
+			// Another producer claimed this position.
+			else
+				pos = _enqueuePos.load(std::memory_order_relaxed);
+		}
+
+		cell->value = value;
+		// Hand the cell over to the consumer of this position.
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T>
+	size_t MPMCQueue<T>::TryEnqueue(const T* src, const size_t count)
+	{
+		size_t i = 0;
+		while (i < count && TryEnqueue(src[i]))
+			++i;
+		return i;
+	}
+
+	template <typename T>
+	bool MPMCQueue<T>::TryDequeue(T& outValue)
+	{
+		Cell* cell;
+		size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			cell = &_cells[pos & _mask];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const auto diff = static_cast<ptrdiff_t>(sequence - (pos + 1));
+
+			// The cell holds a value for this position, try to claim it.
+			if (diff == 0)
+			{
+				if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			// No producer has written to this position yet, so the queue is empty.
+			else if (diff < 0)
+				return false;
+			// Another consumer claimed this position.
+			else
+				pos = _dequeuePos.load(std::memory_order_relaxed);
+		}
+
+		outValue = cell->value;
+		// Hand the cell over to the producer of the next lap.
+		cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T>
+	size_t MPMCQueue<T>::TryDequeue(T* dst, const size_t count)
+	{
+		size_t i = 0;
+		while (i < count && TryDequeue(dst[i]))
+			++i;
+		return i;
+	}
+
+	template <typename T>
+	size_t MPMCQueue<T>::GetCapacity() const
+	{
+		return _mask + 1;
+	}
+}
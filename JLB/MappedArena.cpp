@@ -0,0 +1,135 @@
+#include "MappedArena.h"
+#include <cassert>
+
+namespace jlb
+{
+	struct MappedArena::Header final
+	{
+		uint64_t magic;
+		uint64_t version;
+		// Size of the memory after the header.
+		uint64_t size;
+		uint64_t used;
+		// Offset of the root from the start of the memory after the header, or UINT64_MAX.
+		uint64_t root;
+		// How the allocator stores its metadata in the memory, see ARENA_FLAGS.
+		uint64_t flags;
+		// Keeps the memory after the header aligned to a cache line.
+		uint64_t reserved[2];
+	};
+
+	// The header is private, so the helpers below take it as a template parameter.
+	namespace
+	{
+		constexpr uint64_t ARENA_MAGIC = 0x414E455241424C4A; // "JLBARENA"
+		constexpr uint64_t ARENA_VERSION = 2;
+
+		// With statistics enabled, the allocator stores a tag in the size of every allocation.
+		constexpr uint64_t ARENA_FLAG_ALLOCATOR_STATS = 1;
+#ifdef JLB_ALLOCATOR_STATS
+		constexpr uint64_t ARENA_FLAGS = ARENA_FLAG_ALLOCATOR_STATS;
+#else
+		constexpr uint64_t ARENA_FLAGS = 0;
+#endif
+
+		// Fills in the header of a newly created file.
+		template <typename Header>
+		Header* CreateHeader(MappedFile& file, const size_t size)
+		{
+			if (!file.IsOpen())
+				return nullptr;
+			auto header = static_cast<Header*>(file.GetData());
+			header->magic = ARENA_MAGIC;
+			header->version = ARENA_VERSION;
+			header->size = size;
+			header->used = 0;
+			header->root = UINT64_MAX;
+			header->flags = ARENA_FLAGS;
+			return header;
+		}
+
+		// Checks if an existing file has been created by a compatible arena.
+		template <typename Header>
+		Header* ValidateHeader(MappedFile& file)
+		{
+			if (file.GetSize() < sizeof(Header))
+				return nullptr;
+			auto header = static_cast<Header*>(file.GetData());
+			if (header->magic != ARENA_MAGIC || header->version != ARENA_VERSION || header->flags != ARENA_FLAGS ||
+				header->size > file.GetSize() - sizeof(Header) || header->used > header->size)
+				return nullptr;
+			return header;
+		}
+
+		template <typename Header>
+		void* GetMemory(Header* header)
+		{
+			return header ? header + 1 : nullptr;
+		}
+	}
+
+	MappedArena::MappedArena(const char* path, const size_t size) :
+		_file(path, MapMode::Create, sizeof(Header) + size),
+		_header(CreateHeader<Header>(_file, size)),
+		_allocator(GetMemory(_header), _header ? size : 0)
+	{
+		static_assert(sizeof(Header) == 64, "The memory after the header should be aligned to a cache line.");
+	}
+
+	MappedArena::MappedArena(const char* path, const MapMode mode) :
+		_file(path, mode),
+		_header(ValidateHeader<Header>(_file)),
+		_allocator(GetMemory(_header), _header ? static_cast<size_t>(_header->size) : 0,
+			_header ? static_cast<size_t>(_header->used) : 0)
+	{
+		assert(mode != MapMode::Create);
+		if (!_header)
+			_file.Close();
+	}
+
+	MappedArena::~MappedArena()
+	{
+		if (IsWritable())
+			_header->used = _allocator.GetUsedMemorySpace();
+	}
+
+	LinearAllocator& MappedArena::GetAllocator()
+	{
+		assert(IsWritable());
+		return _allocator;
+	}
+
+	bool MappedArena::Flush()
+	{
+		if (!IsWritable())
+			return false;
+		_header->used = _allocator.GetUsedMemorySpace();
+		return _file.Flush();
+	}
+
+	void MappedArena::SetRoot(const void* ptr)
+	{
+		assert(IsWritable());
+		const auto memory = static_cast<const char*>(GetMemory(_header));
+		const auto root = static_cast<const char*>(ptr);
+		assert(!ptr || (root >= memory && root < memory + _header->size));
+		_header->root = ptr ? static_cast<uint64_t>(root - memory) : UINT64_MAX;
+	}
+
+	bool MappedArena::IsOpen() const
+	{
+		return _header != nullptr;
+	}
+
+	bool MappedArena::IsWritable() const
+	{
+		return _header != nullptr && _file.IsWritable();
+	}
+
+	void* MappedArena::GetRootAddress() const
+	{
+		if (!_header || _header->root == UINT64_MAX)
+			return nullptr;
+		return static_cast<char*>(GetMemory(_header)) + _header->root;
+	}
+}
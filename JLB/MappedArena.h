@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include "LinearAllocator.h"
+#include "MappedFile.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Linear allocator that allocates from a memory mapped file, so that its contents can be reused by a later process.<br>
+	/// Build containers like OffsetArray and OffsetHashMap in it, mark the outermost one as the root,
+	/// and a later process can use them as soon as the file is mapped, at whatever address it is mapped.<br>
+	/// Regular containers store raw pointers and virtual tables, which are not valid in another process.
+	/// </summary>
+	class MappedArena final
+	{
+	public:
+		/// <summary>
+		/// Creates an empty arena file, overwriting any existing file. Check IsOpen to see if it succeeded.
+		/// </summary>
+		/// <param name="path">Path of the file.</param>
+		/// <param name="size">Amount of memory that can be allocated.</param>
+		MappedArena(const char* path, size_t size);
+		/// <summary>
+		/// Maps an existing arena file. Check IsOpen to see if it succeeded and the file is a valid arena.<br>
+		/// Files created by a build with a different JLB_ALLOCATOR_STATS setting are rejected, since their allocations are stored differently.
+		/// </summary>
+		/// <param name="path">Path of the file.</param>
+		/// <param name="mode">Read for a shared read-only mapping, or ReadWrite to continue allocating.</param>
+		MappedArena(const char* path, MapMode mode);
+		/// <summary>
+		/// Stores the allocator state in the file when it is writable.
+		/// </summary>
+		~MappedArena();
+
+		MappedArena(MappedArena& other) = delete;
+		MappedArena(MappedArena&& other) = delete;
+		MappedArena& operator=(MappedArena& other) = delete;
+		MappedArena& operator=(MappedArena&& other) = delete;
+
+		/// <summary>
+		/// Gets the allocator that allocates from the file. The arena has to be writable.
+		/// </summary>
+		[[nodiscard]] LinearAllocator& GetAllocator();
+		/// <summary>
+		/// Stores the allocator state in the file, and writes all changes to disk.
+		/// </summary>
+		/// <returns>False if the arena is not writable or if writing failed.</returns>
+		bool Flush();
+
+		/// <summary>
+		/// Marks the allocation from which a later process should start reading. The arena has to be writable.
+		/// </summary>
+		/// <param name="ptr">Memory allocated from this arena, or nullptr.</param>
+		void SetRoot(const void* ptr);
+		/// <summary>
+		/// Gets the allocation that has been marked as the root.
+		/// </summary>
+		/// <returns>Root at the address the file is currently mapped at, or nullptr.</returns>
+		template <typename T>
+		[[nodiscard]] T* GetRoot() const;
+
+		[[nodiscard]] bool IsOpen() const;
+		[[nodiscard]] bool IsWritable() const;
+
+	private:
+		struct Header;
+
+		MappedFile _file;
+		Header* _header;
+		LinearAllocator _allocator;
+
+		[[nodiscard]] void* GetRootAddress() const;
+	};
+
+	template <typename T>
+	T* MappedArena::GetRoot() const
+	{
+		return static_cast<T*>(GetRootAddress());
+	}
+}
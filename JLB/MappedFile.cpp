@@ -0,0 +1,118 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace jlb
+{
+	MappedFile::MappedFile(const char* path, const MapMode mode, size_t size) :
+		_writable(mode != MapMode::Read)
+	{
+#ifdef _WIN32
+		const HANDLE file = CreateFileA(path, _writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+			FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, mode == MapMode::Create ? CREATE_ALWAYS : OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+
+		if (mode != MapMode::Create)
+		{
+			LARGE_INTEGER fileSize;
+			size = GetFileSizeEx(file, &fileSize) ? static_cast<size_t>(fileSize.QuadPart) : 0;
+		}
+
+		// Creating the mapping also grows a new file to the right size.
+		const unsigned long long mappingSize = size;
+		const HANDLE mapping = size > 0 ? CreateFileMappingA(file, nullptr, _writable ? PAGE_READWRITE : PAGE_READONLY,
+			static_cast<DWORD>(mappingSize >> 32), static_cast<DWORD>(mappingSize), nullptr) : nullptr;
+		if (mapping)
+		{
+			_data = MapViewOfFile(mapping, _writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+			// The view keeps the mapping and the file alive.
+			CloseHandle(mapping);
+		}
+		CloseHandle(file);
+#else
+		const int flags = mode == MapMode::Read ? O_RDONLY : mode == MapMode::ReadWrite ? O_RDWR : O_RDWR | O_CREAT | O_TRUNC;
+		const int file = open(path, flags, 0644);
+		if (file < 0)
+			return;
+
+		bool sized = true;
+		if (mode == MapMode::Create)
+			sized = ftruncate(file, static_cast<off_t>(size)) == 0;
+		else
+		{
+			struct stat status{};
+			sized = fstat(file, &status) == 0;
+			size = sized ? static_cast<size_t>(status.st_size) : 0;
+		}
+
+		if (sized && size > 0)
+		{
+			void* data = mmap(nullptr, size, _writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+			_data = data == MAP_FAILED ? nullptr : data;
+		}
+		// The mapping keeps the file alive.
+		close(file);
+#endif
+		_size = _data ? size : 0;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	void MappedFile::Close()
+	{
+		if (!_data)
+			return;
+#ifdef _WIN32
+		UnmapViewOfFile(_data);
+#else
+		munmap(_data, _size);
+#endif
+		_data = nullptr;
+		_size = 0;
+	}
+
+	bool MappedFile::Flush()
+	{
+		if (!_data || !_writable)
+			return false;
+#ifdef _WIN32
+		return FlushViewOfFile(_data, _size) != 0;
+#else
+		return msync(_data, _size, MS_SYNC) == 0;
+#endif
+	}
+
+	bool MappedFile::IsOpen() const
+	{
+		return _data != nullptr;
+	}
+
+	bool MappedFile::IsWritable() const
+	{
+		return _data != nullptr && _writable;
+	}
+
+	void* MappedFile::GetData() const
+	{
+		return _data;
+	}
+
+	size_t MappedFile::GetSize() const
+	{
+		return _size;
+	}
+}
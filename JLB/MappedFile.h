@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+
+namespace jlb
+{
+	enum class MapMode
+	{
+		// Maps an existing file read-only. The pages are shared with every other process that maps the file.
+		Read,
+		// Maps an existing file, changes are written back to the file.
+		ReadWrite,
+		// Creates or overwrites a file of the given size, and maps it like ReadWrite.
+		Create
+	};
+
+	/// <summary>
+	/// Maps a file into memory, so that its contents can be used directly without reading them first.<br>
+	/// The mapping is removed when the object is destroyed.
+	/// </summary>
+	class MappedFile final
+	{
+	public:
+		/// <summary>
+		/// Maps a file into memory. Check IsOpen to see if it succeeded.
+		/// </summary>
+		/// <param name="path">Path of the file.</param>
+		/// <param name="mode">How to open the file.</param>
+		/// <param name="size">Size of the file when creating it, otherwise the whole file is mapped.</param>
+		MappedFile(const char* path, MapMode mode, size_t size = 0);
+		~MappedFile();
+
+		MappedFile(MappedFile& other) = delete;
+		MappedFile(MappedFile&& other) = delete;
+		MappedFile& operator=(MappedFile& other) = delete;
+		MappedFile& operator=(MappedFile&& other) = delete;
+
+		/// <summary>
+		/// Removes the mapping. Unsaved changes are still written back to the file by the operating system.
+		/// </summary>
+		void Close();
+		/// <summary>
+		/// Writes changed pages back to the file.
+		/// </summary>
+		/// <returns>False if the file is not writable or if writing failed.</returns>
+		bool Flush();
+
+		/// <summary>
+		/// Checks if the file has been mapped successfully.
+		/// </summary>
+		[[nodiscard]] bool IsOpen() const;
+		/// <summary>
+		/// Checks if the mapping can be written to.
+		/// </summary>
+		[[nodiscard]] bool IsWritable() const;
+		/// <summary>
+		/// Gets the start of the mapped memory, which is aligned to the page size.
+		/// </summary>
+		[[nodiscard]] void* GetData() const;
+		/// <summary>
+		/// Gets the size of the mapped memory.
+		/// </summary>
+		[[nodiscard]] size_t GetSize() const;
+
+	private:
+		void* _data = nullptr;
+		size_t _size = 0;
+		bool _writable = false;
+	};
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+#include "LinearAllocator.h"
+#include "Iterator.h"
+#include "Kernels.h"
+#include "OffsetPtr.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Array that refers to its memory with an offset instead of a pointer, and has no virtual methods.<br>
+	/// When the array and its memory are allocated from the same block, like a MappedArena, the block can be loaded at any address.<br>
+	/// Does not have ownership over the memory that it uses.
+	/// </summary>
+	template <typename T>
+	class OffsetArray final
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Values have to stay valid when the memory is loaded elsewhere.");
+
+	public:
+		OffsetArray() = default;
+		OffsetArray(OffsetArray& other) = delete;
+		OffsetArray(OffsetArray&& other) = delete;
+		OffsetArray& operator=(OffsetArray& other) = delete;
+		OffsetArray& operator=(OffsetArray&& other) = delete;
+
+		/// <summary>
+		/// Allocates a chunk of memory to be managed.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="length">Length of the array.</param>
+		/// <param name="fillValue">The array will be initialized with this value.</param>
+		void Allocate(LinearAllocator& allocator, size_t length, const T& fillValue = {});
+		/// <summary>
+		/// Allocates a chunk of memory to be managed.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="length">Length of the array.</param>
+		/// <param name="src">The data to copy into the array.</param>
+		void Allocate(LinearAllocator& allocator, size_t length, const T* src);
+		/// <summary>
+		/// Frees the array from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		[[nodiscard]] T& operator[](size_t index);
+		[[nodiscard]] const T& operator[](size_t index) const;
+		[[nodiscard]] size_t GetLength() const;
+		[[nodiscard]] T* GetData();
+		[[nodiscard]] const T* GetData() const;
+
+		[[nodiscard]] Iterator<T> begin();
+		[[nodiscard]] Iterator<T> end();
+		[[nodiscard]] Iterator<const T> begin() const;
+		[[nodiscard]] Iterator<const T> end() const;
+
+	private:
+		OffsetPtr<T> _memory{};
+		size_t _length = 0;
+	};
+
+	template <typename T>
+	void OffsetArray<T>::Allocate(LinearAllocator& allocator, const size_t length, const T& fillValue)
+	{
+		_memory = allocator.New<T>(length);
+		_length = length;
+		Fill(_memory.Get(), length, fillValue);
+	}
+
+	template <typename T>
+	void OffsetArray<T>::Allocate(LinearAllocator& allocator, const size_t length, const T* src)
+	{
+		_memory = allocator.New<T>(length);
+		_length = length;
+		memcpy(_memory.Get(), src, length * sizeof(T));
+	}
+
+	template <typename T>
+	void OffsetArray<T>::Free(LinearAllocator& allocator)
+	{
+		allocator.Free();
+		_memory = nullptr;
+		_length = 0;
+	}
+
+	template <typename T>
+	T& OffsetArray<T>::operator[](const size_t index)
+	{
+		assert(index < _length);
+		return _memory[index];
+	}
+
+	template <typename T>
+	const T& OffsetArray<T>::operator[](const size_t index) const
+	{
+		assert(index < _length);
+		return _memory[index];
+	}
+
+	template <typename T>
+	size_t OffsetArray<T>::GetLength() const
+	{
+		return _length;
+	}
+
+	template <typename T>
+	T* OffsetArray<T>::GetData()
+	{
+		return _memory.Get();
+	}
+
+	template <typename T>
+	const T* OffsetArray<T>::GetData() const
+	{
+		return _memory.Get();
+	}
+
+	template <typename T>
+	Iterator<T> OffsetArray<T>::begin()
+	{
+		return Iterator<T>(_memory.Get());
+	}
+
+	template <typename T>
+	Iterator<T> OffsetArray<T>::end()
+	{
+		return Iterator<T>(_memory.Get() + _length);
+	}
+
+	template <typename T>
+	Iterator<const T> OffsetArray<T>::begin() const
+	{
+		return Iterator<const T>(_memory.Get());
+	}
+
+	template <typename T>
+	Iterator<const T> OffsetArray<T>::end() const
+	{
+		return Iterator<const T>(_memory.Get() + _length);
+	}
+}
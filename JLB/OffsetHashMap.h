@@ -0,0 +1,219 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include "KeyPair.h"
+#include "OffsetArray.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Hash set that can be stored in a memory mapped file, and used from any address it is mapped at.<br>
+	/// Unlike HashMap it has no function pointer or virtual methods, so the hasher is a type instead.<br>
+	/// All lookups are const, so they also work on read-only mappings.<br>
+	/// Does not have ownership over the memory that it uses, and does not resize the capacity automatically.
+	/// </summary>
+	/// <typeparam name="T">Trivially copyable value type, compared with operator==.</typeparam>
+	/// <typeparam name="Hasher">Default constructible type with size_t operator()(const T&amp;) const.</typeparam>
+	template <typename T, typename Hasher>
+	class OffsetHashMap final
+	{
+	public:
+		OffsetHashMap() = default;
+		OffsetHashMap(OffsetHashMap& other) = delete;
+		OffsetHashMap(OffsetHashMap&& other) = delete;
+		OffsetHashMap& operator=(OffsetHashMap& other) = delete;
+		OffsetHashMap& operator=(OffsetHashMap&& other) = delete;
+
+		/// <summary>
+		/// Allocates the slots of the map.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="size">Amount of slots. One slot always stays empty.</param>
+		void Allocate(LinearAllocator& allocator, size_t size);
+		/// <summary>
+		/// Frees the map from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Inserts a value into the map. Does not store duplicates.
+		/// </summary>
+		/// <param name="value">Value to be inserted.</param>
+		/// <returns>False if the value was already in the map.</returns>
+		bool Insert(const T& value);
+		/// <summary>
+		/// Remove by value.
+		/// </summary>
+		/// <param name="value">Value to be removed.</param>
+		/// <returns>If the value was in the map.</returns>
+		bool Erase(const T& value);
+		/// <summary>
+		/// Removes all values.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Finds the stored version of a value.
+		/// </summary>
+		/// <param name="value">Value to search for.</param>
+		/// <returns>Pointer to the stored value, or nullptr if the map does not contain it.</returns>
+		[[nodiscard]] const T* Find(const T& value) const;
+		/// <summary>
+		/// Checks if the map contains a certain value.
+		/// </summary>
+		/// <param name="value">Value to be checked.</param>
+		/// <returns>If the map contains the value.</returns>
+		[[nodiscard]] bool Contains(const T& value) const;
+
+		/// <summary>
+		/// Gets the amount of values in the map.
+		/// </summary>
+		/// <returns>Amount of values in the map.</returns>
+		[[nodiscard]] size_t GetCount() const;
+		/// <summary>
+		/// Gets the amount of slots in the map.
+		/// </summary>
+		/// <returns>Amount of slots in the map.</returns>
+		[[nodiscard]] size_t GetLength() const;
+
+		[[nodiscard]] Iterator<const KeyPair<T>> begin() const;
+		[[nodiscard]] Iterator<const KeyPair<T>> end() const;
+
+	private:
+		// Slots store the home slot of their value as the key, or SIZE_MAX when empty.
+		OffsetArray<KeyPair<T>> _slots{};
+		size_t _count = 0;
+
+		[[nodiscard]] size_t GetHome(const T& value) const;
+		[[nodiscard]] size_t FindIndex(const T& value) const;
+	};
+
+	template <typename T, typename Hasher>
+	void OffsetHashMap<T, Hasher>::Allocate(LinearAllocator& allocator, const size_t size)
+	{
+		assert(size > 1);
+		_slots.Allocate(allocator, size);
+		_count = 0;
+	}
+
+	template <typename T, typename Hasher>
+	void OffsetHashMap<T, Hasher>::Free(LinearAllocator& allocator)
+	{
+		_slots.Free(allocator);
+		_count = 0;
+	}
+
+	template <typename T, typename Hasher>
+	bool OffsetHashMap<T, Hasher>::Insert(const T& value)
+	{
+		const size_t length = _slots.GetLength();
+		assert(_count + 1 < length);
+
+		const size_t home = GetHome(value);
+		size_t index = home;
+		while (_slots[index].key != SIZE_MAX)
+		{
+			if (_slots[index].key == home && _slots[index].value == value)
+				return false;
+			index = index + 1 == length ? 0 : index + 1;
+		}
+
+		_slots[index].key = home;
+		_slots[index].value = value;
+		++_count;
+		return true;
+	}
+
+	template <typename T, typename Hasher>
+	bool OffsetHashMap<T, Hasher>::Erase(const T& value)
+	{
+		size_t index = FindIndex(value);
+		if (index == SIZE_MAX)
+			return false;
+
+		// Shift the values that come after it back, so that no lookup stops early at the gap.
+		const size_t length = _slots.GetLength();
+		size_t next = index + 1 == length ? 0 : index + 1;
+		while (_slots[next].key != SIZE_MAX)
+		{
+			// A value can only move back if that does not put it in front of its home slot.
+			const size_t home = _slots[next].key;
+			if ((next + length - home) % length >= (next + length - index) % length)
+			{
+				_slots[index] = _slots[next];
+				index = next;
+			}
+			next = next + 1 == length ? 0 : next + 1;
+		}
+
+		_slots[index] = {};
+		--_count;
+		return true;
+	}
+
+	template <typename T, typename Hasher>
+	void OffsetHashMap<T, Hasher>::Clear()
+	{
+		Fill(_slots.GetData(), _slots.GetLength(), KeyPair<T>{});
+		_count = 0;
+	}
+
+	template <typename T, typename Hasher>
+	const T* OffsetHashMap<T, Hasher>::Find(const T& value) const
+	{
+		const size_t index = FindIndex(value);
+		return index == SIZE_MAX ? nullptr : &_slots[index].value;
+	}
+
+	template <typename T, typename Hasher>
+	bool OffsetHashMap<T, Hasher>::Contains(const T& value) const
+	{
+		return FindIndex(value) != SIZE_MAX;
+	}
+
+	template <typename T, typename Hasher>
+	size_t OffsetHashMap<T, Hasher>::GetCount() const
+	{
+		return _count;
+	}
+
+	template <typename T, typename Hasher>
+	size_t OffsetHashMap<T, Hasher>::GetLength() const
+	{
+		return _slots.GetLength();
+	}
+
+	template <typename T, typename Hasher>
+	Iterator<const KeyPair<T>> OffsetHashMap<T, Hasher>::begin() const
+	{
+		return _slots.begin();
+	}
+
+	template <typename T, typename Hasher>
+	Iterator<const KeyPair<T>> OffsetHashMap<T, Hasher>::end() const
+	{
+		return _slots.end();
+	}
+
+	template <typename T, typename Hasher>
+	size_t OffsetHashMap<T, Hasher>::GetHome(const T& value) const
+	{
+		return Hasher{}(value) % _slots.GetLength();
+	}
+
+	template <typename T, typename Hasher>
+	size_t OffsetHashMap<T, Hasher>::FindIndex(const T& value) const
+	{
+		const size_t length = _slots.GetLength();
+		if (length == 0)
+			return SIZE_MAX;
+
+		// Values are never more than one cluster away from their home slot, so an empty slot ends the search.
+		const size_t home = GetHome(value);
+		for (size_t index = home; _slots[index].key != SIZE_MAX; index = index + 1 == length ? 0 : index + 1)
+			if (_slots[index].key == home && _slots[index].value == value)
+				return index;
+		return SIZE_MAX;
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace jlb
+{
+	/// <summary>
+	/// Pointer that stores the distance to its target instead of the address.<br>
+	/// As long as the pointer and its target are in the same block of memory, it stays valid wherever that block is loaded,
+	/// like a memory mapped file that is mapped at a different address in every process.<br>
+	/// An offset of zero is used for nullptr, so it cannot point to itself.
+	/// </summary>
+	template <typename T>
+	class OffsetPtr final
+	{
+	public:
+		OffsetPtr() = default;
+		// Copies the target, not the offset.
+		OffsetPtr(const OffsetPtr& other);
+		OffsetPtr(T* ptr);
+
+		OffsetPtr& operator=(const OffsetPtr& other);
+		OffsetPtr& operator=(T* ptr);
+
+		/// <summary>
+		/// Gets the address of the target, based on where the pointer currently is in memory.
+		/// </summary>
+		/// <returns>Address of the target, or nullptr.</returns>
+		[[nodiscard]] T* Get() const;
+
+		[[nodiscard]] T& operator*() const;
+		[[nodiscard]] T* operator->() const;
+		[[nodiscard]] T& operator[](size_t index) const;
+		[[nodiscard]] explicit operator bool() const;
+
+	private:
+		ptrdiff_t _offset = 0;
+
+		void Set(T* ptr);
+	};
+
+	template <typename T>
+	OffsetPtr<T>::OffsetPtr(const OffsetPtr& other)
+	{
+		Set(other.Get());
+	}
+
+	template <typename T>
+	OffsetPtr<T>::OffsetPtr(T* ptr)
+	{
+		Set(ptr);
+	}
+
+	template <typename T>
+	OffsetPtr<T>& OffsetPtr<T>::operator=(const OffsetPtr& other)
+	{
+		Set(other.Get());
+		return *this;
+	}
+
+	template <typename T>
+	OffsetPtr<T>& OffsetPtr<T>::operator=(T* ptr)
+	{
+		Set(ptr);
+		return *this;
+	}
+
+	template <typename T>
+	T* OffsetPtr<T>::Get() const
+	{
+		if (_offset == 0)
+			return nullptr;
+		return reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(this) + _offset);
+	}
+
+	template <typename T>
+	T& OffsetPtr<T>::operator*() const
+	{
+		return *Get();
+	}
+
+	template <typename T>
+	T* OffsetPtr<T>::operator->() const
+	{
+		return Get();
+	}
+
+	template <typename T>
+	T& OffsetPtr<T>::operator[](const size_t index) const
+	{
+		return Get()[index];
+	}
+
+	template <typename T>
+	OffsetPtr<T>::operator bool() const
+	{
+		return _offset != 0;
+	}
+
+	template <typename T>
+	void OffsetPtr<T>::Set(T* ptr)
+	{
+		// Unsigned arithmetic wraps around, which gives the right signed distance in both directions.
+		_offset = ptr ? static_cast<ptrdiff_t>(reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(this)) : 0;
+	}
+}
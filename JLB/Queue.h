@@ -0,0 +1,125 @@
+#pragma once
+#include "Array.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Data container that operates on a first-in-first-out basis.<br>
+	/// Uses the managed memory as a ring buffer, so it does not resize the capacity automatically.<br>
+	/// Not thread safe, see SPSCQueue and MPMCQueue for that.
+	/// </summary>
+	template <typename T>
+	class Queue : public Array<T>
+	{
+	public:
+		/// <summary>
+		/// Add the value to the back of the queue.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <param name="value">Value to be added.</param>
+		/// <returns>The added value inside the queue.</returns>
+		T& Enqueue(T& value);
+		/// <summary>
+		/// Add the value to the back of the queue.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <param name="value">Value to be added.</param>
+		/// <returns>The added value inside the queue.</returns>
+		T& Enqueue(T&& value = {});
+		/// <summary>
+		/// Look at the front value of the queue.
+		/// </summary>
+		/// <returns>Front value of the queue.</returns>
+		[[nodiscard]] T& Peek();
+		/// <summary>
+		/// Get and remove the front value of the queue.
+		/// </summary>
+		/// <returns>Front value of the queue.</returns>
+		T Dequeue();
+		/// <summary>
+		/// Sets the count to zero.
+		/// </summary>
+		void Clear();
+		/// <summary>
+		/// Gets the amount of values in the queue.
+		/// </summary>
+		/// <returns>Amount of values in the queue.</returns>
+		[[nodiscard]] size_t GetCount() const;
+
+	private:
+		// Index of the front value in the managed memory.
+		size_t _front = 0;
+		size_t _count = 0;
+
+		T& operator[](size_t index) override;
+		Iterator<T> begin() override;
+		Iterator<T> end() override;
+	};
+
+	template <typename T>
+	T& Queue<T>::Enqueue(T& value)
+	{
+		const size_t length = Array<T>::GetLength();
+		assert(_count < length);
+		// Wrap around to the start of the managed memory. Both are below the length, so a single subtraction is enough.
+		size_t index = _front + _count++;
+		if (index >= length)
+			index -= length;
+		return Array<T>::operator[](index) = value;
+	}
+
+	template <typename T>
+	T& Queue<T>::Enqueue(T&& value)
+	{
+		return Enqueue(value);
+	}
+
+	template <typename T>
+	T& Queue<T>::Peek()
+	{
+		assert(_count > 0);
+		return Array<T>::operator[](_front);
+	}
+
+	template <typename T>
+	T Queue<T>::Dequeue()
+	{
+		assert(_count > 0);
+		const T value = Array<T>::operator[](_front);
+		if (++_front == Array<T>::GetLength())
+			_front = 0;
+		--_count;
+		return value;
+	}
+
+	template <typename T>
+	void Queue<T>::Clear()
+	{
+		_front = 0;
+		_count = 0;
+	}
+
+	template <typename T>
+	size_t Queue<T>::GetCount() const
+	{
+		return _count;
+	}
+
+	template <typename T>
+	T& Queue<T>::operator[](const size_t index)
+	{
+		return Array<T>::operator[](index);
+	}
+
+	template <typename T>
+	Iterator<T> Queue<T>::begin()
+	{
+		return Array<T>::begin();
+	}
+
+	template <typename T>
+	Iterator<T> Queue<T>::end()
+	{
+		return Array<T>::end();
+	}
+}
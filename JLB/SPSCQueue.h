@@ -0,0 +1,226 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+#include "LinearAllocator.h"
+#include "CacheLine.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Bounded first-in-first-out queue for handing values from exactly one producer thread to exactly one consumer thread.<br>
+	/// Wait-free: every operation finishes in a fixed amount of steps, and fails instead of blocking when the queue is full or empty.<br>
+	/// The producer and consumer indices live on separate cache lines to prevent false sharing.
+	/// </summary>
+	template <typename T>
+	class SPSCQueue final
+	{
+	public:
+		SPSCQueue() = default;
+		SPSCQueue(SPSCQueue& other) = delete;
+		SPSCQueue(SPSCQueue&& other) = delete;
+		SPSCQueue& operator=(SPSCQueue& other) = delete;
+		SPSCQueue& operator=(SPSCQueue&& other) = delete;
+
+		/// <summary>
+		/// Allocates the ring buffer. Not thread safe.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="capacity">Minimum capacity of the queue. Will be rounded up to a power of two.</param>
+		void Allocate(LinearAllocator& allocator, size_t capacity);
+		/// <summary>
+		/// Frees the ring buffer from the linear allocator. Not thread safe.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Add a value to the back of the queue. Producer thread only.
+		/// </summary>
+		/// <param name="value">Value to be added.</param>
+		/// <returns>False if the queue is full.</returns>
+		[[nodiscard]] bool TryEnqueue(const T& value);
+		/// <summary>
+		/// Add as many values as possible to the back of the queue, and publishes them all at once. Producer thread only.
+		/// </summary>
+		/// <param name="src">Values to be added.</param>
+		/// <param name="count">Amount of values to be added.</param>
+		/// <returns>Amount of values that have been added.</returns>
+		size_t TryEnqueue(const T* src, size_t count);
+		/// <summary>
+		/// Get and remove the front value of the queue. Consumer thread only.
+		/// </summary>
+		/// <param name="outValue">Front value of the queue.</param>
+		/// <returns>False if the queue is empty.</returns>
+		[[nodiscard]] bool TryDequeue(T& outValue);
+		/// <summary>
+		/// Get and remove as many values as possible from the front of the queue. Consumer thread only.
+		/// </summary>
+		/// <param name="dst">Destination for the removed values.</param>
+		/// <param name="count">Maximum amount of values to be removed.</param>
+		/// <returns>Amount of values that have been removed.</returns>
+		size_t TryDequeue(T* dst, size_t count);
+
+		/// <summary>
+		/// Gets the amount of values in the queue.<br>
+		/// Only an estimate when called while the other thread is modifying the queue.
+		/// </summary>
+		/// <returns>Amount of values in the queue.</returns>
+		[[nodiscard]] size_t GetCount() const;
+		/// <summary>
+		/// Gets the maximum amount of values the queue can hold.
+		/// </summary>
+		/// <returns>Capacity of the queue.</returns>
+		[[nodiscard]] size_t GetCapacity() const;
+
+	private:
+		// Shared, but only written to during allocation.
+		T* _memory = nullptr;
+		size_t _mask = 0;
+
+		// Written to by the consumer.
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head{ 0 };
+		// Last known tail, to avoid touching the producer's cache line on every dequeue.
+		size_t _tailCache = 0;
+
+		// Written to by the producer.
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail{ 0 };
+		// Last known head, to avoid touching the consumer's cache line on every enqueue.
+		size_t _headCache = 0;
+
+		void Copy(T* dst, const T* src, size_t count);
+	};
+
+	template <typename T>
+	void SPSCQueue<T>::Allocate(LinearAllocator& allocator, const size_t capacity)
+	{
+		assert(capacity > 0);
+
+		// Round up to a power of two, so that indices can be wrapped with a mask.
+		size_t length = 1;
+		while (length < capacity)
+			length *= 2;
+
+		_memory = allocator.New<T>(length);
+		_mask = length - 1;
+		_head.store(0, std::memory_order_relaxed);
+		_tail.store(0, std::memory_order_relaxed);
+		_tailCache = 0;
+		_headCache = 0;
+	}
+
+	template <typename T>
+	void SPSCQueue<T>::Free(LinearAllocator& allocator)
+	{
+		allocator.Free();
+	}
+
+	template <typename T>
+	bool SPSCQueue<T>::TryEnqueue(const T& value)
+	{
+		const size_t tail = _tail.load(std::memory_order_relaxed);
+
+		// Only reload the head if the queue seems to be full.
+		if (tail - _headCache > _mask)
+		{
+			_headCache = _head.load(std::memory_order_acquire);
+			if (tail - _headCache > _mask)
+				return false;
+		}
+
+		_memory[tail & _mask] = value;
+		_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T>
+	size_t SPSCQueue<T>::TryEnqueue(const T* src, size_t count)
+	{
+		const size_t tail = _tail.load(std::memory_order_relaxed);
+		const size_t capacity = _mask + 1;
+
+		if (capacity - (tail - _headCache) < count)
+			_headCache = _head.load(std::memory_order_acquire);
+		const size_t space = capacity - (tail - _headCache);
+		count = count < space ? count : space;
+		if (count == 0)
+			return 0;
+
+		// Copy in up to two parts, since the range can wrap around the end of the ring buffer.
+		const size_t start = tail & _mask;
+		const size_t first = capacity - start < count ? capacity - start : count;
+		Copy(&_memory[start], src, first);
+		Copy(_memory, &src[first], count - first);
+
+		_tail.store(tail + count, std::memory_order_release);
+		return count;
+	}
+
+	template <typename T>
+	bool SPSCQueue<T>::TryDequeue(T& outValue)
+	{
+		const size_t head = _head.load(std::memory_order_relaxed);
+
+		// Only reload the tail if the queue seems to be empty.
+		if (head == _tailCache)
+		{
+			_tailCache = _tail.load(std::memory_order_acquire);
+			if (head == _tailCache)
+				return false;
+		}
+
+		outValue = _memory[head & _mask];
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T>
+	size_t SPSCQueue<T>::TryDequeue(T* dst, size_t count)
+	{
+		const size_t head = _head.load(std::memory_order_relaxed);
+		const size_t capacity = _mask + 1;
+
+		if (_tailCache - head < count)
+			_tailCache = _tail.load(std::memory_order_acquire);
+		const size_t available = _tailCache - head;
+		count = count < available ? count : available;
+		if (count == 0)
+			return 0;
+
+		const size_t start = head & _mask;
+		const size_t first = capacity - start < count ? capacity - start : count;
+		Copy(dst, &_memory[start], first);
+		Copy(&dst[first], _memory, count - first);
+
+		_head.store(head + count, std::memory_order_release);
+		return count;
+	}
+
+	template <typename T>
+	size_t SPSCQueue<T>::GetCount() const
+	{
+		// Load the head first, since the tail can never fall behind it.
+		const size_t head = _head.load(std::memory_order_acquire);
+		return _tail.load(std::memory_order_acquire) - head;
+	}
+
+	template <typename T>
+	size_t SPSCQueue<T>::GetCapacity() const
+	{
+		return _mask + 1;
+	}
+
+	template <typename T>
+	void SPSCQueue<T>::Copy(T* dst, const T* src, const size_t count)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (count > 0)
+				memcpy(dst, src, count * sizeof(T));
+		}
+		else
+			for (size_t i = 0; i < count; ++i)
+				dst[i] = src[i];
+	}
+}
@@ -0,0 +1,152 @@
+#include "Scheduler.h"
+#include <memory>
+#include <new>
+
+namespace jlb
+{
+	Scheduler::Worker::Worker(const size_t scratchSize) : scratch(scratchSize)
+	{
+
+	}
+
+	void Scheduler::Allocate(LinearAllocator& allocator, const size_t workerCount, const size_t scratchSize, const size_t capacity)
+	{
+		assert(workerCount > 0);
+		assert(!_workers);
+
+		// The linear allocator only aligns to sizeof(size_t), so align the workers to their cache lines manually.
+		size_t space = sizeof(Worker) * workerCount + alignof(Worker);
+		void* memory = allocator.Malloc(space);
+		_workers = static_cast<Worker*>(std::align(alignof(Worker), sizeof(Worker) * workerCount, memory, space));
+		_workerCount = workerCount;
+
+		for (size_t i = 0; i < workerCount; ++i)
+		{
+			new (&_workers[i]) Worker(scratchSize);
+			_workers[i].deque.Allocate(allocator, capacity);
+		}
+
+		// The first worker is the calling thread.
+		_running = true;
+		for (size_t i = 1; i < workerCount; ++i)
+			_workers[i].thread = std::thread(&Scheduler::WorkerLoop, this, i);
+	}
+
+	void Scheduler::Free(LinearAllocator& allocator)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_running = false;
+		}
+		_wake.notify_all();
+
+		for (size_t i = 1; i < _workerCount; ++i)
+			_workers[i].thread.join();
+
+		// Free in the reverse order of allocation.
+		for (size_t i = _workerCount; i > 0; --i)
+		{
+			_workers[i - 1].deque.Free(allocator);
+			_workers[i - 1].~Worker();
+		}
+		allocator.Free();
+
+		_workers = nullptr;
+		_workerCount = 0;
+	}
+
+	size_t Scheduler::GetWorkerCount() const
+	{
+		return _workerCount;
+	}
+
+	void Scheduler::Run(const Job& job)
+	{
+		assert(_workers);
+		if (job.begin >= job.end)
+			return;
+
+		_remaining.store(job.end - job.begin, std::memory_order_relaxed);
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_active = true;
+		}
+		_wake.notify_all();
+
+		// Help out until every index has been processed.
+		Execute(job, 0);
+		while (_remaining.load(std::memory_order_acquire) > 0)
+		{
+			Job other;
+			if (TryGetJob(0, other))
+				Execute(other, 0);
+			else
+				std::this_thread::yield();
+		}
+
+		_active = false;
+	}
+
+	void Scheduler::Execute(Job job, const size_t workerIndex)
+	{
+		auto& worker = _workers[workerIndex];
+
+		// Keep splitting the range, leaving the second half to be stolen by other workers.
+		// A single index cannot be split, so a grain size of 0 behaves like 1.
+		const size_t grainSize = job.grainSize > 0 ? job.grainSize : 1;
+		while (job.end - job.begin > grainSize)
+		{
+			Job other = job;
+			other.begin = job.begin + (job.end - job.begin) / 2;
+			// If the deque is full, simply process the rest of the range on this worker.
+			if (!worker.deque.Push(other))
+				break;
+			job.end = other.begin;
+		}
+
+		job.function(job.userData, job.begin, job.end, worker.scratch);
+		_remaining.fetch_sub(job.end - job.begin, std::memory_order_release);
+	}
+
+	bool Scheduler::TryGetJob(const size_t workerIndex, Job& outJob)
+	{
+		if (_workers[workerIndex].deque.Pop(outJob))
+			return true;
+
+		// Try to steal from the other workers, starting with the next one to spread out the contention.
+		for (size_t i = 1; i < _workerCount; ++i)
+		{
+			const size_t victim = (workerIndex + i) % _workerCount;
+			if (_workers[victim].deque.Steal(outJob))
+				return true;
+		}
+
+		return false;
+	}
+
+	void Scheduler::WorkerLoop(const size_t workerIndex)
+	{
+		while (_running)
+		{
+			Job job;
+			if (TryGetJob(workerIndex, job))
+			{
+				Execute(job, workerIndex);
+				continue;
+			}
+
+			if (_active)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Sleep until the next loop starts.
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [this]
+			{
+				return _active || !_running;
+			});
+		}
+	}
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Array.h"
+#include "WorkStealingDeque.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Thread pool that runs parallel loops using one work-stealing deque per worker.<br>
+	/// Loop ranges are split in halves; a worker keeps one half and leaves the other for idle workers to steal,
+	/// so there is no central queue that all threads have to contend on.<br>
+	/// Every worker has its own scratch allocator for temporary allocations.
+	/// </summary>
+	class Scheduler final
+	{
+	public:
+		Scheduler() = default;
+		Scheduler(Scheduler& other) = delete;
+		Scheduler(Scheduler&& other) = delete;
+		Scheduler& operator=(Scheduler& other) = delete;
+		Scheduler& operator=(Scheduler&& other) = delete;
+
+		/// <summary>
+		/// Allocates the workers and starts their threads.<br>
+		/// The calling thread counts as the first worker, and is the only thread allowed to start parallel loops.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="workerCount">Amount of workers, including the calling thread.</param>
+		/// <param name="scratchSize">Size of the scratch allocator of each worker.</param>
+		/// <param name="capacity">Maximum amount of pending jobs per worker.</param>
+		void Allocate(LinearAllocator& allocator, size_t workerCount, size_t scratchSize, size_t capacity = 256);
+		/// <summary>
+		/// Stops the worker threads and frees the workers from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Calls the function for every value in the range, spread out over all the workers.<br>
+		/// Blocks until all values have been processed.
+		/// </summary>
+		/// <param name="array">Array to iterate over.</param>
+		/// <param name="begin">Index of the first value.</param>
+		/// <param name="end">Index after the last value.</param>
+		/// <param name="function">Called as function(T&amp; value, LinearAllocator&amp; scratch).<br>
+		/// Everything allocated from the scratch allocator has to be freed before returning.</param>
+		/// <param name="grainSize">Amount of values below which a range will no longer be split. A range is never split below a single index.</param>
+		template <typename T, typename Function>
+		void ParallelFor(Array<T>& array, size_t begin, size_t end, Function function, size_t grainSize = 64);
+		/// <summary>
+		/// Calls the function for every index in the range, spread out over all the workers.<br>
+		/// Blocks until all indices have been processed.
+		/// </summary>
+		/// <param name="begin">First index.</param>
+		/// <param name="end">Index after the last index.</param>
+		/// <param name="function">Called as function(size_t index, LinearAllocator&amp; scratch).<br>
+		/// Everything allocated from the scratch allocator has to be freed before returning.</param>
+		/// <param name="grainSize">Amount of indices below which a range will no longer be split. A range is never split below a single index.</param>
+		template <typename Function>
+		void ParallelFor(size_t begin, size_t end, Function function, size_t grainSize = 64);
+
+		/// <summary>
+		/// Gets the amount of workers, including the thread that allocated the scheduler.
+		/// </summary>
+		/// <returns>Amount of workers.</returns>
+		[[nodiscard]] size_t GetWorkerCount() const;
+
+	private:
+		struct Job final
+		{
+			// Function that processes the indices in the range [begin, end).
+			void(*function)(void* userData, size_t begin, size_t end, LinearAllocator& scratch);
+			void* userData;
+			size_t begin;
+			size_t end;
+			size_t grainSize;
+		};
+
+		struct Worker final
+		{
+			WorkStealingDeque<Job> deque{};
+			LinearAllocator scratch;
+			std::thread thread{};
+
+			explicit Worker(size_t scratchSize);
+		};
+
+		Worker* _workers = nullptr;
+		size_t _workerCount = 0;
+
+		// Amount of indices that still have to be processed in the current loop.
+		std::atomic<size_t> _remaining{ 0 };
+		// If a loop is running. Idle workers sleep when there is none.
+		std::atomic<bool> _active{ false };
+		std::atomic<bool> _running{ false };
+		std::mutex _mutex{};
+		std::condition_variable _wake{};
+
+		void Run(const Job& job);
+		void Execute(Job job, size_t workerIndex);
+		[[nodiscard]] bool TryGetJob(size_t workerIndex, Job& outJob);
+		void WorkerLoop(size_t workerIndex);
+	};
+
+	template <typename T, typename Function>
+	void Scheduler::ParallelFor(Array<T>& array, const size_t begin, const size_t end, Function function, const size_t grainSize)
+	{
+		assert(end <= array.GetLength());
+
+		struct Data final
+		{
+			T* memory;
+			Function* function;
+		} data{ array.GetData(), &function };
+
+		Job job{};
+		job.function = [](void* userData, const size_t from, const size_t to, LinearAllocator& scratch)
+		{
+			const auto& data = *static_cast<Data*>(userData);
+			for (size_t i = from; i < to; ++i)
+				(*data.function)(data.memory[i], scratch);
+		};
+		job.userData = &data;
+		job.begin = begin;
+		job.end = end;
+		job.grainSize = grainSize;
+		Run(job);
+	}
+
+	template <typename Function>
+	void Scheduler::ParallelFor(const size_t begin, const size_t end, Function function, const size_t grainSize)
+	{
+		Job job{};
+		job.function = [](void* userData, const size_t from, const size_t to, LinearAllocator& scratch)
+		{
+			auto& function = *static_cast<Function*>(userData);
+			for (size_t i = from; i < to; ++i)
+				function(i, scratch);
+		};
+		job.userData = &function;
+		job.begin = begin;
+		job.end = end;
+		job.grainSize = grainSize;
+		Run(job);
+	}
+}
@@ -0,0 +1,94 @@
+#include "Snapshot.h"
+
+namespace jlb
+{
+	namespace
+	{
+		// Larger than the default stdio buffer, while large container reads bypass it and go straight into their memory.
+		constexpr size_t BUFFER_SIZE = 1 << 16;
+
+		struct FileHeader final
+		{
+			uint32_t magic;
+			uint32_t formatVersion;
+			uint32_t version;
+			uint32_t reserved;
+		};
+
+		FILE* OpenFile(const char* path, const char* mode)
+		{
+			FILE* file = fopen(path, mode);
+			if (file)
+				setvbuf(file, nullptr, _IOFBF, BUFFER_SIZE);
+			return file;
+		}
+	}
+
+	SnapshotWriter::SnapshotWriter(const char* path, const uint32_t version) :
+		_file(OpenFile(path, "wb"))
+	{
+		_failed = !_file;
+		WriteValue(FileHeader{ snapshotImpl::MAGIC, snapshotImpl::FORMAT_VERSION, version, 0 });
+	}
+
+	SnapshotWriter::~SnapshotWriter()
+	{
+		Close();
+	}
+
+	bool SnapshotWriter::Close()
+	{
+		if (_file)
+		{
+			_failed |= fclose(_file) != 0;
+			_file = nullptr;
+		}
+		return !_failed;
+	}
+
+	void SnapshotWriter::WriteBytes(const void* data, const size_t size)
+	{
+		if (_failed || size == 0)
+			return;
+		_failed = fwrite(data, 1, size, _file) != size;
+	}
+
+	bool SnapshotWriter::HasFailed() const
+	{
+		return _failed;
+	}
+
+	SnapshotReader::SnapshotReader(const char* path) :
+		_file(OpenFile(path, "rb"))
+	{
+		_failed = !_file;
+		FileHeader header{};
+		if (ReadValue(header) && (header.magic != snapshotImpl::MAGIC || header.formatVersion != snapshotImpl::FORMAT_VERSION))
+			_failed = true;
+		_version = header.version;
+	}
+
+	SnapshotReader::~SnapshotReader()
+	{
+		if (_file)
+			fclose(_file);
+	}
+
+	uint32_t SnapshotReader::GetVersion() const
+	{
+		return _version;
+	}
+
+	bool SnapshotReader::ReadBytes(void* data, const size_t size)
+	{
+		if (_failed || size == 0)
+			return !_failed;
+		_failed = fread(data, 1, size, _file) != size;
+		return !_failed;
+	}
+
+	bool SnapshotReader::HasFailed() const
+	{
+		return _failed;
+	}
+}
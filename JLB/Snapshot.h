@@ -0,0 +1,399 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+#include "Vector.h"
+#include "HashMap.h"
+#include "FilteredHashMap.h"
+#include "Heap.h"
+
+namespace jlb
+{
+	class SnapshotWriter;
+	class SnapshotReader;
+
+	/// <summary>
+	/// Specialize this for element types that are not trivially copyable, like types that contain pointers.<br>
+	/// Needs static void Write(SnapshotWriter&amp;, T&amp;) and static bool Read(SnapshotReader&amp;, LinearAllocator&amp;, T&amp;).<br>
+	/// Trivially copyable types are always written as raw bytes, in bulk.
+	/// </summary>
+	template <typename T>
+	struct SnapshotSerializer;
+
+	/// <summary>
+	/// Hash map and heap slots of types that are not trivially copyable store their key as raw bytes.
+	/// </summary>
+	template <typename T>
+	struct SnapshotSerializer<KeyPair<T>> final
+	{
+		static void Write(SnapshotWriter& writer, KeyPair<T>& keyPair);
+		static bool Read(SnapshotReader& reader, LinearAllocator& allocator, KeyPair<T>& keyPair);
+	};
+
+	namespace snapshotImpl
+	{
+		constexpr uint32_t MAGIC = 0x534E424A; // "JBNS"
+		constexpr uint32_t FORMAT_VERSION = 1;
+
+		enum class Kind : uint32_t
+		{
+			Array = 1,
+			Vector,
+			HashMap,
+			Heap
+		};
+
+		// Precedes every container, so that a mismatch is detected before anything is allocated.
+		struct ContainerHeader final
+		{
+			Kind kind;
+			uint32_t elementSize;
+			uint64_t count;
+			uint64_t length;
+		};
+	}
+
+	/// <summary>
+	/// Writes containers to a binary file, which can be read back with a SnapshotReader.<br>
+	/// The file starts with a format version and a user defined version, and every container stores its kind, element size and count.<br>
+	/// Values are written in the byte order and layout of the current platform.
+	/// </summary>
+	class SnapshotWriter final
+	{
+	public:
+		/// <summary>
+		/// Creates or overwrites a snapshot file. Check HasFailed to see if it succeeded.
+		/// </summary>
+		/// <param name="path">Path of the file.</param>
+		/// <param name="version">Version of the data, returned by SnapshotReader::GetVersion.</param>
+		SnapshotWriter(const char* path, uint32_t version);
+		/// <summary>
+		/// Closes the file.
+		/// </summary>
+		~SnapshotWriter();
+
+		SnapshotWriter(SnapshotWriter& other) = delete;
+		SnapshotWriter(SnapshotWriter&& other) = delete;
+		SnapshotWriter& operator=(SnapshotWriter& other) = delete;
+		SnapshotWriter& operator=(SnapshotWriter&& other) = delete;
+
+		/// <summary>
+		/// Writes all remaining data and closes the file.
+		/// </summary>
+		/// <returns>False if anything failed to be written.</returns>
+		bool Close();
+
+		/// <summary>
+		/// Writes raw bytes.
+		/// </summary>
+		void WriteBytes(const void* data, size_t size);
+		/// <summary>
+		/// Writes a single trivially copyable value.
+		/// </summary>
+		template <typename T>
+		void WriteValue(const T& value);
+
+		/// <summary>
+		/// Writes all the values of an array.
+		/// </summary>
+		template <typename T>
+		void Write(Array<T>& array);
+		/// <summary>
+		/// Writes the values and the capacity of a vector.
+		/// </summary>
+		template <typename T>
+		void Write(Vector<T>& vector);
+		/// <summary>
+		/// Writes all the slots of a hash map, so that reading it does not need to rehash. The hasher is not stored.
+		/// </summary>
+		template <typename T>
+		void Write(HashMap<T>& hashMap);
+		/// <summary>
+		/// Writes all the slots of a filtered hash map. The filter is not stored, it is rebuilt when reading.
+		/// </summary>
+		template <typename T>
+		void Write(FilteredHashMap<T>& hashMap);
+		/// <summary>
+		/// Writes the values and the capacity of a heap, in heap order.
+		/// </summary>
+		template <typename T>
+		void Write(Heap<T>& heap);
+
+		/// <summary>
+		/// Checks if any write has failed so far.
+		/// </summary>
+		[[nodiscard]] bool HasFailed() const;
+
+	private:
+		FILE* _file = nullptr;
+		bool _failed = false;
+
+		template <typename T>
+		void WriteContainer(snapshotImpl::Kind kind, T* data, size_t count, size_t length);
+		template <typename T>
+		void WriteValues(T* data, size_t count);
+	};
+
+	/// <summary>
+	/// Reads containers from a file written by a SnapshotWriter, in the same order as they have been written.<br>
+	/// The file is streamed, and the values are read directly into the memory of the containers.
+	/// </summary>
+	class SnapshotReader final
+	{
+	public:
+		/// <summary>
+		/// Opens a snapshot file. Check HasFailed to see if it succeeded.
+		/// </summary>
+		/// <param name="path">Path of the file.</param>
+		explicit SnapshotReader(const char* path);
+		/// <summary>
+		/// Closes the file.
+		/// </summary>
+		~SnapshotReader();
+
+		SnapshotReader(SnapshotReader& other) = delete;
+		SnapshotReader(SnapshotReader&& other) = delete;
+		SnapshotReader& operator=(SnapshotReader& other) = delete;
+		SnapshotReader& operator=(SnapshotReader&& other) = delete;
+
+		/// <summary>
+		/// Gets the version that has been passed to the SnapshotWriter.
+		/// </summary>
+		[[nodiscard]] uint32_t GetVersion() const;
+
+		/// <summary>
+		/// Reads raw bytes.
+		/// </summary>
+		/// <returns>False if the file ended early, or if an earlier read has failed.</returns>
+		bool ReadBytes(void* data, size_t size);
+		/// <summary>
+		/// Reads a single trivially copyable value.
+		/// </summary>
+		template <typename T>
+		bool ReadValue(T& value);
+
+		/// <summary>
+		/// Allocates an array and reads its values.<br>
+		/// If the values could not be read after allocating, the array still has to be freed.
+		/// </summary>
+		/// <returns>False if the next container in the file does not match, or if reading failed.</returns>
+		template <typename T>
+		bool Read(LinearAllocator& allocator, Array<T>& array);
+		/// <summary>
+		/// Allocates a vector with the stored capacity and reads its values.<br>
+		/// If the values could not be read after allocating, the vector still has to be freed.
+		/// </summary>
+		template <typename T>
+		bool Read(LinearAllocator& allocator, Vector<T>& vector);
+		/// <summary>
+		/// Allocates a hash map and reads its slots. The hasher has to be the same as the one used when writing.<br>
+		/// If the values could not be read after allocating, the hash map still has to be freed.
+		/// </summary>
+		template <typename T>
+		bool Read(LinearAllocator& allocator, HashMap<T>& hashMap);
+		/// <summary>
+		/// Allocates a filtered hash map, reads its slots and then fills the filter with the stored values.<br>
+		/// The filter uses the default false positive rate. The hasher has to be set before reading.
+		/// </summary>
+		template <typename T>
+		bool Read(LinearAllocator& allocator, FilteredHashMap<T>& hashMap);
+		/// <summary>
+		/// Allocates a heap with the stored capacity and reads its values.<br>
+		/// If the values could not be read after allocating, the heap still has to be freed.
+		/// </summary>
+		template <typename T>
+		bool Read(LinearAllocator& allocator, Heap<T>& heap);
+
+		/// <summary>
+		/// Checks if the file could not be opened, is not a snapshot, or if any read has failed so far.
+		/// </summary>
+		[[nodiscard]] bool HasFailed() const;
+
+	private:
+		FILE* _file = nullptr;
+		uint32_t _version = 0;
+		bool _failed = false;
+
+		template <typename T>
+		bool ReadContainerHeader(snapshotImpl::Kind kind, snapshotImpl::ContainerHeader& header);
+		template <typename T>
+		bool ReadValues(LinearAllocator& allocator, T* data, size_t count);
+	};
+
+	template <typename T>
+	void SnapshotWriter::WriteValue(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Use SnapshotSerializer for types that are not trivially copyable.");
+		WriteBytes(&value, sizeof(T));
+	}
+
+	template <typename T>
+	void SnapshotWriter::Write(Array<T>& array)
+	{
+		WriteContainer(snapshotImpl::Kind::Array, array.GetData(), array.GetLength(), array.GetLength());
+	}
+
+	template <typename T>
+	void SnapshotWriter::Write(Vector<T>& vector)
+	{
+		WriteContainer(snapshotImpl::Kind::Vector, vector.GetData(), vector.GetCount(), vector.GetLength());
+	}
+
+	template <typename T>
+	void SnapshotWriter::Write(HashMap<T>& hashMap)
+	{
+		WriteContainer(snapshotImpl::Kind::HashMap, hashMap.GetData(), hashMap.GetLength(), hashMap.GetLength());
+	}
+
+	template <typename T>
+	void SnapshotWriter::Write(FilteredHashMap<T>& hashMap)
+	{
+		Write(static_cast<HashMap<T>&>(hashMap));
+	}
+
+	template <typename T>
+	void SnapshotWriter::Write(Heap<T>& heap)
+	{
+		// The root of the heap is at index 1.
+		WriteContainer(snapshotImpl::Kind::Heap, heap.GetData() + 1, heap.GetCount(), heap.GetLength());
+	}
+
+	template <typename T>
+	void SnapshotWriter::WriteContainer(const snapshotImpl::Kind kind, T* data, const size_t count, const size_t length)
+	{
+		const snapshotImpl::ContainerHeader header{ kind, static_cast<uint32_t>(sizeof(T)), count, length };
+		WriteValue(header);
+		WriteValues(data, count);
+	}
+
+	template <typename T>
+	void SnapshotWriter::WriteValues(T* data, const size_t count)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+			WriteBytes(data, sizeof(T) * count);
+		else
+			for (size_t i = 0; i < count; ++i)
+				SnapshotSerializer<T>::Write(*this, data[i]);
+	}
+
+	template <typename T>
+	bool SnapshotReader::ReadValue(T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Use SnapshotSerializer for types that are not trivially copyable.");
+		return ReadBytes(&value, sizeof(T));
+	}
+
+	template <typename T>
+	bool SnapshotReader::Read(LinearAllocator& allocator, Array<T>& array)
+	{
+		snapshotImpl::ContainerHeader header;
+		if (!ReadContainerHeader<T>(snapshotImpl::Kind::Array, header))
+			return false;
+		array.Allocate(allocator, static_cast<size_t>(header.length));
+		return ReadValues(allocator, array.GetData(), static_cast<size_t>(header.count));
+	}
+
+	template <typename T>
+	bool SnapshotReader::Read(LinearAllocator& allocator, Vector<T>& vector)
+	{
+		snapshotImpl::ContainerHeader header;
+		if (!ReadContainerHeader<T>(snapshotImpl::Kind::Vector, header))
+			return false;
+		vector.Allocate(allocator, static_cast<size_t>(header.length));
+		if (!ReadValues(allocator, vector.GetData(), static_cast<size_t>(header.count)))
+			return false;
+		vector.SetCount(static_cast<size_t>(header.count));
+		return true;
+	}
+
+	template <typename T>
+	bool SnapshotReader::Read(LinearAllocator& allocator, HashMap<T>& hashMap)
+	{
+		snapshotImpl::ContainerHeader header;
+		if (!ReadContainerHeader<KeyPair<T>>(snapshotImpl::Kind::HashMap, header))
+			return false;
+		hashMap.Allocate(allocator, static_cast<size_t>(header.length));
+		if (!ReadValues(allocator, hashMap.GetData(), static_cast<size_t>(header.count)))
+			return false;
+
+		size_t count = 0;
+		for (auto& keyPair : static_cast<Array<KeyPair<T>>&>(hashMap))
+			count += keyPair.key != SIZE_MAX;
+		hashMap._count = count;
+		return true;
+	}
+
+	template <typename T>
+	bool SnapshotReader::Read(LinearAllocator& allocator, FilteredHashMap<T>& hashMap)
+	{
+		// Allocating builds the filter over the empty table, so it has to be filled again once the slots are in.
+		if (!Read(allocator, static_cast<HashMap<T>&>(hashMap)))
+			return false;
+		hashMap.RebuildFilter();
+		return true;
+	}
+
+	template <typename T>
+	bool SnapshotReader::Read(LinearAllocator& allocator, Heap<T>& heap)
+	{
+		snapshotImpl::ContainerHeader header;
+		if (!ReadContainerHeader<KeyPair<T>>(snapshotImpl::Kind::Heap, header))
+			return false;
+		if (header.length == 0 || header.count >= header.length)
+		{
+			_failed = true;
+			return false;
+		}
+		heap.Allocate(allocator, static_cast<size_t>(header.length) - 1);
+		if (!ReadValues(allocator, heap.GetData() + 1, static_cast<size_t>(header.count)))
+			return false;
+		heap._count = static_cast<size_t>(header.count);
+		return true;
+	}
+
+	template <typename T>
+	bool SnapshotReader::ReadContainerHeader(const snapshotImpl::Kind kind, snapshotImpl::ContainerHeader& header)
+	{
+		if (!ReadValue(header))
+			return false;
+		// A different element size means that the type has changed since the snapshot has been written.
+		if (header.kind != kind || header.elementSize != sizeof(T) || header.count > header.length ||
+			static_cast<size_t>(header.length) != header.length)
+			_failed = true;
+		return !_failed;
+	}
+
+	template <typename T>
+	bool SnapshotReader::ReadValues(LinearAllocator& allocator, T* data, const size_t count)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			static_cast<void>(allocator);
+			return ReadBytes(data, sizeof(T) * count);
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+				if (!SnapshotSerializer<T>::Read(*this, allocator, data[i]))
+				{
+					_failed = true;
+					return false;
+				}
+			return !_failed;
+		}
+	}
+
+	template <typename T>
+	void SnapshotSerializer<KeyPair<T>>::Write(SnapshotWriter& writer, KeyPair<T>& keyPair)
+	{
+		writer.WriteValue(keyPair.key);
+		SnapshotSerializer<T>::Write(writer, keyPair.value);
+	}
+
+	template <typename T>
+	bool SnapshotSerializer<KeyPair<T>>::Read(SnapshotReader& reader, LinearAllocator& allocator, KeyPair<T>& keyPair)
+	{
+		return reader.ReadValue(keyPair.key) && SnapshotSerializer<T>::Read(reader, allocator, keyPair.value);
+	}
+}
@@ -0,0 +1,291 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include "LinearAllocator.h"
+#include "CacheLine.h"
+#include "Span.h"
+#include "Tuple.h"
+
+namespace jlb
+{
+	namespace soaImpl
+	{
+		[[nodiscard]] constexpr size_t AlignUp(const size_t value, const size_t alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	/// <summary>
+	/// Unordered vector that stores every member of the tuple in its own contiguous column (structure of arrays).<br>
+	/// Loops that only touch a few members only have to stream through those columns.<br>
+	/// All columns share a single allocation, and every column starts at a cache line.<br>
+	/// Does not have ownership over the memory that it uses, and does not resize the capacity automatically.
+	/// </summary>
+	/// <typeparam name="...Ts">Types of the columns.</typeparam>
+	template <typename ...Ts>
+	class SoAVector final
+	{
+	public:
+		static_assert(sizeof...(Ts) > 0);
+		static_assert(((alignof(Ts) <= CACHE_LINE_SIZE) && ...));
+
+		// Type of column I.
+		template <size_t I>
+		using Type = typename tupleImpl::TypeAt<I, Ts...>::Type;
+		// Tuple that holds references to all the members of a row.
+		using Row = Tuple<Ts&...>;
+
+		/// <summary>
+		/// Iterates over the rows, yielding tuples of references.
+		/// </summary>
+		class RowIterator final
+		{
+		public:
+			SoAVector* vector = nullptr;
+			size_t index = 0;
+
+			Row operator*() const;
+			RowIterator& operator++();
+
+			friend bool operator==(const RowIterator& a, const RowIterator& b)
+			{
+				return a.index == b.index;
+			}
+
+			friend bool operator!=(const RowIterator& a, const RowIterator& b)
+			{
+				return !(a == b);
+			}
+		};
+
+		SoAVector() = default;
+		SoAVector(SoAVector& other) = delete;
+		SoAVector(SoAVector&& other) = delete;
+		SoAVector& operator=(SoAVector& other) = delete;
+		SoAVector& operator=(SoAVector&& other) = delete;
+
+		/// <summary>
+		/// Allocates all the columns as a single chunk of memory.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="capacity">Maximum amount of rows.</param>
+		void Allocate(LinearAllocator& allocator, size_t capacity);
+		/// <summary>
+		/// Frees the columns from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Gets the row at a certain index.
+		/// </summary>
+		/// <param name="index">Index of the row.</param>
+		/// <returns>Tuple of references to the members of the row.</returns>
+		[[nodiscard]] Row operator[](size_t index);
+
+		/// <summary>
+		/// Add a row to the back of the vector.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <param name="...values">Members of the row.</param>
+		/// <returns>Tuple of references to the members of the added row.</returns>
+		Row Add(const Ts&... values);
+		/// <summary>
+		/// Add a row of default values to the back of the vector.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <returns>Tuple of references to the members of the added row.</returns>
+		Row Add();
+		/// <summary>
+		/// Remove the row at a certain index by swapping it with the last row.
+		/// </summary>
+		/// <param name="index">Index where the row will be removed.</param>
+		void RemoveAt(size_t index);
+		/// <summary>
+		/// Sets the count to zero.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Gets a view over the current values of a single column.
+		/// </summary>
+		/// <typeparam name="I">Index of the column.</typeparam>
+		/// <returns>View over the column.</returns>
+		template <size_t I>
+		[[nodiscard]] Span<Type<I>> GetColumn();
+
+		/// <summary>
+		/// Gets the amount of rows in the vector.
+		/// </summary>
+		/// <returns>Amount of rows in the vector.</returns>
+		[[nodiscard]] size_t GetCount() const;
+		/// <summary>
+		/// Gets the maximum amount of rows in the vector.
+		/// </summary>
+		/// <returns>Capacity of the vector.</returns>
+		[[nodiscard]] size_t GetCapacity() const;
+
+		[[nodiscard]] RowIterator begin();
+		[[nodiscard]] RowIterator end();
+
+	private:
+		static constexpr size_t COLUMN_COUNT = sizeof...(Ts);
+
+		void* _columns[COLUMN_COUNT]{};
+		size_t _count = 0;
+		size_t _capacity = 0;
+
+		template <size_t I>
+		[[nodiscard]] Type<I>* GetColumnData();
+		template <size_t ...Is>
+		[[nodiscard]] Row GetRow(size_t index, std::index_sequence<Is...>);
+		template <size_t ...Is>
+		void Assign(size_t index, std::index_sequence<Is...>, const Ts&... values);
+		template <size_t ...Is>
+		void Move(size_t dst, size_t src, std::index_sequence<Is...>);
+	};
+
+	template <typename ...Ts>
+	typename SoAVector<Ts...>::Row SoAVector<Ts...>::RowIterator::operator*() const
+	{
+		return (*vector)[index];
+	}
+
+	template <typename ...Ts>
+	typename SoAVector<Ts...>::RowIterator& SoAVector<Ts...>::RowIterator::operator++()
+	{
+		++index;
+		return *this;
+	}
+
+	template <typename ...Ts>
+	void SoAVector<Ts...>::Allocate(LinearAllocator& allocator, const size_t capacity)
+	{
+		// Pad every column up to a cache line, so that the next one starts at one as well.
+		const size_t columnSizes[] = { soaImpl::AlignUp(sizeof(Ts) * capacity, CACHE_LINE_SIZE)... };
+		size_t size = CACHE_LINE_SIZE;
+		for (const size_t columnSize : columnSizes)
+			size += columnSize;
+
+		// The linear allocator only aligns to sizeof(size_t), so align the first column manually.
+		const auto address = reinterpret_cast<uintptr_t>(allocator.Malloc(size));
+		auto column = reinterpret_cast<char*>(soaImpl::AlignUp(address, CACHE_LINE_SIZE));
+
+		for (size_t i = 0; i < COLUMN_COUNT; ++i)
+		{
+			_columns[i] = column;
+			column += columnSizes[i];
+		}
+
+		_count = 0;
+		_capacity = capacity;
+	}
+
+	template <typename ...Ts>
+	void SoAVector<Ts...>::Free(LinearAllocator& allocator)
+	{
+		allocator.Free();
+	}
+
+	template <typename ...Ts>
+	typename SoAVector<Ts...>::Row SoAVector<Ts...>::operator[](const size_t index)
+	{
+		assert(index < _count);
+		return GetRow(index, std::index_sequence_for<Ts...>());
+	}
+
+	template <typename ...Ts>
+	typename SoAVector<Ts...>::Row SoAVector<Ts...>::Add(const Ts&... values)
+	{
+		assert(_count < _capacity);
+		Assign(_count, std::index_sequence_for<Ts...>(), values...);
+		return GetRow(_count++, std::index_sequence_for<Ts...>());
+	}
+
+	template <typename ...Ts>
+	typename SoAVector<Ts...>::Row SoAVector<Ts...>::Add()
+	{
+		return Add(Ts{}...);
+	}
+
+	template <typename ...Ts>
+	void SoAVector<Ts...>::RemoveAt(const size_t index)
+	{
+		assert(index < _count);
+		// Move the last row into the removed one.
+		Move(index, --_count, std::index_sequence_for<Ts...>());
+	}
+
+	template <typename ...Ts>
+	void SoAVector<Ts...>::Clear()
+	{
+		_count = 0;
+	}
+
+	template <typename ...Ts>
+	template <size_t I>
+	Span<typename SoAVector<Ts...>::template Type<I>> SoAVector<Ts...>::GetColumn()
+	{
+		return Span<Type<I>>(GetColumnData<I>(), _count);
+	}
+
+	template <typename ...Ts>
+	size_t SoAVector<Ts...>::GetCount() const
+	{
+		return _count;
+	}
+
+	template <typename ...Ts>
+	size_t SoAVector<Ts...>::GetCapacity() const
+	{
+		return _capacity;
+	}
+
+	template <typename ...Ts>
+	typename SoAVector<Ts...>::RowIterator SoAVector<Ts...>::begin()
+	{
+		RowIterator it;
+		it.vector = this;
+		it.index = 0;
+		return it;
+	}
+
+	template <typename ...Ts>
+	typename SoAVector<Ts...>::RowIterator SoAVector<Ts...>::end()
+	{
+		RowIterator it;
+		it.vector = this;
+		it.index = _count;
+		return it;
+	}
+
+	template <typename ...Ts>
+	template <size_t I>
+	typename SoAVector<Ts...>::template Type<I>* SoAVector<Ts...>::GetColumnData()
+	{
+		return static_cast<Type<I>*>(_columns[I]);
+	}
+
+	template <typename ...Ts>
+	template <size_t ...Is>
+	typename SoAVector<Ts...>::Row SoAVector<Ts...>::GetRow(const size_t index, std::index_sequence<Is...>)
+	{
+		return Row(GetColumnData<Is>()[index]...);
+	}
+
+	template <typename ...Ts>
+	template <size_t ...Is>
+	void SoAVector<Ts...>::Assign(const size_t index, std::index_sequence<Is...>, const Ts&... values)
+	{
+		((GetColumnData<Is>()[index] = values), ...);
+	}
+
+	template <typename ...Ts>
+	template <size_t ...Is>
+	void SoAVector<Ts...>::Move(const size_t dst, const size_t src, std::index_sequence<Is...>)
+	{
+		((GetColumnData<Is>()[dst] = GetColumnData<Is>()[src]), ...);
+	}
+}
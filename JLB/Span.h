@@ -0,0 +1,71 @@
+#pragma once
+#include <cassert>
+#include "Iterator.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Lightweight view over a range of values that does not have ownership over the memory that it uses.<br>
+	/// Unlike Array it can be copied, so it can be returned by value.
+	/// </summary>
+	template <typename T>
+	class Span final
+	{
+	public:
+		Span() = default;
+		Span(T* memory, size_t length);
+
+		[[nodiscard]] T& operator[](size_t index) const;
+		[[nodiscard]] size_t GetLength() const;
+
+		/// <summary>
+		/// Get a raw pointer to the viewed memory.
+		/// </summary>
+		/// <returns>Raw pointer to the viewed memory.</returns>
+		[[nodiscard]] T* GetData() const;
+
+		[[nodiscard]] Iterator<T> begin() const;
+		[[nodiscard]] Iterator<T> end() const;
+
+	private:
+		T* _memory = nullptr;
+		size_t _length = 0;
+	};
+
+	template <typename T>
+	Span<T>::Span(T* memory, const size_t length) : _memory(memory), _length(length)
+	{
+
+	}
+
+	template <typename T>
+	T& Span<T>::operator[](const size_t index) const
+	{
+		assert(index < _length);
+		return _memory[index];
+	}
+
+	template <typename T>
+	size_t Span<T>::GetLength() const
+	{
+		return _length;
+	}
+
+	template <typename T>
+	T* Span<T>::GetData() const
+	{
+		return _memory;
+	}
+
+	template <typename T>
+	Iterator<T> Span<T>::begin() const
+	{
+		return Iterator<T>(_memory);
+	}
+
+	template <typename T>
+	Iterator<T> Span<T>::end() const
+	{
+		return Iterator<T>(_memory + _length);
+	}
+}
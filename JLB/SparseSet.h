@@ -0,0 +1,275 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include "Vector.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Stable reference to a value in a SparseSet.<br>
+	/// Becomes invalid when the value is erased, even if the slot is reused afterwards.
+	/// </summary>
+	struct SparseHandle final
+	{
+		uint32_t index = 0;
+		uint32_t generation = 0;
+
+		friend bool operator==(const SparseHandle& a, const SparseHandle& b)
+		{
+			return a.index == b.index && a.generation == b.generation;
+		}
+
+		friend bool operator!=(const SparseHandle& a, const SparseHandle& b)
+		{
+			return !(a == b);
+		}
+	};
+
+	/// <summary>
+	/// Slot map that hands out generational handles to its values.<br>
+	/// The values are densely packed, so iterating over them is a contiguous scan, while handles stay valid when values are moved by erasure.<br>
+	/// Insert, erase and lookup are all O(1).<br>
+	/// Does not have ownership over the memory that it uses, and does not resize the capacity automatically.
+	/// </summary>
+	template <typename T>
+	class SparseSet final
+	{
+	public:
+		SparseSet() = default;
+		SparseSet(SparseSet& other) = delete;
+		SparseSet(SparseSet&& other) = delete;
+		SparseSet& operator=(SparseSet& other) = delete;
+		SparseSet& operator=(SparseSet&& other) = delete;
+
+		/// <summary>
+		/// Allocates the slots and the dense values.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="capacity">Maximum amount of values.</param>
+		void Allocate(LinearAllocator& allocator, size_t capacity);
+		/// <summary>
+		/// Frees the set from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Insert a value into the set.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <param name="value">Value to be inserted.</param>
+		/// <returns>Handle to the inserted value.</returns>
+		SparseHandle Insert(T& value);
+		/// <summary>
+		/// Insert a value into the set.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <param name="value">Value to be inserted.</param>
+		/// <returns>Handle to the inserted value.</returns>
+		SparseHandle Insert(T&& value = {});
+		/// <summary>
+		/// Remove by handle. The last value is moved into the gap.
+		/// </summary>
+		/// <param name="handle">Handle of the value to be removed.</param>
+		void Erase(SparseHandle handle);
+		/// <summary>
+		/// Removes all values and invalidates all handles.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Checks if the handle still refers to a value in the set.
+		/// </summary>
+		/// <param name="handle">Handle to be checked.</param>
+		/// <returns>If the handle is valid.</returns>
+		[[nodiscard]] bool Contains(SparseHandle handle);
+		/// <summary>
+		/// Gets the value the handle refers to.
+		/// </summary>
+		/// <param name="handle">Handle of the value.</param>
+		/// <returns>Value that the handle refers to.</returns>
+		[[nodiscard]] T& operator[](SparseHandle handle);
+		/// <summary>
+		/// Gets the value the handle refers to.
+		/// </summary>
+		/// <param name="handle">Handle of the value.</param>
+		/// <returns>Pointer to the value, or nullptr if the handle is no longer valid.</returns>
+		[[nodiscard]] T* TryGet(SparseHandle handle);
+		/// <summary>
+		/// Gets the handle of the value at a certain position in the dense values.
+		/// </summary>
+		/// <param name="index">Index in the dense values.</param>
+		/// <returns>Handle of the value.</returns>
+		[[nodiscard]] SparseHandle GetHandle(size_t index);
+
+		/// <summary>
+		/// Gets the amount of values in the set.
+		/// </summary>
+		/// <returns>Amount of values in the set.</returns>
+		[[nodiscard]] size_t GetCount() const;
+		/// <summary>
+		/// Gets the maximum amount of values in the set.
+		/// </summary>
+		/// <returns>Capacity of the set.</returns>
+		[[nodiscard]] size_t GetCapacity() const;
+
+		[[nodiscard]] Iterator<T> begin();
+		[[nodiscard]] Iterator<T> end();
+
+	private:
+		struct Slot final
+		{
+			// Index in the dense values, or the next free slot when the slot is unused.
+			uint32_t dense = 0;
+			uint32_t generation = 1;
+		};
+
+		static constexpr uint32_t _noSlot = UINT32_MAX;
+
+		Array<Slot> _slots{};
+		Vector<T> _values{};
+		// The slot of every dense value.
+		Vector<uint32_t> _owners{};
+		uint32_t _freeSlot = _noSlot;
+		uint32_t _usedSlots = 0;
+
+		[[nodiscard]] SparseHandle _Insert(T& value);
+	};
+
+	template <typename T>
+	void SparseSet<T>::Allocate(LinearAllocator& allocator, const size_t capacity)
+	{
+		assert(capacity < _noSlot);
+		_slots.Allocate(allocator, capacity);
+		_values.Allocate(allocator, capacity);
+		_owners.Allocate(allocator, capacity);
+		_freeSlot = _noSlot;
+		_usedSlots = 0;
+	}
+
+	template <typename T>
+	void SparseSet<T>::Free(LinearAllocator& allocator)
+	{
+		_owners.Free(allocator);
+		_values.Free(allocator);
+		_slots.Free(allocator);
+	}
+
+	template <typename T>
+	SparseHandle SparseSet<T>::Insert(T& value)
+	{
+		return _Insert(value);
+	}
+
+	template <typename T>
+	SparseHandle SparseSet<T>::Insert(T&& value)
+	{
+		return _Insert(value);
+	}
+
+	template <typename T>
+	void SparseSet<T>::Erase(const SparseHandle handle)
+	{
+		assert(Contains(handle));
+		Slot& slot = _slots[handle.index];
+		const uint32_t dense = slot.dense;
+
+		// Move the last value into the gap, and point its slot to the new position.
+		_values.RemoveAt(dense);
+		_owners.RemoveAt(dense);
+		if (dense < _owners.GetCount())
+			_slots[_owners[dense]].dense = dense;
+
+		// Invalidate the old handles and add the slot to the free list.
+		++slot.generation;
+		slot.dense = _freeSlot;
+		_freeSlot = handle.index;
+	}
+
+	template <typename T>
+	void SparseSet<T>::Clear()
+	{
+		for (const uint32_t owner : _owners)
+		{
+			Slot& slot = _slots[owner];
+			++slot.generation;
+			slot.dense = _freeSlot;
+			_freeSlot = owner;
+		}
+
+		_values.Clear();
+		_owners.Clear();
+	}
+
+	template <typename T>
+	bool SparseSet<T>::Contains(const SparseHandle handle)
+	{
+		if (handle.index >= _usedSlots)
+			return false;
+		return _slots[handle.index].generation == handle.generation;
+	}
+
+	template <typename T>
+	T& SparseSet<T>::operator[](const SparseHandle handle)
+	{
+		assert(Contains(handle));
+		return _values[_slots[handle.index].dense];
+	}
+
+	template <typename T>
+	T* SparseSet<T>::TryGet(const SparseHandle handle)
+	{
+		return Contains(handle) ? &_values[_slots[handle.index].dense] : nullptr;
+	}
+
+	template <typename T>
+	SparseHandle SparseSet<T>::GetHandle(const size_t index)
+	{
+		assert(index < _owners.GetCount());
+		const uint32_t owner = _owners[index];
+		return { owner, _slots[owner].generation };
+	}
+
+	template <typename T>
+	size_t SparseSet<T>::GetCount() const
+	{
+		return _values.GetCount();
+	}
+
+	template <typename T>
+	size_t SparseSet<T>::GetCapacity() const
+	{
+		return _values.GetLength();
+	}
+
+	template <typename T>
+	Iterator<T> SparseSet<T>::begin()
+	{
+		return _values.begin();
+	}
+
+	template <typename T>
+	Iterator<T> SparseSet<T>::end()
+	{
+		return _values.end();
+	}
+
+	template <typename T>
+	SparseHandle SparseSet<T>::_Insert(T& value)
+	{
+		assert(_values.GetCount() < _values.GetLength());
+
+		// Reuse a free slot, or take a slot that has never been used.
+		uint32_t index = _freeSlot;
+		if (index != _noSlot)
+			_freeSlot = _slots[index].dense;
+		else
+			index = _usedSlots++;
+
+		Slot& slot = _slots[index];
+		slot.dense = static_cast<uint32_t>(_values.GetCount());
+		_values.Add(value);
+		_owners.Add(index);
+		return { index, slot.generation };
+	}
+}
@@ -77,10 +77,6 @@ namespace jlb
 	template <typename T>
 	Iterator<T> Stack<T>::end()
 	{
-		Iterator<T> it;
-		it.memory = Array<T>::GetData();
-		it.index = _count;
-		it.length = Array<T>::GetLength();
-		return it;
+		return Iterator<T>(Array<T>::GetData() + _count);
 	}
 }
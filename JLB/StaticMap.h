@@ -0,0 +1,328 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "StringView.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Key value pair used to build a StaticMap.
+	/// </summary>
+	template <typename K, typename V>
+	struct StaticMapEntry final
+	{
+		K key{};
+		V value{};
+	};
+
+	namespace staticMapImpl
+	{
+		[[nodiscard]] constexpr uint64_t Mix(uint64_t x)
+		{
+			// Finalizer of MurmurHash3, every input bit affects every output bit.
+			x ^= x >> 33;
+			x *= 0xFF51AFD7ED558CCD;
+			x ^= x >> 33;
+			x *= 0xC4CEB9FE1A85EC53;
+			x ^= x >> 33;
+			return x;
+		}
+
+		template <typename T, typename = std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>>
+		[[nodiscard]] constexpr uint64_t Hash(const T key)
+		{
+			return Mix(static_cast<uint64_t>(key));
+		}
+
+		[[nodiscard]] constexpr uint64_t Hash(const char* data, const size_t length)
+		{
+			// 64 bit FNV-1a.
+			uint64_t hash = 0xCBF29CE484222325;
+			for (size_t i = 0; i < length; ++i)
+			{
+				hash ^= static_cast<unsigned char>(data[i]);
+				hash *= 0x100000001B3;
+			}
+			return Mix(hash);
+		}
+
+		[[nodiscard]] constexpr size_t Length(const char* str)
+		{
+			size_t length = 0;
+			while (str[length] != '\0')
+				++length;
+			return length;
+		}
+
+		[[nodiscard]] constexpr uint64_t Hash(const char* key)
+		{
+			return Hash(key, Length(key));
+		}
+
+		[[nodiscard]] inline uint64_t Hash(const StringView& key)
+		{
+			return Hash(key.GetData(), key.GetLength());
+		}
+
+		template <typename T, typename = std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>>
+		[[nodiscard]] constexpr bool Equals(const T a, const T b)
+		{
+			return a == b;
+		}
+
+		[[nodiscard]] constexpr bool Equals(const char* a, const char* b)
+		{
+			size_t i = 0;
+			while (a[i] != '\0' && a[i] == b[i])
+				++i;
+			return a[i] == b[i];
+		}
+
+		[[nodiscard]] inline bool Equals(const char* a, const StringView& b)
+		{
+			const size_t length = b.GetLength();
+			for (size_t i = 0; i < length; ++i)
+				if (a[i] != b[i] || a[i] == '\0')
+					return false;
+			return a[length] == '\0';
+		}
+
+		[[nodiscard]] constexpr size_t NextPowerOfTwo(const size_t value)
+		{
+			size_t result = 1;
+			while (result < value)
+				result *= 2;
+			return result;
+		}
+
+		// Keeps the table at most 80% full, so that the last buckets still find free slots quickly.
+		[[nodiscard]] constexpr size_t GetSlotCount(const size_t count)
+		{
+			const size_t slots = NextPowerOfTwo(count);
+			return slots * 4 < count * 5 ? slots * 2 : slots;
+		}
+
+		// Around four keys per bucket, as one seed per bucket is stored next to the slots.
+		[[nodiscard]] constexpr size_t GetBucketCount(const size_t count)
+		{
+			return NextPowerOfTwo((count + 3) / 4);
+		}
+
+		[[nodiscard]] constexpr size_t GetBucket(const uint64_t hash, const size_t bucketCount)
+		{
+			return static_cast<size_t>(hash >> 32) & (bucketCount - 1);
+		}
+
+		[[nodiscard]] constexpr size_t GetSlot(const uint64_t hash, const uint32_t seed, const size_t slotCount)
+		{
+			// The hash is already mixed, so a single multiply is enough to spread the seeds.
+			return static_cast<size_t>(((hash ^ seed) * 0x9E3779B97F4A7C15) >> 32) & (slotCount - 1);
+		}
+
+		// Not constexpr on purpose: reaching it while building at compile time turns into a compile error that names the problem.
+		inline void DuplicateKeyInStaticMap()
+		{
+			assert(false);
+		}
+
+		inline void NoPerfectHashFoundForStaticMap()
+		{
+			assert(false);
+		}
+	}
+
+	/// <summary>
+	/// Read-only map with a fixed set of keys, built at compile time with a perfect hash.<br>
+	/// Every key has its own slot, so a lookup is a single hash, a single slot and a single compare, without any probing.<br>
+	/// Declare it static constexpr, so that it lives in read-only data and costs nothing at startup.<br>
+	/// Keys can be integers, enums or string literals. String keys can also be looked up with a StringView at runtime.
+	/// </summary>
+	/// <typeparam name="K">Key type.</typeparam>
+	/// <typeparam name="V">Value type, which has to be usable in constant expressions.</typeparam>
+	/// <typeparam name="N">Amount of keys.</typeparam>
+	template <typename K, typename V, size_t N>
+	class StaticMap final
+	{
+		static_assert(N > 0, "A static map needs at least one key.");
+
+	public:
+		static constexpr size_t SLOT_COUNT = staticMapImpl::GetSlotCount(N);
+		static constexpr size_t BUCKET_COUNT = staticMapImpl::GetBucketCount(N);
+
+		/// <summary>
+		/// Builds the perfect hash. Fails to compile when a key occurs more than once.
+		/// </summary>
+		/// <param name="entries">Key value pairs, in any order.</param>
+		constexpr explicit StaticMap(const StaticMapEntry<K, V>(&entries)[N]);
+
+		/// <summary>
+		/// Finds the value that belongs to a key.
+		/// </summary>
+		/// <param name="key">Key of the value, or a StringView for string keys.</param>
+		/// <returns>Pointer to the value, or nullptr if the key is not in the map.</returns>
+		template <typename Key>
+		[[nodiscard]] constexpr const V* Find(const Key& key) const;
+		/// <summary>
+		/// Checks if the map contains a certain key.
+		/// </summary>
+		template <typename Key>
+		[[nodiscard]] constexpr bool Contains(const Key& key) const;
+		/// <summary>
+		/// Gets the value that belongs to a key. The key has to be in the map.
+		/// </summary>
+		template <typename Key>
+		[[nodiscard]] constexpr const V& operator[](const Key& key) const;
+
+		/// <summary>
+		/// Gets the amount of keys in the map.
+		/// </summary>
+		[[nodiscard]] static constexpr size_t GetCount();
+
+	private:
+		struct Slot final
+		{
+			K key{};
+			V value{};
+			bool used = false;
+		};
+
+		// Added to the hash of every key in the bucket, chosen so that all keys end up in different slots.
+		uint32_t _seeds[BUCKET_COUNT]{};
+		Slot _slots[SLOT_COUNT]{};
+
+		// The only slot the key can be in.
+		template <typename Key>
+		[[nodiscard]] constexpr const Slot& FindSlot(const Key& key) const;
+	};
+
+	/// <summary>
+	/// Builds a StaticMap, deducing the amount of keys.<br>
+	/// Usage: static constexpr auto map = MakeStaticMap&lt;const char*, int&gt;({ { "add", 0 }, { "sub", 1 } });
+	/// </summary>
+	template <typename K, typename V, size_t N>
+	[[nodiscard]] constexpr StaticMap<K, V, N> MakeStaticMap(const StaticMapEntry<K, V>(&entries)[N])
+	{
+		return StaticMap<K, V, N>(entries);
+	}
+
+	template <typename K, typename V, size_t N>
+	constexpr StaticMap<K, V, N>::StaticMap(const StaticMapEntry<K, V>(&entries)[N])
+	{
+		using namespace staticMapImpl;
+
+		// Group the keys by bucket.
+		uint64_t hashes[N]{};
+		size_t bucketStarts[BUCKET_COUNT + 1]{};
+		for (size_t i = 0; i < N; ++i)
+		{
+			hashes[i] = Hash(entries[i].key);
+			++bucketStarts[GetBucket(hashes[i], BUCKET_COUNT) + 1];
+		}
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+			bucketStarts[i + 1] += bucketStarts[i];
+
+		size_t members[N]{};
+		size_t filled[BUCKET_COUNT]{};
+		for (size_t i = 0; i < N; ++i)
+		{
+			const size_t bucket = GetBucket(hashes[i], BUCKET_COUNT);
+			members[bucketStarts[bucket] + filled[bucket]++] = i;
+		}
+
+		// Equal keys always share a bucket and a slot, so no seed would ever separate them.
+		for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+			for (size_t a = bucketStarts[bucket]; a < bucketStarts[bucket + 1]; ++a)
+				for (size_t b = a + 1; b < bucketStarts[bucket + 1]; ++b)
+					if (Equals(entries[members[a]].key, entries[members[b]].key))
+						DuplicateKeyInStaticMap();
+
+		// Place the largest buckets first, while most of the slots are still free.
+		size_t order[BUCKET_COUNT]{};
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			const size_t size = bucketStarts[i + 1] - bucketStarts[i];
+			size_t j = i;
+			for (; j > 0 && bucketStarts[order[j - 1] + 1] - bucketStarts[order[j - 1]] < size; --j)
+				order[j] = order[j - 1];
+			order[j] = i;
+		}
+
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			const size_t bucket = order[i];
+			const size_t begin = bucketStarts[bucket];
+			const size_t end = bucketStarts[bucket + 1];
+			if (begin == end)
+				break;
+
+			// Try seeds until every key of the bucket lands in a different free slot.
+			uint32_t seed = 0;
+			bool placed = false;
+			for (; !placed && seed < UINT16_MAX; ++seed)
+			{
+				placed = true;
+				for (size_t a = begin; placed && a < end; ++a)
+				{
+					const size_t slot = GetSlot(hashes[members[a]], seed, SLOT_COUNT);
+					placed = !_slots[slot].used;
+					for (size_t b = begin; placed && b < a; ++b)
+						placed = GetSlot(hashes[members[b]], seed, SLOT_COUNT) != slot;
+				}
+			}
+			if (!placed)
+				NoPerfectHashFoundForStaticMap();
+
+			_seeds[bucket] = --seed;
+			for (size_t a = begin; a < end; ++a)
+			{
+				Slot& slot = _slots[GetSlot(hashes[members[a]], seed, SLOT_COUNT)];
+				slot.key = entries[members[a]].key;
+				slot.value = entries[members[a]].value;
+				slot.used = true;
+			}
+		}
+	}
+
+	template <typename K, typename V, size_t N>
+	template <typename Key>
+	constexpr const V* StaticMap<K, V, N>::Find(const Key& key) const
+	{
+		const Slot& slot = FindSlot(key);
+		return slot.used && staticMapImpl::Equals(slot.key, key) ? &slot.value : nullptr;
+	}
+
+	template <typename K, typename V, size_t N>
+	template <typename Key>
+	constexpr bool StaticMap<K, V, N>::Contains(const Key& key) const
+	{
+		const Slot& slot = FindSlot(key);
+		return slot.used && staticMapImpl::Equals(slot.key, key);
+	}
+
+	template <typename K, typename V, size_t N>
+	template <typename Key>
+	constexpr const V& StaticMap<K, V, N>::operator[](const Key& key) const
+	{
+		// Compares the slot instead of calling Find, as comparing addresses to nullptr is not always a constant expression.
+		const Slot& slot = FindSlot(key);
+		assert(slot.used && staticMapImpl::Equals(slot.key, key));
+		return slot.value;
+	}
+
+	template <typename K, typename V, size_t N>
+	constexpr size_t StaticMap<K, V, N>::GetCount()
+	{
+		return N;
+	}
+
+	template <typename K, typename V, size_t N>
+	template <typename Key>
+	constexpr auto StaticMap<K, V, N>::FindSlot(const Key& key) const -> const Slot&
+	{
+		using namespace staticMapImpl;
+		const uint64_t hash = Hash(key);
+		return _slots[GetSlot(hash, _seeds[GetBucket(hash, BUCKET_COUNT)], SLOT_COUNT)];
+	}
+}
@@ -0,0 +1,98 @@
+#include "StringTable.h"
+#include <cassert>
+#include <cstring>
+
+namespace jlb
+{
+	size_t InternedString::Hash(InternedString& string)
+	{
+		return string.hash;
+	}
+
+	bool InternedString::operator==(const InternedString& other) const
+	{
+		return data == other.data;
+	}
+
+	bool InternedString::operator!=(const InternedString& other) const
+	{
+		return !operator==(other);
+	}
+
+	InternedString::operator const char* () const
+	{
+		return data;
+	}
+
+	namespace stringTableImpl
+	{
+		bool Entry::operator==(const Entry& other) const
+		{
+			return string.hash == other.string.hash && string.length == other.string.length &&
+				memcmp(string.data, other.string.data, string.length) == 0;
+		}
+	}
+
+	void StringTable::Allocate(LinearAllocator& allocator, const size_t capacity, const size_t bufferSize)
+	{
+		// Lookups scan the whole table on a miss, they do not stop at a free slot.
+		// The extra slot is only there because HashMap lookups assert that the count is below the length, so a full table still needs one.
+		HashMap::Allocate(allocator, capacity + 1);
+		hasher = GetEntryHash;
+		_buffer = allocator.New<char>(bufferSize);
+		_bufferSize = bufferSize;
+		_bufferUsed = 0;
+	}
+
+	void StringTable::Free(LinearAllocator& allocator)
+	{
+		allocator.Free();
+		_buffer = nullptr;
+		_bufferSize = 0;
+		_bufferUsed = 0;
+		HashMap::Free(allocator);
+	}
+
+	InternedString StringTable::Intern(const char* str)
+	{
+		assert(str);
+		return Intern(str, strlen(str));
+	}
+
+	InternedString StringTable::Intern(const char* str, const size_t length)
+	{
+		stringTableImpl::Entry entry{ { str, length, HashString(str, length) } };
+
+		size_t index;
+		if (HashMap::Contains(entry, index))
+			return HashMap::operator[](index).value.string;
+
+		// Store a null terminated copy in the buffer.
+		assert(_bufferUsed + length + 1 <= _bufferSize);
+		char* copy = &_buffer[_bufferUsed];
+		memcpy(copy, str, length);
+		copy[length] = '\0';
+		_bufferUsed += length + 1;
+
+		entry.string.data = copy;
+		// The lookup above already missed, so the entry can go straight into the first free slot.
+		_InsertNew(entry);
+		return entry.string;
+	}
+
+	InternedString StringTable::Intern(const ArenaString& str)
+	{
+		return Intern(str.GetData(), str.GetLength());
+	}
+
+	bool StringTable::Contains(const char* str, const size_t length)
+	{
+		stringTableImpl::Entry entry{ { str, length, HashString(str, length) } };
+		return HashMap::Contains(entry);
+	}
+
+	size_t StringTable::GetEntryHash(stringTableImpl::Entry& entry)
+	{
+		return entry.string.hash;
+	}
+}
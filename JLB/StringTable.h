@@ -0,0 +1,101 @@
+#pragma once
+#include "HashMap.h"
+#include "ArenaString.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// String that has been stored in a StringTable.<br>
+	/// Every unique string is only stored once per table, so interned strings are compared by pointer and hashed by their stored hash, both in O(1).
+	/// </summary>
+	struct InternedString final
+	{
+		const char* data = nullptr;
+		size_t length = 0;
+		size_t hash = 0;
+
+		/// <summary>
+		/// Returns the stored hash, can be used as the hasher of a HashMap.
+		/// </summary>
+		[[nodiscard]] static size_t Hash(InternedString& string);
+
+		[[nodiscard]] bool operator==(const InternedString& other) const;
+		[[nodiscard]] bool operator!=(const InternedString& other) const;
+
+		operator const char* () const;
+	};
+
+	namespace stringTableImpl
+	{
+		// Lookup entry that compares by content, since lookups are done with strings that have not been interned yet.
+		struct Entry final
+		{
+			InternedString string{};
+
+			[[nodiscard]] bool operator==(const Entry& other) const;
+		};
+	}
+
+	/// <summary>
+	/// Interning table that stores every unique string only once.<br>
+	/// The characters are stored in a single buffer from the linear allocator, strings cannot be removed individually.<br>
+	/// Does not have ownership over the memory that it uses, and does not resize the capacity automatically.
+	/// </summary>
+	class StringTable final : HashMap<stringTableImpl::Entry>
+	{
+	public:
+		/// <summary>
+		/// Allocates the lookup table and the character buffer.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="capacity">Maximum amount of unique strings.</param>
+		/// <param name="bufferSize">Maximum amount of characters, including a null terminator per string.</param>
+		void Allocate(LinearAllocator& allocator, size_t capacity, size_t bufferSize);
+		/// <summary>
+		/// Frees the table from the linear allocator.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator) override;
+
+		/// <summary>
+		/// Gets the interned version of a string, and stores the string if it has not been interned before.
+		/// </summary>
+		/// <param name="str">Null terminated string.</param>
+		/// <returns>Interned string.</returns>
+		InternedString Intern(const char* str);
+		/// <summary>
+		/// Gets the interned version of a string, and stores the string if it has not been interned before.
+		/// </summary>
+		/// <param name="str">Characters of the string.</param>
+		/// <param name="length">Amount of characters.</param>
+		/// <returns>Interned string.</returns>
+		InternedString Intern(const char* str, size_t length);
+		/// <summary>
+		/// Gets the interned version of a string, and stores the string if it has not been interned before.
+		/// </summary>
+		/// <param name="str">String to be interned.</param>
+		/// <returns>Interned string.</returns>
+		InternedString Intern(const ArenaString& str);
+		/// <summary>
+		/// Checks if a string has been interned.
+		/// </summary>
+		/// <param name="str">Characters of the string.</param>
+		/// <param name="length">Amount of characters.</param>
+		/// <returns>If the string has been interned.</returns>
+		[[nodiscard]] bool Contains(const char* str, size_t length);
+
+		using HashMap<stringTableImpl::Entry>::GetCount;
+#ifdef JLB_CONTAINER_STATS
+		using HashMap<stringTableImpl::Entry>::GetStats;
+		using HashMap<stringTableImpl::Entry>::ResetStats;
+		using HashMap<stringTableImpl::Entry>::GetLayout;
+#endif
+
+	private:
+		char* _buffer = nullptr;
+		size_t _bufferSize = 0;
+		size_t _bufferUsed = 0;
+
+		[[nodiscard]] static size_t GetEntryHash(stringTableImpl::Entry& entry);
+	};
+}
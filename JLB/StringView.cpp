@@ -1,39 +1,167 @@
 ﻿#include "StringView.h"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include "Kernels.h"
+#include "Vector.h"
 
 namespace jlb
 {
-	StringView::StringView(const char* strLit) : _strLit(strLit)
+	StringView::StringView(const char* str) : _data(str), _length(str ? strlen(str) : 0)
+	{
+
+	}
+
+	StringView::StringView(const char* data, const size_t length) : _data(data), _length(length)
 	{
 
 	}
 
 	const char* StringView::GetData() const
 	{
-		return _strLit;
+		return _data;
+	}
+
+	size_t StringView::GetLength() const
+	{
+		return _length;
+	}
+
+	bool StringView::IsEmpty() const
+	{
+		return _length == 0;
+	}
+
+	char StringView::operator[](const size_t index) const
+	{
+		assert(index < _length);
+		return _data[index];
+	}
+
+	StringView StringView::Substr(const size_t start, const size_t length) const
+	{
+		assert(start <= _length);
+		const size_t remaining = _length - start;
+		return { _data + start, length < remaining ? length : remaining };
+	}
+
+	size_t StringView::Find(const char c, const size_t start) const
+	{
+		if (start >= _length)
+			return SIZE_MAX;
+		const size_t index = jlb::Find(_data + start, _length - start, c);
+		return index == SIZE_MAX ? SIZE_MAX : start + index;
+	}
+
+	size_t StringView::Find(const StringView str, const size_t start) const
+	{
+		if (start > _length)
+			return SIZE_MAX;
+		const size_t index = Search(_data + start, _length - start, str._data, str._length);
+		return index == SIZE_MAX ? SIZE_MAX : start + index;
+	}
+
+	size_t StringView::FindAny(const StringView chars, const size_t start) const
+	{
+		if (start >= _length)
+			return SIZE_MAX;
+		const size_t index = jlb::FindAny(_data + start, _length - start, chars._data, chars._length);
+		return index == SIZE_MAX ? SIZE_MAX : start + index;
+	}
+
+	int StringView::Compare(const StringView other) const
+	{
+		const size_t length = _length < other._length ? _length : other._length;
+		const size_t index = Mismatch(_data, other._data, length);
+		if (index != SIZE_MAX)
+			return static_cast<unsigned char>(_data[index]) < static_cast<unsigned char>(other._data[index]) ? -1 : 1;
+		if (_length == other._length)
+			return 0;
+		return _length < other._length ? -1 : 1;
+	}
+
+	bool StringView::StartsWith(const StringView str) const
+	{
+		return str._length <= _length && Mismatch(_data, str._data, str._length) == SIZE_MAX;
+	}
+
+	bool StringView::EndsWith(const StringView str) const
+	{
+		return str._length <= _length && Mismatch(_data + _length - str._length, str._data, str._length) == SIZE_MAX;
+	}
+
+	size_t StringView::Split(const char delimiter, Vector<StringView>& outParts, const bool skipEmpty) const
+	{
+		return SplitWith(outParts, skipEmpty, [this, delimiter](const size_t start)
+		{
+			return Find(delimiter, start);
+		});
+	}
+
+	size_t StringView::SplitAny(const StringView delimiters, Vector<StringView>& outParts, const bool skipEmpty) const
+	{
+		return SplitWith(outParts, skipEmpty, [this, delimiters](const size_t start)
+		{
+			return FindAny(delimiters, start);
+		});
 	}
 
-	bool StringView::operator==(StringView& other)
+	bool StringView::operator==(const StringView other) const
 	{
-		return _strLit == other._strLit;
+		return _length == other._length && (_data == other._data || Mismatch(_data, other._data, _length) == SIZE_MAX);
 	}
 
-	bool StringView::operator==(const char* other)
+	bool StringView::operator==(const char* other) const
 	{
-		return _strLit == other;
+		return operator==(StringView(other));
 	}
 
-	bool StringView::operator!=(StringView& other)
+	bool StringView::operator!=(const StringView other) const
 	{
 		return !operator==(other);
 	}
 
-	bool StringView::operator!=(const char* other)
+	bool StringView::operator!=(const char* other) const
 	{
 		return !operator==(other);
 	}
 
 	StringView::operator const char* () const
 	{
-		return _strLit;
+		return _data;
+	}
+
+	const char* StringView::begin() const
+	{
+		return _data;
+	}
+
+	const char* StringView::end() const
+	{
+		return _data + _length;
+	}
+
+	template <typename Finder>
+	size_t StringView::SplitWith(Vector<StringView>& outParts, const bool skipEmpty, Finder finder) const
+	{
+		size_t count = 0;
+		size_t start = 0;
+
+		while (true)
+		{
+			const size_t found = finder(start);
+			const size_t end = found == SIZE_MAX ? _length : found;
+			if (!skipEmpty || end > start)
+			{
+				outParts.Add(StringView(_data + start, end - start));
+				++count;
+			}
+
+			if (found == SIZE_MAX)
+				break;
+			start = found + 1;
+		}
+
+		return count;
 	}
 }
\ No newline at end of file
@@ -1,32 +1,110 @@
 ﻿#pragma once
+#include <cstddef>
+#include <cstdint>
 
 namespace jlb
 {
+	template <typename T>
+	class Vector;
+
 	/// <summary>
-	/// String class that can ONLY handle string literals.<br>
-	/// This means that the contents of the string cannot be modified after creation.
+	/// Non owning view over a range of characters, that stores both a pointer and a length.<br>
+	/// Views can be created from string literals, or from any other memory that outlives the view.<br>
+	/// Substrings and splits point into the original memory, so they do not copy anything.
 	/// </summary>
 	class StringView final
 	{
 	public:
 		StringView() = default;
 		// ReSharper disable once CppNonExplicitConvertingConstructor
-		StringView(const char* strLit);
+		StringView(const char* str);
+		StringView(const char* data, size_t length);
 
 		/// <summary>
-		/// Returns the pointer to the string literal.
+		/// Returns the pointer to the first character.<br>
+		/// Only null terminated if the view ends where the original string ends.
+		/// </summary>
+		/// <returns>Pointer to the first character.</returns>
+		[[nodiscard]] const char* GetData() const;
+		/// <summary>
+		/// Gets the amount of characters in the view.
 		/// </summary>
-		/// <returns>Pointer to the string literal.</returns>
-		const char* GetData() const;
+		/// <returns>Length of the view.</returns>
+		[[nodiscard]] size_t GetLength() const;
+		[[nodiscard]] bool IsEmpty() const;
 
-		bool operator==(StringView& other);
-		bool operator==(const char* other);
-		bool operator!=(StringView& other);
-		bool operator!=(const char* other);
+		[[nodiscard]] char operator[](size_t index) const;
+
+		/// <summary>
+		/// Gets a view over a part of this view. Does not copy anything.
+		/// </summary>
+		/// <param name="start">Index of the first character. Cannot exceed the length.</param>
+		/// <param name="length">Maximum amount of characters, clamped to the end of this view.</param>
+		/// <returns>View over the part.</returns>
+		[[nodiscard]] StringView Substr(size_t start, size_t length = SIZE_MAX) const;
+
+		/// <summary>
+		/// Finds the first occurrence of a character.
+		/// </summary>
+		/// <param name="c">Character to look for.</param>
+		/// <param name="start">Index from where to start looking.</param>
+		/// <returns>Index of the character, or SIZE_MAX if there is none.</returns>
+		[[nodiscard]] size_t Find(char c, size_t start = 0) const;
+		/// <summary>
+		/// Finds the first occurrence of a string.
+		/// </summary>
+		/// <param name="str">String to look for.</param>
+		/// <param name="start">Index from where to start looking.</param>
+		/// <returns>Index where the string starts, or SIZE_MAX if there is none.</returns>
+		[[nodiscard]] size_t Find(StringView str, size_t start = 0) const;
+		/// <summary>
+		/// Finds the first character that is equal to any of the given characters.
+		/// </summary>
+		/// <param name="chars">Characters to look for.</param>
+		/// <param name="start">Index from where to start looking.</param>
+		/// <returns>Index of the character, or SIZE_MAX if there is none.</returns>
+		[[nodiscard]] size_t FindAny(StringView chars, size_t start = 0) const;
+		/// <summary>
+		/// Compares the contents of two views in lexicographical order.
+		/// </summary>
+		/// <param name="other">View to compare with.</param>
+		/// <returns>Negative if this view comes first, positive if the other view comes first, and zero if they are equal.</returns>
+		[[nodiscard]] int Compare(StringView other) const;
+		[[nodiscard]] bool StartsWith(StringView str) const;
+		[[nodiscard]] bool EndsWith(StringView str) const;
+
+		/// <summary>
+		/// Splits the view on a delimiter and adds the parts to the vector. Does not copy any characters.
+		/// </summary>
+		/// <param name="delimiter">Character that separates the parts.</param>
+		/// <param name="outParts">Vector to add the parts to. Cannot exceed its capacity.</param>
+		/// <param name="skipEmpty">If empty parts, like between two adjacent delimiters, should be left out.</param>
+		/// <returns>Amount of parts added.</returns>
+		size_t Split(char delimiter, Vector<StringView>& outParts, bool skipEmpty = false) const;
+		/// <summary>
+		/// Splits the view on any of the delimiters and adds the parts to the vector. Does not copy any characters.
+		/// </summary>
+		/// <param name="delimiters">Characters that separate the parts.</param>
+		/// <param name="outParts">Vector to add the parts to. Cannot exceed its capacity.</param>
+		/// <param name="skipEmpty">If empty parts, like between two adjacent delimiters, should be left out.</param>
+		/// <returns>Amount of parts added.</returns>
+		size_t SplitAny(StringView delimiters, Vector<StringView>& outParts, bool skipEmpty = false) const;
+
+		[[nodiscard]] bool operator==(StringView other) const;
+		[[nodiscard]] bool operator==(const char* other) const;
+		[[nodiscard]] bool operator!=(StringView other) const;
+		[[nodiscard]] bool operator!=(const char* other) const;
 
 		operator const char* () const;
 
+		[[nodiscard]] const char* begin() const;
+		[[nodiscard]] const char* end() const;
+
 	private:
-		const char* _strLit = nullptr;
+		const char* _data = nullptr;
+		size_t _length = 0;
+
+		template <typename Finder>
+		size_t SplitWith(Vector<StringView>& outParts, bool skipEmpty, Finder finder) const;
 	};
 }
\ No newline at end of file
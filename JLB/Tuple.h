@@ -1,4 +1,8 @@
 #pragma once
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace jlb
 {
@@ -22,24 +26,342 @@ namespace jlb
 		template <size_t I, typename Head, typename ...Tail>
 		struct TupleImpl<I, Head, Tail...> : TupleLeaf<I, Head>, TupleImpl<I + 1, Tail...>
 		{
-			
+			constexpr TupleImpl() = default;
+			constexpr TupleImpl(const Head& head, const Tail&... tail) : TupleLeaf<I, Head>{ head }, TupleImpl<I + 1, Tail...>(tail...)
+			{
+
+			}
+		};
+
+		template <size_t I, typename Head, typename ...Tail>
+		struct TypeAt
+		{
+			using Type = typename TypeAt<I - 1, Tail...>::Type;
 		};
+
+		template <typename Head, typename ...Tail>
+		struct TypeAt<0, Head, Tail...>
+		{
+			using Type = Head;
+		};
+
+		template <size_t N>
+		struct IndexArray final
+		{
+			size_t values[N];
+		};
+
+		/// <summary>
+		/// Sorts the member indices by alignment, largest first. Members with the same alignment keep their order.
+		/// </summary>
+		template <typename ...Ts>
+		[[nodiscard]] constexpr IndexArray<sizeof...(Ts)> SortByAlignment()
+		{
+			constexpr size_t alignments[] = { alignof(Ts)... };
+			IndexArray<sizeof...(Ts)> order{};
+			for (size_t i = 0; i < sizeof...(Ts); ++i)
+				order.values[i] = i;
+
+			for (size_t i = 1; i < sizeof...(Ts); ++i)
+				for (size_t j = i; j > 0 && alignments[order.values[j - 1]] < alignments[order.values[j]]; --j)
+				{
+					const size_t temp = order.values[j];
+					order.values[j] = order.values[j - 1];
+					order.values[j - 1] = temp;
+				}
+
+			return order;
+		}
+
+		template <size_t N>
+		[[nodiscard]] constexpr IndexArray<N> Invert(const IndexArray<N>& order)
+		{
+			IndexArray<N> inverse{};
+			for (size_t i = 0; i < N; ++i)
+				inverse.values[order.values[i]] = i;
+			return inverse;
+		}
+	}
+
+	/// <summary>
+	/// Struct that can hold multiple different types.<br>
+	/// Members are laid out in declaration order, see PackedTuple for a layout without padding.
+	/// </summary>
+	/// <typeparam name="...Ts">Types to be held.</typeparam>
+	template <typename ...Ts>
+	using Tuple = tupleImpl::TupleImpl<0, Ts...>;
+
+	/// <summary>
+	/// Gets the value in the tuple at index I.
+	/// </summary>
+	/// <returns>Value at index I.</returns>
+	template <size_t I, typename Head, typename ...Tail>
+	[[nodiscard]] constexpr Head& Get(tupleImpl::TupleImpl<I, Head, Tail...>& tuple)
+	{
+		return static_cast<tupleImpl::TupleLeaf<I, Head>&>(tuple).value;
 	}
 
 	/// <summary>
 	/// Gets the value in the tuple at index I.
 	/// </summary>
 	/// <returns>Value at index I.</returns>
-	template<size_t I, typename Head, typename ...Tail>
-	[[nodiscard]] Head& Get(tupleImpl::TupleImpl<I, Head, Tail...>& tuple)
+	template <size_t I, typename Head, typename ...Tail>
+	[[nodiscard]] constexpr const Head& Get(const tupleImpl::TupleImpl<I, Head, Tail...>& tuple)
 	{
-		return tuple.TupleLeaf<I, Head>::value;
+		return static_cast<const tupleImpl::TupleLeaf<I, Head>&>(tuple).value;
 	}
 
 	/// <summary>
-	/// Struct that can hold multiple different types.
+	/// Gets the value in the tuple at index I.
+	/// </summary>
+	/// <returns>Value at index I.</returns>
+	template <size_t I, typename Head, typename ...Tail>
+	[[nodiscard]] constexpr Head&& Get(tupleImpl::TupleImpl<I, Head, Tail...>&& tuple)
+	{
+		return static_cast<Head&&>(static_cast<tupleImpl::TupleLeaf<I, Head>&>(tuple).value);
+	}
+
+	/// <summary>
+	/// Gets the value of type T in the tuple. The tuple has to hold exactly one value of this type.
+	/// </summary>
+	/// <returns>Value of type T.</returns>
+	template <typename T, size_t I, typename ...Tail>
+	[[nodiscard]] constexpr T& Get(tupleImpl::TupleImpl<I, T, Tail...>& tuple)
+	{
+		return static_cast<tupleImpl::TupleLeaf<I, T>&>(tuple).value;
+	}
+
+	/// <summary>
+	/// Gets the value of type T in the tuple. The tuple has to hold exactly one value of this type.
+	/// </summary>
+	/// <returns>Value of type T.</returns>
+	template <typename T, size_t I, typename ...Tail>
+	[[nodiscard]] constexpr const T& Get(const tupleImpl::TupleImpl<I, T, Tail...>& tuple)
+	{
+		return static_cast<const tupleImpl::TupleLeaf<I, T>&>(tuple).value;
+	}
+
+	/// <summary>
+	/// Struct that can hold multiple different types, like Tuple.<br>
+	/// Internally the members are ordered by alignment to minimize padding, while Get still uses the declaration order.
 	/// </summary>
 	/// <typeparam name="...Ts">Types to be held.</typeparam>
 	template <typename ...Ts>
-	using Tuple = tupleImpl::TupleImpl<0, Ts...>;
+	class PackedTuple final
+	{
+	public:
+		constexpr PackedTuple() = default;
+		constexpr PackedTuple(const Ts&... values);
+
+		/// <summary>
+		/// Gets the value at declaration index I.
+		/// </summary>
+		/// <returns>Value at index I.</returns>
+		template <size_t I>
+		[[nodiscard]] constexpr auto& Get();
+		/// <summary>
+		/// Gets the value at declaration index I.
+		/// </summary>
+		/// <returns>Value at index I.</returns>
+		template <size_t I>
+		[[nodiscard]] constexpr const auto& Get() const;
+
+	private:
+		// The declaration index of every member, in storage order.
+		static constexpr tupleImpl::IndexArray<sizeof...(Ts)> STORAGE_ORDER = tupleImpl::SortByAlignment<Ts...>();
+		// The storage index of every member, in declaration order.
+		static constexpr tupleImpl::IndexArray<sizeof...(Ts)> POSITIONS = tupleImpl::Invert(STORAGE_ORDER);
+
+		template <typename Sequence>
+		struct Storage;
+
+		template <size_t ...Is>
+		struct Storage<std::index_sequence<Is...>>
+		{
+			using Type = Tuple<typename tupleImpl::TypeAt<STORAGE_ORDER.values[Is], Ts...>::Type...>;
+
+			static constexpr Type Create(const Tuple<const Ts&...>& values)
+			{
+				return Type(jlb::Get<STORAGE_ORDER.values[Is]>(values)...);
+			}
+		};
+
+		using StorageType = Storage<std::index_sequence_for<Ts...>>;
+
+		typename StorageType::Type _storage{};
+	};
+
+	template <typename ...Ts>
+	constexpr PackedTuple<Ts...>::PackedTuple(const Ts&... values) : _storage(StorageType::Create(Tuple<const Ts&...>(values...)))
+	{
+
+	}
+
+	template <typename ...Ts>
+	template <size_t I>
+	constexpr auto& PackedTuple<Ts...>::Get()
+	{
+		return jlb::Get<POSITIONS.values[I]>(_storage);
+	}
+
+	template <typename ...Ts>
+	template <size_t I>
+	constexpr const auto& PackedTuple<Ts...>::Get() const
+	{
+		return jlb::Get<POSITIONS.values[I]>(_storage);
+	}
+
+	/// <summary>
+	/// Gets the value in the packed tuple at declaration index I.
+	/// </summary>
+	/// <returns>Value at index I.</returns>
+	template <size_t I, typename ...Ts>
+	[[nodiscard]] constexpr auto& Get(PackedTuple<Ts...>& tuple)
+	{
+		return tuple.template Get<I>();
+	}
+
+	/// <summary>
+	/// Gets the value in the packed tuple at declaration index I.
+	/// </summary>
+	/// <returns>Value at index I.</returns>
+	template <size_t I, typename ...Ts>
+	[[nodiscard]] constexpr const auto& Get(const PackedTuple<Ts...>& tuple)
+	{
+		return tuple.template Get<I>();
+	}
+
+	namespace tupleImpl
+	{
+		template <typename Function, typename TupleType, size_t ...Is>
+		constexpr decltype(auto) Apply(Function&& function, TupleType&& tuple, std::index_sequence<Is...>)
+		{
+			return function(Get<Is>(tuple)...);
+		}
+
+		template <typename Function, typename TupleType, size_t ...Is>
+		constexpr void ForEach(TupleType&& tuple, Function&& function, std::index_sequence<Is...>)
+		{
+			(function(Get<Is>(tuple)), ...);
+		}
+	}
+
+	/// <summary>
+	/// Calls the function with all the values of the tuple as arguments.
+	/// </summary>
+	/// <returns>Return value of the function.</returns>
+	template <typename Function, typename TupleType>
+	constexpr decltype(auto) Apply(Function&& function, TupleType&& tuple)
+	{
+		constexpr size_t size = std::tuple_size_v<std::remove_cv_t<std::remove_reference_t<TupleType>>>;
+		return tupleImpl::Apply(function, tuple, std::make_index_sequence<size>());
+	}
+
+	/// <summary>
+	/// Calls the function for every value of the tuple, in declaration order.<br>
+	/// Unrolled at compile time.
+	/// </summary>
+	template <typename TupleType, typename Function>
+	constexpr void ForEach(TupleType&& tuple, Function&& function)
+	{
+		constexpr size_t size = std::tuple_size_v<std::remove_cv_t<std::remove_reference_t<TupleType>>>;
+		tupleImpl::ForEach(tuple, function, std::make_index_sequence<size>());
+	}
+
+	namespace tupleImpl
+	{
+		template <typename TupleType, size_t ...Is>
+		[[nodiscard]] constexpr bool Equals(const TupleType& a, const TupleType& b, std::index_sequence<Is...>)
+		{
+			// Short circuits in declaration order.
+			return ((Get<Is>(a) == Get<Is>(b)) && ...);
+		}
+
+		/// <summary>
+		/// Compares the values of both tuples, in declaration order.
+		/// </summary>
+		template <typename ...Ts>
+		[[nodiscard]] constexpr bool operator==(const TupleImpl<0, Ts...>& a, const TupleImpl<0, Ts...>& b)
+		{
+			return Equals(a, b, std::index_sequence_for<Ts...>());
+		}
+
+		template <typename ...Ts>
+		[[nodiscard]] constexpr bool operator!=(const TupleImpl<0, Ts...>& a, const TupleImpl<0, Ts...>& b)
+		{
+			return !(a == b);
+		}
+	}
+
+	/// <summary>
+	/// Compares the values of both tuples, in declaration order rather than storage order.
+	/// </summary>
+	template <typename ...Ts>
+	[[nodiscard]] constexpr bool operator==(const PackedTuple<Ts...>& a, const PackedTuple<Ts...>& b)
+	{
+		return tupleImpl::Equals(a, b, std::index_sequence_for<Ts...>());
+	}
+
+	template <typename ...Ts>
+	[[nodiscard]] constexpr bool operator!=(const PackedTuple<Ts...>& a, const PackedTuple<Ts...>& b)
+	{
+		return !(a == b);
+	}
+
+	namespace tupleImpl
+	{
+		// Structured bindings look for a lowercase get.
+		template <size_t I, typename ...Ts>
+		constexpr decltype(auto) get(TupleImpl<0, Ts...>& tuple)
+		{
+			return Get<I>(tuple);
+		}
+
+		template <size_t I, typename ...Ts>
+		constexpr decltype(auto) get(const TupleImpl<0, Ts...>& tuple)
+		{
+			return Get<I>(tuple);
+		}
+	}
+
+	// Structured bindings look for a lowercase get.
+	template <size_t I, typename ...Ts>
+	constexpr decltype(auto) get(PackedTuple<Ts...>& tuple)
+	{
+		return tuple.template Get<I>();
+	}
+
+	template <size_t I, typename ...Ts>
+	constexpr decltype(auto) get(const PackedTuple<Ts...>& tuple)
+	{
+		return tuple.template Get<I>();
+	}
+}
+
+// Make the tuples usable with structured bindings.
+namespace std
+{
+	template <typename ...Ts>
+	struct tuple_size<jlb::tupleImpl::TupleImpl<0, Ts...>> : integral_constant<size_t, sizeof...(Ts)>
+	{
+
+	};
+
+	template <size_t I, typename ...Ts>
+	struct tuple_element<I, jlb::tupleImpl::TupleImpl<0, Ts...>>
+	{
+		using type = typename jlb::tupleImpl::TypeAt<I, Ts...>::Type;
+	};
+
+	template <typename ...Ts>
+	struct tuple_size<jlb::PackedTuple<Ts...>> : integral_constant<size_t, sizeof...(Ts)>
+	{
+
+	};
+
+	template <size_t I, typename ...Ts>
+	struct tuple_element<I, jlb::PackedTuple<Ts...>>
+	{
+		using type = typename jlb::tupleImpl::TypeAt<I, Ts...>::Type;
+	};
 }
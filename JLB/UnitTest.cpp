@@ -10,9 +10,78 @@
 #include "HashMap.h"
 #include "Heap.h"
 #include "Tuple.h"
+#include "InlineVector.h"
+#include "InlineStack.h"
+#include "Queue.h"
+#include "SPSCQueue.h"
+#include "MPMCQueue.h"
+#include "WorkStealingDeque.h"
+#include "Scheduler.h"
+#include "Algorithms.h"
+#include "Kernels.h"
+#include "SoAVector.h"
+#include "SparseSet.h"
+#include "ArenaString.h"
+#include "StringTable.h"
+#include "BitArray.h"
+#include "BloomFilter.h"
+#include "BTree.h"
+#include "ClockCache.h"
+#include "FilteredHashMap.h"
+#include "FlatMap.h"
+#include "FrameAllocator.h"
+#include "MappedArena.h"
+#include "OffsetHashMap.h"
+#include "Snapshot.h"
+#include "StaticMap.h"
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <new>
 
 namespace jlb
 {
+	namespace
+	{
+		// Points to memory from an allocator, so snapshots have to go through its serializer.
+		struct SnapshotName final
+		{
+			char* text = nullptr;
+
+			SnapshotName() = default;
+			SnapshotName(const SnapshotName& other) = default;
+
+			SnapshotName& operator=(const SnapshotName& other)
+			{
+				text = other.text;
+				return *this;
+			}
+		};
+	}
+
+	template <>
+	struct SnapshotSerializer<SnapshotName> final
+	{
+		static void Write(SnapshotWriter& writer, SnapshotName& name)
+		{
+			const uint64_t length = strlen(name.text);
+			writer.WriteValue(length);
+			writer.WriteBytes(name.text, static_cast<size_t>(length));
+		}
+
+		static bool Read(SnapshotReader& reader, LinearAllocator& allocator, SnapshotName& name)
+		{
+			uint64_t length;
+			if (!reader.ReadValue(length))
+				return false;
+			name.text = allocator.New<char>(static_cast<size_t>(length) + 1);
+			name.text[length] = '\0';
+			return reader.ReadBytes(name.text, static_cast<size_t>(length));
+		}
+	};
+
 	void UnitTest::Run()
 	{
 		// Test linear allocator malloc/free.
@@ -75,6 +144,111 @@ namespace jlb
 			allocator.Free();
 		}
 
+		// Frame allocator.
+		{
+			// The frame allocators themselves are allocated too.
+			LinearAllocator allocator{ 3 * (sizeof(LinearAllocator) + 256) + 1024 };
+			const size_t available = allocator.GetAvailableMemorySpace();
+
+			FrameAllocator frames{};
+			frames.Allocate(allocator, 3, 256);
+			assert(frames.GetFrameCount() == 3);
+
+			int* pointers[3];
+			for (int frame = 0; frame < 3; ++frame)
+			{
+				if (frame > 0)
+					frames.BeginFrame();
+				pointers[frame] = frames.New<int>(4);
+				*pointers[frame] = frame;
+
+				// Containers can be allocated from a frame, and are dropped with it.
+				Vector<int> vector{};
+				vector.Allocate(frames.GetCurrent(), 8);
+				vector.Add(frame);
+			}
+
+			// Everything from the frames still in flight is untouched.
+			for (int frame = 0; frame < 3; ++frame)
+				assert(*pointers[frame] == frame);
+			assert(&frames.GetPrevious(2) != &frames.GetCurrent());
+
+			// Starting a fourth frame reuses the region of the first one.
+			const size_t frameSpace = frames.GetCurrent().GetAvailableMemorySpace();
+			LinearAllocator& frame = frames.BeginFrame();
+			assert(frames.GetFrameIndex() == 3);
+			assert(frame.GetAvailableMemorySpace() > frameSpace);
+			[[maybe_unused]] const int* reused = frames.New<int>(4);
+			assert(reused == pointers[0]);
+			assert(*pointers[1] == 1 && *pointers[2] == 2);
+
+			frames.Free(allocator);
+			assert(allocator.GetAvailableMemorySpace() == available);
+		}
+
+		// Allocator statistics.
+		{
+			LinearAllocator allocator{ 4096 };
+			{
+				JLB_ALLOCATOR_TAG(allocator, "Physics");
+				const void* physicsPtr = allocator.Malloc(64);
+				assert(allocator.IsTop(physicsPtr));
+				{
+					JLB_ALLOCATOR_TAG(allocator, "Audio");
+					const void* audioPtr = allocator.Malloc(100);
+					assert(allocator.IsTop(audioPtr));
+				}
+				void* ptr = allocator.Malloc(8);
+				[[maybe_unused]] const bool resized = allocator.TryResize(ptr, 32);
+				assert(resized);
+			}
+			const void* untaggedPtr = allocator.Malloc(16);
+			assert(allocator.IsTop(untaggedPtr));
+
+#ifdef JLB_ALLOCATOR_STATS
+			// Every allocation takes up an extra chunk for its size metadata, and sizes are rounded up to whole chunks.
+			constexpr size_t chunk = sizeof(size_t);
+			const size_t used = (64 + 104 + 32 + 16) + 4 * chunk;
+			assert(allocator.GetStats().usedBytes == used);
+			assert(allocator.GetStats().peakBytes == used);
+			assert(allocator.GetStats().mallocCount == 4);
+			assert(allocator.GetTagCount() == 3);
+
+			const AllocatorTagStats* physics = allocator.FindTagStats("Physics");
+			assert(physics && physics->usedBytes == 64 + 32 + 2 * chunk && physics->mallocCount == 2);
+			assert(allocator.FindTagStats("Audio")->usedBytes == 104 + chunk);
+			assert(allocator.FindTagStats(nullptr)->usedBytes == 16 + chunk);
+			assert(!allocator.FindTagStats("Rendering"));
+#endif
+
+			allocator.Free();
+			allocator.Free();
+
+#ifdef JLB_ALLOCATOR_STATS
+			assert(allocator.GetStats().usedBytes == 64 + 104 + 2 * chunk);
+			assert(allocator.GetStats().peakBytes == used);
+			assert(allocator.GetTraceEvent(allocator.GetTraceCount() - 1).event == AllocatorEvent::Free);
+			assert(physics->peakBytes == 64 + 32 + 2 * chunk);
+			assert(physics->totalBytes == 64 + 32 + 2 * chunk);
+
+			// The trace keeps the newest events when it overflows.
+			for (size_t i = 0; i < JLB_ALLOCATOR_TRACE_SIZE; ++i)
+			{
+				const void* tracedPtr = allocator.Malloc(8);
+				assert(allocator.IsTop(tracedPtr));
+				allocator.Free();
+			}
+			assert(allocator.GetTraceCount() == JLB_ALLOCATOR_TRACE_SIZE);
+			const AllocatorTraceEvent& last = allocator.GetTraceEvent(JLB_ALLOCATOR_TRACE_SIZE - 1);
+			assert(last.event == AllocatorEvent::Free && last.size == 8 && last.offset == 64 + 104 + 2 * chunk);
+			assert(allocator.GetTraceEvent(0).sequence + JLB_ALLOCATOR_TRACE_SIZE - 1 == last.sequence);
+#endif
+
+			allocator.Free();
+			allocator.Free();
+			assert(allocator.GetAvailableMemorySpace() == LinearAllocator{ 4096 }.GetAvailableMemorySpace());
+		}
+
 		// Test array view.
 		{
 			struct TestStruct final
@@ -150,6 +324,149 @@ namespace jlb
 			}
 		}
 
+		// Iterator.
+		{
+			static_assert(sizeof(Iterator<int>) == sizeof(int*));
+			static_assert(std::is_same_v<std::iterator_traits<Iterator<int>>::iterator_category, std::random_access_iterator_tag>);
+
+			LinearAllocator allocator{ 1024 };
+			Vector<int> vec{};
+			vec.Allocate(allocator, 32);
+			for (size_t i = 0; i < 20; ++i)
+				vec.Add(rand() % 100);
+
+			std::sort(vec.begin(), vec.end());
+			assert(std::is_sorted(vec.begin(), vec.end()));
+			assert(vec.end() - vec.begin() == 20);
+
+			const auto it = std::lower_bound(vec.begin(), vec.end(), 50);
+			assert(it == vec.end() || *it >= 50);
+			assert(it == vec.begin() || it[-1] < 50);
+
+			auto reverse = vec.end();
+			--reverse;
+			assert(*reverse == vec[19]);
+			assert(&*(vec.begin() + 5) == &vec[5]);
+		}
+
+		// Vector bulk operations.
+		{
+			LinearAllocator allocator{ 1024 };
+			Vector<int> vec{};
+			vec.Allocate(allocator, 16);
+
+			int values[] = { 1, 2, 3, 4 };
+			vec.AddRange(values, 4);
+			assert(vec.GetCount() == 4);
+
+			Array<int> arr{};
+			arr.Allocate(allocator, 2, 7);
+			vec.AddRange(arr);
+			assert(vec.GetCount() == 6);
+			assert(vec[4] == 7 && vec[5] == 7);
+
+			vec.InsertAt(0, 0);
+			vec.InsertAt(vec.GetCount(), 8);
+			assert(vec[0] == 0 && vec[1] == 1 && vec[7] == 8);
+
+			vec.RemoveAtStable(1);
+			assert(vec[0] == 0 && vec[1] == 2 && vec[2] == 3);
+
+			const size_t removed = vec.RemoveIf([](int& i)
+				{
+					return i == 7;
+				});
+			assert(removed == 2);
+			assert(vec.GetCount() == 5);
+			for (size_t i = 1; i < vec.GetCount(); ++i)
+				assert(vec[i - 1] < vec[i]);
+
+			vec.Clear();
+			assert(vec.GetCount() == 0);
+			assert(vec.begin() == vec.end());
+		}
+
+		// Growable vector.
+		{
+			LinearAllocator allocator{ 1024 };
+			const size_t remaining = allocator.GetAvailableMemorySpace();
+
+			// Grows in place while it is the newest allocation.
+			Vector<int> vec{};
+			vec.AllocateGrowable(allocator, 2);
+			int* data = vec.GetData();
+			for (int i = 0; i < 20; ++i)
+				vec.Add(i);
+			assert(vec.GetData() == data);
+			assert(vec.GetLength() >= 20);
+
+			// Moves when something else has been allocated on top of it.
+			Array<int> arr{};
+			arr.Allocate(allocator, 4);
+			vec.AddRange(data, 20);
+			assert(vec.GetData() != data);
+			assert(vec.GetCount() == 40);
+			for (int i = 0; i < 40; ++i)
+				assert(vec[i] == i % 20);
+
+			// Freeing everything also frees the memory left behind.
+			vec.Free(allocator);
+			arr.Free(allocator);
+			assert(remaining == allocator.GetAvailableMemorySpace());
+			assert(vec.GetCount() == 0);
+
+			// Allocating again with a fixed capacity starts out empty.
+			vec.Allocate(allocator, 4);
+			assert(vec.GetCount() == 0 && vec.GetLength() == 4);
+			vec.Free(allocator);
+		}
+
+		// Inline containers.
+		{
+			InlineVector<int, 4> vec{};
+			vec.Add(1);
+			vec.Add(2);
+			vec.InsertAt(0, 0);
+			assert(vec.GetCount() == 3);
+			assert(!vec.IsSpilled());
+
+			int n = 0;
+			for (auto& i : vec)
+				assert(i == n++);
+
+			InlineStack<int, 4> stack{};
+			stack.Push(1);
+			stack.Push(2);
+			[[maybe_unused]] const int popped = stack.Pop();
+			assert(popped == 2);
+			assert(stack.Peek() == 1);
+
+			LinearAllocator allocator{ 1024 };
+			const size_t remaining = allocator.GetAvailableMemorySpace();
+
+			InlineVector<int, 4> spilling{ allocator };
+			for (int i = 0; i < 4; ++i)
+				spilling.Add(i);
+			assert(!spilling.IsSpilled());
+			assert(remaining == allocator.GetAvailableMemorySpace());
+
+			for (int i = 4; i < 12; ++i)
+				spilling.Add(i);
+			assert(spilling.IsSpilled());
+			for (int i = 0; i < 12; ++i)
+				assert(spilling[i] == i);
+
+			spilling.Free(allocator);
+			assert(!spilling.IsSpilled());
+			assert(spilling.GetCount() == 0);
+			assert(remaining == allocator.GetAvailableMemorySpace());
+
+			// Freeing clears the vector even when it never left the inline memory.
+			vec.Free(allocator);
+			assert(vec.GetCount() == 0 && !vec.IsSpilled());
+			assert(remaining == allocator.GetAvailableMemorySpace());
+		}
+
 		// Strings.
 		{
 			jlb::StringView string = "hello";
@@ -160,6 +477,54 @@ namespace jlb
 			assert(s3 == string);
 			assert(s2 == "bye");
 			std::cout << s2 << std::endl;
+
+			// Equal contents from different memory compare equal.
+			char runtime[] = "hello";
+			assert(StringView(runtime) == string);
+			assert(string.GetLength() == 5);
+
+			StringView line = "key = value; other=  thing;;last";
+			assert(line.Find('=') == 4);
+			assert(line.Find('=', 5) == 18);
+			assert(line.Find("other") == 13);
+			assert(line.Find("missing") == SIZE_MAX);
+			assert(line.FindAny(";=") == 4);
+			assert(line.Substr(6, 5) == "value");
+			assert(line.Substr(28) == "last");
+			assert(line.StartsWith("key") && line.EndsWith("last"));
+			assert(StringView("abc").Compare("abd") < 0);
+			assert(StringView("abc").Compare("ab") > 0);
+			assert(StringView("abc").Compare("abc") == 0);
+
+			LinearAllocator allocator{ 1024 };
+			Vector<StringView> parts{};
+			parts.Allocate(allocator, 8);
+			assert(line.Split(';', parts) == 4);
+			assert(parts[0] == "key = value" && parts[1] == " other=  thing" && parts[2].IsEmpty() && parts[3] == "last");
+			// The parts point into the original memory.
+			assert(parts[3].GetData() == line.GetData() + 28);
+			parts.Clear();
+			assert(line.SplitAny(" =;", parts, true) == 5);
+			assert(parts[0] == "key" && parts[1] == "value" && parts[2] == "other" && parts[3] == "thing" && parts[4] == "last");
+			parts.Free(allocator);
+
+			// Long enough to go through the vectorized paths.
+			char text[200];
+			for (size_t i = 0; i < sizeof text; ++i)
+				text[i] = 'a' + i % 3;
+			text[150] = 'x';
+			text[151] = 'y';
+			text[152] = 'z';
+			const StringView long0{ text, sizeof text };
+			assert(long0.Find('x') == 150);
+			assert(long0.Find("xyz") == 150);
+			assert(long0.FindAny("zyx") == 150);
+			char copy[200];
+			memcpy(copy, text, sizeof text);
+			assert(long0 == StringView(copy, sizeof copy));
+			copy[170] = 'q';
+			assert(long0 != StringView(copy, sizeof copy));
+			assert(long0.Compare(StringView(copy, sizeof copy)) < 0);
 		}
 
 		// Stacks.
@@ -178,6 +543,391 @@ namespace jlb
 			assert(stack.Peek() == i);
 		}
 
+		// Queues.
+		{
+			LinearAllocator allocator{ 1024 };
+			Queue<int> queue{};
+			queue.Allocate(allocator, 4);
+
+			// Wrap around the ring buffer a few times.
+			for (int i = 0; i < 10; ++i)
+			{
+				queue.Enqueue(i);
+				queue.Enqueue(i + 1);
+				assert(queue.Peek() == i);
+				[[maybe_unused]] const int first = queue.Dequeue();
+				[[maybe_unused]] const int second = queue.Dequeue();
+				assert(first == i && second == i + 1);
+			}
+			assert(queue.GetCount() == 0);
+
+			// Fill it to the capacity while the front is in the middle of the memory.
+			queue.Enqueue(0);
+			queue.Enqueue(0);
+			queue.Dequeue();
+			queue.Dequeue();
+			for (int i = 0; i < 4; ++i)
+				queue.Enqueue(i);
+			for (int i = 0; i < 4; ++i)
+			{
+				[[maybe_unused]] const int value = queue.Dequeue();
+				assert(value == i);
+			}
+			assert(queue.GetCount() == 0);
+		}
+
+		// Single producer single consumer queue.
+		{
+			LinearAllocator allocator{ 1024 };
+			SPSCQueue<int> queue{};
+			queue.Allocate(allocator, 12);
+			assert(queue.GetCapacity() == 16);
+
+			int batch[8];
+			for (int i = 0; i < 8; ++i)
+				batch[i] = i;
+			[[maybe_unused]] const size_t firstBatch = queue.TryEnqueue(batch, 8);
+			[[maybe_unused]] const size_t secondBatch = queue.TryEnqueue(batch, 8);
+			assert(firstBatch == 8 && secondBatch == 8);
+			[[maybe_unused]] const bool overflowed = queue.TryEnqueue(0);
+			assert(!overflowed);
+			[[maybe_unused]] const size_t dequeued = queue.TryDequeue(batch, 4);
+			assert(dequeued == 4);
+			assert(queue.GetCount() == 12);
+			while (queue.TryDequeue(batch, 8) > 0);
+
+			constexpr int amount = 100000;
+			std::thread producer{ [&queue]
+			{
+				for (int i = 0; i < amount; ++i)
+					while (!queue.TryEnqueue(i))
+						std::this_thread::yield();
+			} };
+
+			for (int i = 0; i < amount; ++i)
+			{
+				int value;
+				while (!queue.TryDequeue(value))
+					std::this_thread::yield();
+				assert(value == i);
+			}
+
+			producer.join();
+		}
+
+		// Multi producer multi consumer queue.
+		{
+			LinearAllocator allocator{ 4096 };
+			MPMCQueue<int> queue{};
+			queue.Allocate(allocator, 64);
+
+			constexpr int amount = 50000;
+			std::atomic<long long> sum{ 0 };
+			std::atomic<int> consumed{ 0 };
+
+			auto produce = [&queue]
+			{
+				for (int i = 1; i <= amount; ++i)
+					while (!queue.TryEnqueue(i))
+						std::this_thread::yield();
+			};
+			auto consume = [&queue, &sum, &consumed]
+			{
+				while (consumed.load() < amount * 2)
+				{
+					int value;
+					if (!queue.TryDequeue(value))
+					{
+						std::this_thread::yield();
+						continue;
+					}
+					sum += value;
+					++consumed;
+				}
+			};
+
+			std::thread threads[] = { std::thread{ produce }, std::thread{ produce }, std::thread{ consume }, std::thread{ consume } };
+			for (auto& thread : threads)
+				thread.join();
+
+			assert(sum.load() == static_cast<long long>(amount) * (amount + 1));
+		}
+
+		// Work stealing deque.
+		{
+			LinearAllocator allocator{ 1024 };
+			WorkStealingDeque<int> deque{};
+			deque.Allocate(allocator, 8);
+
+			// Bind the results first, so that the operations also run when assert is disabled.
+			for (int i = 0; i < 8; ++i)
+			{
+				[[maybe_unused]] const bool pushed = deque.Push(i);
+				assert(pushed);
+			}
+			[[maybe_unused]] const bool overflowed = deque.Push(8);
+			assert(!overflowed);
+
+			int value;
+			[[maybe_unused]] const bool popped = deque.Pop(value);
+			assert(popped && value == 7);
+			[[maybe_unused]] const bool stolenOldest = deque.Steal(value);
+			assert(stolenOldest && value == 0);
+			assert(deque.GetCount() == 6);
+			while (deque.Pop(value));
+			[[maybe_unused]] const bool stolenFromEmpty = deque.Steal(value);
+			assert(!stolenFromEmpty);
+
+			// Let thieves race the owner, and check that every value is taken exactly once.
+			constexpr int amount = 20000;
+			LinearAllocator large{ sizeof(int) * amount * 8 };
+			WorkStealingDeque<int> shared{};
+			shared.Allocate(large, amount);
+			std::atomic<long long> sum{ 0 };
+			std::atomic<bool> done{ false };
+
+			auto steal = [&shared, &sum, &done]
+			{
+				int stolen;
+				while (!done.load())
+				{
+					if (shared.Steal(stolen))
+						sum += stolen;
+					else
+						std::this_thread::yield();
+				}
+			};
+
+			std::thread thieves[] = { std::thread{ steal }, std::thread{ steal } };
+			for (int i = 1; i <= amount; ++i)
+			{
+				[[maybe_unused]] const bool pushed = shared.Push(i);
+				assert(pushed);
+				if (i % 3 == 0 && shared.Pop(value))
+					sum += value;
+			}
+			while (shared.Pop(value))
+				sum += value;
+			while (shared.GetCount() > 0)
+				std::this_thread::yield();
+			done = true;
+			for (auto& thief : thieves)
+				thief.join();
+
+			assert(sum.load() == static_cast<long long>(amount) * (amount + 1) / 2);
+		}
+
+		// Scheduler.
+		{
+			LinearAllocator allocator{ 131072 };
+			Scheduler scheduler{};
+			scheduler.Allocate(allocator, 4, 256);
+			assert(scheduler.GetWorkerCount() == 4);
+
+			Array<int> array{};
+			array.Allocate(allocator, 1000, 1);
+			for (int i = 0; i < 3; ++i)
+				scheduler.ParallelFor(array, 0, array.GetLength(), [](int& value, LinearAllocator& scratch)
+					{
+						// Use the scratch allocator to make sure it is private to the worker.
+						int* temp = scratch.New<int>();
+						*temp = value * 2;
+						value = *temp;
+						scratch.Free();
+					}, 16);
+			for (auto& value : array)
+				assert(value == 8);
+
+			std::atomic<size_t> sum{ 0 };
+			scheduler.ParallelFor(0, 10000, [&sum](const size_t index, LinearAllocator&)
+				{
+					sum += index;
+				});
+			assert(sum.load() == 10000 * 9999 / 2);
+
+			// A grain size of 0 still stops splitting at a single index.
+			sum = 0;
+			scheduler.ParallelFor(0, 1, [&sum](const size_t index, LinearAllocator&)
+				{
+					sum += index + 1;
+				}, 0);
+			assert(sum.load() == 1);
+			scheduler.ParallelFor(0, 100, [&sum](const size_t index, LinearAllocator&)
+				{
+					sum += index;
+				}, 0);
+			assert(sum.load() == 1 + 100 * 99 / 2);
+			scheduler.ParallelFor(0, 0, [&sum](const size_t, LinearAllocator&)
+				{
+					++sum;
+				}, 0);
+			assert(sum.load() == 1 + 100 * 99 / 2);
+
+			array.Free(allocator);
+			scheduler.Free(allocator);
+		}
+
+		// Sorting.
+		{
+			LinearAllocator allocator{ 131072 };
+
+			// Radix sort on signed integers.
+			Vector<int> ints{};
+			ints.Allocate(allocator, 500);
+			for (size_t i = 0; i < 400; ++i)
+				ints.Add(rand() % 2000 - 1000);
+			RadixSort(ints, allocator);
+			assert(std::is_sorted(ints.begin(), ints.end()));
+			assert(ints.GetCount() == 400);
+
+			// Radix sort on floating point values.
+			Array<float> floats{};
+			floats.Allocate(allocator, 300);
+			for (auto& f : floats)
+				f = static_cast<float>(rand() % 2000 - 1000) / 7.f;
+			RadixSort(floats, allocator);
+			assert(std::is_sorted(floats.begin(), floats.end()));
+
+			// Radix sort on a key.
+			struct Record final
+			{
+				uint32_t key;
+				size_t order;
+			};
+
+			Array<Record> records{};
+			records.Allocate(allocator, 300);
+			for (size_t i = 0; i < records.GetLength(); ++i)
+				records[i] = { static_cast<uint32_t>(rand() % 50), i };
+			RadixSort(records, allocator, [](const Record& record)
+				{
+					return record.key;
+				});
+			// Radix sort is stable.
+			for (size_t i = 1; i < records.GetLength(); ++i)
+				assert(records[i - 1].key < records[i].key || 
+					(records[i - 1].key == records[i].key && records[i - 1].order < records[i].order));
+
+			// Comparison sort on random, sorted, reversed and duplicate heavy input.
+			Array<int> sorted{};
+			sorted.Allocate(allocator, 1000);
+			for (size_t pattern = 0; pattern < 4; ++pattern)
+			{
+				for (size_t i = 0; i < sorted.GetLength(); ++i)
+				{
+					const int index = static_cast<int>(i);
+					const int values[] = { rand(), index, -index, rand() % 4 };
+					sorted[i] = values[pattern];
+				}
+				Sort(sorted);
+				assert(std::is_sorted(sorted.begin(), sorted.end()));
+			}
+			Sort(sorted, std::greater<int>());
+			assert(std::is_sorted(sorted.begin(), sorted.end(), std::greater<int>()));
+
+			// Partitioning.
+			for (auto& i : sorted)
+				i = rand() % 100;
+			const size_t split = Partition(sorted, [](const int i)
+				{
+					return i < 50;
+				});
+			for (size_t i = 0; i < sorted.GetLength(); ++i)
+				assert((sorted[i] < 50) == (i < split));
+
+			NthElement(sorted, 500);
+			const int nth = sorted[500];
+			for (size_t i = 0; i < sorted.GetLength(); ++i)
+				assert(i < 500 ? sorted[i] <= nth : sorted[i] >= nth);
+
+			sorted.Free(allocator);
+			records.Free(allocator);
+			floats.Free(allocator);
+			ints.Free(allocator);
+
+			// Parallel sort.
+			Scheduler scheduler{};
+			scheduler.Allocate(allocator, 4, 256);
+
+			LinearAllocator large{ sizeof(int) * 50000 * 2 + 1024 };
+			Array<int> values{};
+			values.Allocate(large, 50000);
+			for (auto& i : values)
+				i = rand();
+			ParallelSort(values, scheduler, large);
+			assert(std::is_sorted(values.begin(), values.end()));
+
+			scheduler.Free(allocator);
+		}
+
+		// Kernels.
+		{
+			LinearAllocator allocator{ 8192 };
+
+			// Odd lengths to also cover the scalar remainders.
+			for (size_t length = 1; length < 70; length += 7)
+			{
+				Array<int32_t> ints{};
+				ints.Allocate(allocator, length);
+				Array<float> floats{};
+				floats.Allocate(allocator, length);
+
+				for (size_t i = 0; i < length; ++i)
+				{
+					ints[i] = rand() % 200 - 100;
+					floats[i] = static_cast<float>(ints[i]) * .5f;
+				}
+
+				int32_t minInt, maxInt;
+				MinMax(ints, minInt, maxInt);
+				float minFloat, maxFloat;
+				MinMax(floats, minFloat, maxFloat);
+
+				int64_t sum = 0;
+				size_t count = 0;
+				size_t first = SIZE_MAX;
+				const int32_t target = ints[length / 2];
+				for (size_t i = 0; i < length; ++i)
+				{
+					sum += ints[i];
+					count += ints[i] == target;
+					first = first == SIZE_MAX && ints[i] == target ? i : first;
+				}
+
+				assert(minInt == *std::min_element(ints.begin(), ints.end()));
+				assert(maxInt == *std::max_element(ints.begin(), ints.end()));
+				assert(minFloat == static_cast<float>(minInt) * .5f);
+				assert(maxFloat == static_cast<float>(maxInt) * .5f);
+				assert(Sum(ints) == sum);
+				assert(Sum(floats) == static_cast<float>(sum) * .5f);
+				assert(Find(ints, target) == first);
+				assert(Find(floats, static_cast<float>(target) * .5f) == first);
+				assert(Find(ints, 1000) == SIZE_MAX);
+				assert(Count(ints, target) == count);
+				assert(Count(floats, static_cast<float>(target) * .5f) == count);
+
+				Fill(ints, 3);
+				assert(Count(ints, 3) == length);
+				assert(Sum(ints) == static_cast<int64_t>(length) * 3);
+
+				floats.Free(allocator);
+				ints.Free(allocator);
+			}
+
+			// Types without a vectorized implementation.
+			Array<uint8_t> bytes{};
+			bytes.Allocate(allocator, 33, 7);
+			assert(Count(bytes, static_cast<uint8_t>(7)) == 33);
+			assert(Sum(bytes) == 33 * 7);
+
+			Array<uint8_t> other{};
+			other.Allocate(allocator, 33, 7);
+			assert(Compare(bytes, other));
+			other[32] = 8;
+			assert(!Compare(bytes, other));
+			assert(Find(other, static_cast<uint8_t>(8)) == 32);
+		}
+
 		// Hashmap.
 		{
 			LinearAllocator allocator{ 1024 };
@@ -227,6 +977,12 @@ namespace jlb
 
 			hashMap.Insert(t);
 			assert(hashMap.Contains(t));
+
+			// Reallocating starts over with an empty map.
+			hashMap.Free(allocator);
+			hashMap.Allocate(allocator, 20);
+			assert(hashMap.GetCount() == 0);
+			assert(!hashMap.Contains(t));
 		}
 
 		// Heap.
@@ -261,6 +1017,67 @@ namespace jlb
 			assert(heap.GetCount() == 0);
 		}
 
+#ifdef JLB_CONTAINER_STATS
+		// Container statistics.
+		{
+			LinearAllocator allocator{ 1024 };
+
+			HashMap<size_t> hashMap{};
+			hashMap.Allocate(allocator, 8);
+			hashMap.hasher = [](size_t& value)
+			{
+				return value;
+			};
+
+			// 9 collides with 1, and pushes 2 out of its home slot.
+			hashMap.Insert(1);
+			hashMap.Insert(9);
+			hashMap.Insert(2);
+			size_t value = 9;
+			assert(hashMap.Contains(value));
+
+			const HashMapStats& stats = hashMap.GetStats();
+			assert(stats.misses.count == 3 && stats.misses.max == 8);
+			assert(stats.inserts.count == 3 && stats.inserts.total == 5 && stats.inserts.buckets[2] == 2);
+			assert(stats.hits.count == 1 && stats.hits.max == 2);
+
+			const HashMapLayout layout = hashMap.GetLayout();
+			assert(layout.count == 3 && layout.capacity == 8);
+			assert(layout.longestCluster == 3);
+			assert(layout.probes.total == 5 && layout.probes.max == 2);
+
+			hashMap.ResetStats();
+			assert(hashMap.GetStats().hits.count == 0);
+
+			Heap<size_t> heap{};
+			heap.Allocate(allocator, 8);
+			heap.hasher = [](size_t& value)
+			{
+				return value;
+			};
+
+			// Every new value is the smallest, so it sifts all the way up.
+			for (size_t i = 5; i > 0; --i)
+				heap.Insert(i);
+			assert(heap.GetStats().swaps == 6);
+			assert(heap.GetStats().siftUps.max == 2);
+			[[maybe_unused]] const size_t popped = heap.Pop();
+			assert(popped == 1);
+			assert(heap.GetStats().siftDowns.count == 1);
+
+			FILE* file = tmpfile();
+			assert(file);
+			WriteCsv(file, "map", hashMap.GetStats());
+			WriteCsv(file, "map", layout);
+			WriteCsv(file, "heap", heap.GetStats());
+			assert(ftell(file) > 0);
+			fclose(file);
+
+			heap.Free(allocator);
+			hashMap.Free(allocator);
+		}
+#endif
+
 		// Tuple.
 		{
 			struct TestStruct final
@@ -277,6 +1094,880 @@ namespace jlb
 			Get<2>(tuple).i = 6;
 			assert(Get<0>(tuple) == 5);
 			assert(Get<2>(tuple).i == 6);
+
+			Tuple<int, float, char> values{ 1, 2.5f, 'c' };
+			assert(Get<float>(values) == 2.5f);
+			Get<char>(values) = 'd';
+			auto& [i, f, c] = values;
+			assert(i == 1 && f == 2.5f && c == 'd');
+			i = 3;
+			assert(Get<0>(values) == 3);
+
+			const float applied = Apply([](const int a, const float b, const char) { return a + b; }, values);
+			assert(applied == 5.5f);
+			int visited = 0;
+			ForEach(values, [&visited](auto&) { ++visited; });
+			assert(visited == 3);
+
+			constexpr Tuple<int, char> constant{ 4, 'a' };
+			static_assert(Get<0>(constant) == 4);
+			static_assert(sizeof(Tuple<int>) == sizeof(int));
+
+			static_assert(sizeof(PackedTuple<char, double, char, int>) < sizeof(Tuple<char, double, char, int>));
+			PackedTuple<char, double, char, int> packed{ 'a', 1.5, 'b', 7 };
+			assert(Get<0>(packed) == 'a');
+			assert(Get<1>(packed) == 1.5);
+			assert(Get<2>(packed) == 'b');
+			assert(Get<3>(packed) == 7);
+			Get<3>(packed) = 8;
+			auto& [pa, pd, pb, pi] = packed;
+			assert(pa == 'a' && pd == 1.5 && pb == 'b' && pi == 8);
+
+			PackedTuple<char, double> defaulted{};
+			assert(Get<0>(defaulted) == 0 && Get<1>(defaulted) == 0);
+
+			// Tuples compare element wise, so they can be stored in a HashMap.
+			static_assert(constant == Tuple<int, char>{ 4, 'a' });
+			static_assert(constant != Tuple<int, char>{ 4, 'b' });
+			static_assert(PackedTuple<char, double>{ 'a', 1.5 } == PackedTuple<char, double>{ 'a', 1.5 });
+			assert((packed == PackedTuple<char, double, char, int>{ 'a', 1.5, 'b', 8 }));
+			assert((packed != PackedTuple<char, double, char, int>{ 'a', 1.5, 'c', 8 }));
+
+			LinearAllocator allocator{ 1024 };
+			HashMap<Tuple<int, float>> map{};
+			map.Allocate(allocator, 8);
+			map.hasher = [](Tuple<int, float>& value)
+			{
+				return static_cast<size_t>(Get<0>(value));
+			};
+			Tuple<int, float> key{ 1, 0.5f };
+			Tuple<int, float> sameHash{ 1, 0.25f };
+			map.Insert(key);
+			assert(map.Contains(key));
+			assert(!map.Contains(sameHash));
+			map.Insert(sameHash);
+			map.Insert(Tuple<int, float>{ 1, 0.5f });
+			assert(map.GetCount() == 2);
+			map.Free(allocator);
+		}
+
+		// Structure of arrays.
+		{
+			LinearAllocator allocator{ 4096 };
+
+			struct Velocity final
+			{
+				float x, y;
+			};
+
+			SoAVector<float, Velocity, int> soa{};
+			soa.Allocate(allocator, 20);
+
+			for (int i = 0; i < 10; ++i)
+				soa.Add(static_cast<float>(i), { 1, 2 }, i);
+			soa.Add();
+			assert(soa.GetCount() == 11);
+
+			// Every column is aligned to a cache line.
+			assert(reinterpret_cast<uintptr_t>(soa.GetColumn<0>().GetData()) % CACHE_LINE_SIZE == 0);
+			assert(reinterpret_cast<uintptr_t>(soa.GetColumn<1>().GetData()) % CACHE_LINE_SIZE == 0);
+			assert(reinterpret_cast<uintptr_t>(soa.GetColumn<2>().GetData()) % CACHE_LINE_SIZE == 0);
+
+			for (auto row : soa)
+				Get<0>(row) += Get<1>(row).x;
+			for (auto& i : soa.GetColumn<2>())
+				i *= 2;
+
+			auto row = soa[3];
+			assert(Get<0>(row) == 4);
+			assert(Get<1>(row).y == 2);
+			assert(Get<2>(row) == 6);
+
+			soa.RemoveAt(3);
+			assert(soa.GetCount() == 10);
+			auto moved = soa[3];
+			assert(Get<0>(moved) == 0 && Get<2>(moved) == 0);
+			assert(soa.GetColumn<0>().GetLength() == 10);
+
+			soa.Free(allocator);
+		}
+
+		// Arena string.
+		{
+			LinearAllocator allocator{ 1024 };
+
+			const char source[] = "hello world";
+			ArenaString a{};
+			a.Allocate(allocator, source);
+			ArenaString b{};
+			b.Allocate(allocator, source, 5);
+			assert(a.GetLength() == 11);
+			assert(b.GetLength() == 5);
+			assert(a.GetData() != source);
+			assert(a == "hello world");
+			assert(b == "hello");
+			assert(b != "hello world");
+			assert(a != b);
+			assert(a.GetHash() == HashString("hello world", 11));
+
+			ArenaString c{};
+			c.Allocate(allocator, "hello");
+			assert(b == c);
+			c[0] = 'j';
+			assert(c == "jello");
+			assert(b != c);
+
+			c.Free(allocator);
+			b.Free(allocator);
+			a.Free(allocator);
+		}
+
+		// String interning.
+		{
+			LinearAllocator allocator{ 4096 };
+
+			StringTable table{};
+			table.Allocate(allocator, 16, 256);
+
+			char runtime[] = "position";
+			const InternedString a = table.Intern("position");
+			const InternedString b = table.Intern(runtime);
+			const InternedString c = table.Intern("positions", 8);
+			const InternedString d = table.Intern("rotation");
+			assert(a == b && a == c);
+			assert(a != d);
+			assert(a.data != runtime);
+			assert(a.length == 8);
+			assert(strcmp(a, "position") == 0);
+			assert(table.GetCount() == 2);
+			assert(table.Contains("rotation", 8));
+			assert(!table.Contains("scale", 5));
+
+			// Interned strings can be used as HashMap values with the stored hash.
+			HashMap<InternedString> set{};
+			set.hasher = InternedString::Hash;
+			set.Allocate(allocator, 8);
+			InternedString e = table.Intern("rotation");
+			set.Insert(e);
+			InternedString f = a;
+			assert(set.Contains(e));
+			assert(!set.Contains(f));
+			set.Free(allocator);
+
+			table.Free(allocator);
+
+			// Fill the table up to its capacity, every new string should only be looked up once.
+			constexpr size_t capacity = 64;
+			table.Allocate(allocator, capacity, capacity * 4);
+#ifdef JLB_CONTAINER_STATS
+			table.ResetStats();
+#endif
+			InternedString interned[capacity];
+			char name[4];
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				snprintf(name, sizeof name, "s%zu", i);
+				interned[i] = table.Intern(name);
+			}
+			assert(table.GetCount() == capacity);
+#ifdef JLB_CONTAINER_STATS
+			assert(table.GetStats().misses.count == capacity);
+			assert(table.GetStats().inserts.count == capacity);
+#endif
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				snprintf(name, sizeof name, "s%zu", i);
+				[[maybe_unused]] const InternedString again = table.Intern(name);
+				assert(again == interned[i]);
+				assert(strcmp(interned[i], name) == 0);
+			}
+			assert(table.GetCount() == capacity);
+			table.Free(allocator);
+		}
+
+		// Bit array.
+		{
+			LinearAllocator allocator{ 1024 };
+
+			BitArray bits{};
+			bits.Allocate(allocator, 130);
+			assert(bits.GetWordCount() == 3);
+			assert(!bits.Any());
+			assert(bits.FindFirstSet() == SIZE_MAX);
+
+			bits.Set(3);
+			bits.Set(64);
+			bits.Set(129);
+			bits.Set(70, true);
+			bits.Set(70, false);
+			assert(bits.Test(3) && bits[64] && bits[129] && !bits[70]);
+			assert(bits.Count() == 3);
+			assert(bits.FindFirstSet() == 3);
+			assert(bits.FindNextSet(4) == 64);
+			assert(bits.FindNextSet(65) == 129);
+			assert(bits.FindNextSet(130) == SIZE_MAX);
+			assert(bits.FindNextUnset(3) == 4);
+
+			size_t visited = 0;
+			size_t sum = 0;
+			bits.ForEachSet([&](const size_t index)
+			{
+				++visited;
+				sum += index;
+			});
+			assert(visited == 3 && sum == 3 + 64 + 129);
+
+			bits.Flip(3);
+			bits.Reset(64);
+			assert(bits.Count() == 1);
+
+			BitArray mask{};
+			mask.Allocate(allocator, 130, true);
+			assert(mask.Count() == 130);
+			// The unused bits of the last word are not reported as unset.
+			assert(mask.FindNextUnset() == SIZE_MAX);
+
+			mask.Reset(129);
+			mask.Reset(10);
+			bits.Or(mask);
+			assert(bits.Count() == 129);
+			bits.And(mask);
+			assert(bits.Count() == 128);
+			bits.Xor(mask);
+			assert(!bits.Any());
+			bits.SetAll();
+			bits.AndNot(mask);
+			assert(bits.Count() == 2 && bits[10] && bits[129]);
+
+			// Long enough to go through the vectorized count.
+			BitArray large{};
+			large.Allocate(allocator, 1000);
+			for (size_t i = 0; i < 1000; i += 3)
+				large.Set(i);
+			assert(large.Count() == 334);
+
+			large.Free(allocator);
+			mask.Free(allocator);
+			bits.Free(allocator);
+		}
+
+		// Flat map.
+		{
+			LinearAllocator allocator{ 4096 };
+
+			FlatMap<int, float> map{};
+			map.Allocate(allocator, 64);
+
+			// Unsorted input with duplicate keys, the last value wins.
+			int keys[] = { 5, 1, 9, 3, 7, 1, 11 };
+			float values[] = { 5, 1, 9, 3, 7, 2, 11 };
+			map.Build(allocator, keys, values, 7);
+			assert(map.GetCount() == 6);
+			assert(map[1] == 2);
+			assert(map[9] == 9);
+			assert(map.Find(4) == nullptr);
+			for (size_t i = 1; i < map.GetCount(); ++i)
+				assert(map.GetKeys()[i - 1] < map.GetKeys()[i]);
+
+			assert(map.LowerBound(0) == 0);
+			assert(map.LowerBound(3) == 1);
+			assert(map.LowerBound(4) == 2);
+			assert(map.UpperBound(3) == 2);
+			assert(map.LowerBound(12) == map.GetCount());
+			assert(map.UpperBound(11) == map.GetCount());
+
+			float sum = 0;
+			map.ForEachInRange(3, 9, [&sum](const int, float& value)
+			{
+				sum += value;
+			});
+			assert(sum == 3 + 5 + 7 + 9);
+
+			map.Insert(4, 4);
+			map.Insert(0, 0);
+			map.Insert(5, 50);
+			assert(map.GetCount() == 8);
+			assert(map.GetKeys()[0] == 0 && map.GetKeys()[3] == 4);
+			assert(map[5] == 50);
+			[[maybe_unused]] const bool erased = map.Erase(9);
+			[[maybe_unused]] const bool erasedTwice = map.Erase(9);
+			assert(erased && !erasedTwice);
+			assert(!map.Contains(9) && map.Contains(11));
+			assert(map.GetCount() == 7);
+
+			// Compare the lookups against a brute force search.
+			map.Clear();
+			for (int i = 0; i < 50; ++i)
+				map.Insert(rand() % 100, static_cast<float>(i));
+			for (int key = -1; key <= 100; ++key)
+			{
+				size_t expected = 0;
+				while (expected < map.GetCount() && map.GetKeys()[expected] < key)
+					++expected;
+				assert(map.LowerBound(key) == expected);
+			}
+
+			map.Free(allocator);
+		}
+
+		// Sparse set.
+		{
+			LinearAllocator allocator{ 4096 };
+
+			SparseSet<int> set{};
+			set.Allocate(allocator, 8);
+
+			const SparseHandle a = set.Insert(1);
+			const SparseHandle b = set.Insert(2);
+			const SparseHandle c = set.Insert(3);
+			assert(set.GetCount() == 3);
+			assert(set[a] == 1 && set[b] == 2 && set[c] == 3);
+
+			// Erasing moves the last value, but its handle keeps working.
+			set.Erase(a);
+			assert(!set.Contains(a));
+			assert(set.TryGet(a) == nullptr);
+			assert(set[c] == 3);
+			assert(set[b] == 2);
+			assert(set.GetHandle(0) == c);
+
+			// The freed slot is reused with a new generation.
+			const SparseHandle d = set.Insert(4);
+			assert(d.index == a.index);
+			assert(d != a);
+			assert(!set.Contains(a));
+			assert(set[d] == 4);
+
+			int sum = 0;
+			for (const int value : set)
+				sum += value;
+			assert(sum == 9);
+
+			set.Clear();
+			assert(set.GetCount() == 0);
+			assert(!set.Contains(b) && !set.Contains(c) && !set.Contains(d));
+			const SparseHandle e = set.Insert(5);
+			assert(set[e] == 5);
+			assert(SparseHandle{} != e);
+
+			set.Free(allocator);
+		}
+
+		// Memory mapped arena.
+		{
+			struct Hasher final
+			{
+				size_t operator()(const uint64_t& value) const
+				{
+					return static_cast<size_t>(value * 0x9E3779B97F4A7C15);
+				}
+			};
+
+			struct Index final
+			{
+				OffsetArray<uint64_t> values{};
+				OffsetHashMap<uint64_t, Hasher> set{};
+			};
+
+			const char* path = "jlb_mapped_arena_test.bin";
+			{
+				MappedArena arena{ path, 65536 };
+				assert(arena.IsOpen() && arena.IsWritable());
+				LinearAllocator& allocator = arena.GetAllocator();
+
+				auto index = new (allocator.New<Index>()) Index();
+				index->values.Allocate(allocator, 100);
+				index->set.Allocate(allocator, 256);
+				for (size_t i = 0; i < 100; ++i)
+				{
+					index->values[i] = i * i;
+					[[maybe_unused]] const bool inserted = index->set.Insert(i * 3);
+					assert(inserted);
+				}
+				[[maybe_unused]] const bool insertedTwice = index->set.Insert(3);
+				assert(!insertedTwice);
+
+				// Erasing shifts the rest of the cluster back, the other values stay reachable.
+				[[maybe_unused]] const bool erased = index->set.Erase(30);
+				[[maybe_unused]] const bool erasedTwice = index->set.Erase(30);
+				assert(erased && !erasedTwice);
+				for (size_t i = 0; i < 100; ++i)
+					assert(index->set.Contains(i * 3) == (i != 10));
+				[[maybe_unused]] const bool reinserted = index->set.Insert(30);
+				assert(reinserted);
+				arena.SetRoot(index);
+			}
+
+			{
+				// Two mappings of the same file end up at different addresses.
+				MappedArena first{ path, MapMode::Read };
+				MappedArena second{ path, MapMode::Read };
+				assert(first.IsOpen() && !first.IsWritable());
+				const Index* a = first.GetRoot<const Index>();
+				const Index* b = second.GetRoot<const Index>();
+				assert(a && b && a != b);
+
+				for (const Index* index : { a, b })
+				{
+					assert(index->values.GetLength() == 100 && index->values[99] == 99 * 99);
+					assert(index->set.GetCount() == 100);
+					for (size_t i = 0; i < 300; ++i)
+						assert(index->set.Contains(i) == (i % 3 == 0));
+					assert(*index->set.Find(42) == 42);
+				}
+			}
+
+			{
+				// Reopened arenas continue allocating after the stored memory.
+				MappedArena arena{ path, MapMode::ReadWrite };
+				assert(arena.IsWritable());
+				const size_t used = arena.GetAllocator().GetUsedMemorySpace();
+				assert(used > 100 * sizeof(uint64_t) + 256 * sizeof(KeyPair<uint64_t>));
+				auto index = arena.GetRoot<Index>();
+				index->set.Free(arena.GetAllocator());
+				index->set.Allocate(arena.GetAllocator(), 64);
+				assert(arena.GetAllocator().GetUsedMemorySpace() < used);
+			}
+
+			assert(!MappedArena(path, MapMode::Read).GetRoot<Index>()->set.Contains(3));
+
+			{
+				// Pretend the file comes from a build with the other allocator statistics setting.
+				// The flags follow the magic, version, size, used and root fields of the header.
+				FILE* file = fopen(path, "r+b");
+				assert(file);
+				uint64_t flags = 0;
+				fseek(file, 5 * sizeof(uint64_t), SEEK_SET);
+				[[maybe_unused]] const size_t read = fread(&flags, sizeof flags, 1, file);
+				assert(read == 1);
+				flags ^= 1;
+				fseek(file, 5 * sizeof(uint64_t), SEEK_SET);
+				fwrite(&flags, sizeof flags, 1, file);
+				fclose(file);
+				assert(!MappedArena(path, MapMode::Read).IsOpen());
+			}
+			remove(path);
+			assert(!MappedArena(path, MapMode::Read).IsOpen());
+
+			// Offset pointers keep pointing to the same relative position when copied along with their target.
+			struct Node final
+			{
+				int value = 0;
+				OffsetPtr<Node> next{};
+			};
+			Node nodes[2]{};
+			nodes[0].value = 1;
+			nodes[1].value = 2;
+			nodes[0].next = &nodes[1];
+			Node copies[2];
+			memcpy(static_cast<void*>(copies), nodes, sizeof nodes);
+			assert(copies[0].next.Get() == &copies[1] && copies[0].next->value == 2);
+			assert(!copies[1].next);
+			// Copying a pointer by itself keeps the target.
+			OffsetPtr<Node> copy = nodes[0].next;
+			assert(copy.Get() == &nodes[1]);
+		}
+
+		// Snapshots.
+		{
+			static_assert(!std::is_trivially_copyable_v<SnapshotName>);
+			LinearAllocator allocator{ 65536 };
+			const char* path = "jlb_snapshot_test.bin";
+
+			{
+				Vector<int> values{};
+				values.Allocate(allocator, 1000);
+				for (int i = 0; i < 700; ++i)
+					values.Add(i * 7);
+
+				HashMap<int> set{};
+				set.Allocate(allocator, 64);
+				set.hasher = [](int& value)
+				{
+					return static_cast<size_t>(value);
+				};
+				for (int i = 0; i < 40; ++i)
+					set.Insert(i * 3);
+
+				Heap<int> heap{};
+				heap.Allocate(allocator, 16);
+				heap.hasher = [](int& value)
+				{
+					return static_cast<size_t>(value);
+				};
+				for (int i : { 5, 2, 9, 1, 7 })
+					heap.Insert(i);
+
+				char first[] = "first";
+				char second[] = "second";
+				Array<SnapshotName> names{};
+				names.Allocate(allocator, 2);
+				names[0].text = first;
+				names[1].text = second;
+
+				SnapshotWriter writer{ path, 3 };
+				writer.Write(values);
+				writer.Write(set);
+				writer.Write(heap);
+				writer.Write(names);
+				[[maybe_unused]] const bool closed = writer.Close();
+				assert(closed);
+
+				names.Free(allocator);
+				heap.Free(allocator);
+				set.Free(allocator);
+				values.Free(allocator);
+			}
+
+			{
+				SnapshotReader reader{ path };
+				assert(!reader.HasFailed() && reader.GetVersion() == 3);
+
+				Vector<int> values{};
+				[[maybe_unused]] const bool readValues = reader.Read(allocator, values);
+				assert(readValues);
+				assert(values.GetCount() == 700 && values.GetLength() == 1000 && values[699] == 699 * 7);
+
+				HashMap<int> set{};
+				[[maybe_unused]] const bool readSet = reader.Read(allocator, set);
+				assert(readSet);
+				set.hasher = [](int& value)
+				{
+					return static_cast<size_t>(value);
+				};
+				assert(set.GetCount() == 40);
+				for (int i = 0; i < 120; ++i)
+					assert(set.Contains(i) == (i % 3 == 0));
+
+				Heap<int> heap{};
+				[[maybe_unused]] const bool readHeap = reader.Read(allocator, heap);
+				assert(readHeap);
+				heap.hasher = [](int& value)
+				{
+					return static_cast<size_t>(value);
+				};
+				assert(heap.GetCount() == 5);
+				heap.Insert(3);
+				for (int expected : { 1, 2, 3, 5, 7, 9 })
+				{
+					[[maybe_unused]] const int popped = heap.Pop();
+					assert(popped == expected);
+				}
+
+				Array<SnapshotName> names{};
+				[[maybe_unused]] const bool readNames = reader.Read(allocator, names);
+				assert(readNames);
+				assert(strcmp(names[0].text, "first") == 0 && strcmp(names[1].text, "second") == 0);
+
+				// The file has ended.
+				Vector<int> empty{};
+				[[maybe_unused]] const bool readEmpty = reader.Read(allocator, empty);
+				assert(!readEmpty);
+				assert(reader.HasFailed());
+			}
+
+			{
+				// Reading a different kind of container, or a different element type, fails before allocating.
+				SnapshotReader reader{ path };
+				const size_t available = allocator.GetAvailableMemorySpace();
+				Array<int> array{};
+				[[maybe_unused]] const bool readArray = reader.Read(allocator, array);
+				assert(!readArray);
+				assert(allocator.GetAvailableMemorySpace() == available);
+			}
+			{
+				SnapshotReader reader{ path };
+				Vector<short> shorts{};
+				[[maybe_unused]] const bool readShorts = reader.Read(allocator, shorts);
+				assert(!readShorts);
+			}
+
+			remove(path);
+			assert(SnapshotReader(path).HasFailed());
+		}
+
+		// Static map.
+		{
+			enum class Opcode
+			{
+				Add,
+				Sub,
+				Mul,
+				Jump
+			};
+
+			static constexpr auto opcodes = MakeStaticMap<const char*, Opcode>({
+				{ "add", Opcode::Add },
+				{ "sub", Opcode::Sub },
+				{ "mul", Opcode::Mul },
+				{ "jmp", Opcode::Jump }
+			});
+			static_assert(opcodes["mul"] == Opcode::Mul);
+			static_assert(!opcodes.Contains("div"));
+			static_assert(opcodes.GetCount() == 4);
+
+			// String keys can be found with runtime strings that are not null terminated.
+			const char source[] = "sub jmp div";
+			StringView view{ source };
+			assert(*opcodes.Find(view.Substr(0, 3)) == Opcode::Sub);
+			assert(*opcodes.Find(view.Substr(4, 3)) == Opcode::Jump);
+			assert(!opcodes.Find(view.Substr(8, 3)));
+			assert(!opcodes.Find(view.Substr(4, 2)));
+
+			// Enough keys to need multiple buckets and seeds.
+			struct Squares final
+			{
+				static constexpr StaticMap<uint32_t, uint32_t, 200> Build()
+				{
+					StaticMapEntry<uint32_t, uint32_t> entries[200]{};
+					for (uint32_t i = 0; i < 200; ++i)
+						entries[i] = { i * 7919, i * i };
+					return StaticMap<uint32_t, uint32_t, 200>(entries);
+				}
+			};
+			static constexpr auto squares = Squares::Build();
+			static_assert(squares[7919u * 150] == 150 * 150);
+			for (uint32_t i = 0; i < 200 * 7919; ++i)
+			{
+				const uint32_t* value = squares.Find(i);
+				assert((value != nullptr) == (i % 7919 == 0));
+				assert(!value || *value == i / 7919 * (i / 7919));
+			}
+		}
+
+		// B+ tree.
+		{
+			LinearAllocator allocator{ 65536 };
+
+			// Single cache line nodes, so that a few hundred keys already need several levels.
+			BTree<uint32_t, int, 64> tree{};
+			tree.Allocate(allocator, 512);
+			assert(!tree.Find(3) && tree.begin() == tree.end());
+
+			// Compare against a brute force table while randomly inserting and erasing.
+			constexpr uint32_t keyCount = 512;
+			bool present[keyCount]{};
+			int expected[keyCount]{};
+			size_t count = 0;
+			for (int i = 0; i < 4000; ++i)
+			{
+				const uint32_t key = static_cast<uint32_t>(rand()) % keyCount;
+				if (rand() % 3 == 0)
+				{
+					[[maybe_unused]] const bool erased = tree.Erase(key);
+					assert(erased == present[key]);
+					count -= present[key];
+					present[key] = false;
+				}
+				else
+				{
+					[[maybe_unused]] const int inserted = tree.Insert(key, i);
+					assert(inserted == i);
+					count += !present[key];
+					present[key] = true;
+					expected[key] = i;
+				}
+				assert(tree.GetCount() == count);
+			}
+			assert(tree.GetDepth() > 2);
+			for (uint32_t key = 0; key < keyCount; ++key)
+			{
+				assert(tree.Contains(key) == present[key]);
+				assert(!present[key] || tree[key] == expected[key]);
+			}
+
+			// Iteration and range scans visit the keys in ascending order.
+			size_t visited = 0;
+			uint32_t previous = 0;
+			for (auto [key, value] : tree)
+			{
+				assert(present[key] && value == expected[key]);
+				assert(visited == 0 || previous < key);
+				previous = key;
+				++visited;
+			}
+			assert(visited == count);
+
+			size_t inRange = 0;
+			for (uint32_t key = 100; key <= 200; ++key)
+				inRange += present[key];
+			visited = 0;
+			tree.ForEachInRange(100, 200, [&](const uint32_t& key, int& value)
+			{
+				assert(key >= 100 && key <= 200 && value == expected[key]);
+				++visited;
+			});
+			assert(visited == inRange);
+
+			uint32_t lowerBound = 300;
+			while (lowerBound < keyCount && !present[lowerBound])
+				++lowerBound;
+			const auto it = tree.LowerBound(300);
+			assert(lowerBound == keyCount ? it == tree.end() : (*it).key == lowerBound);
+
+			// Erasing everything merges the nodes back into an empty tree.
+			for (uint32_t key = 0; key < keyCount; ++key)
+			{
+				[[maybe_unused]] const bool erased = tree.Erase(key);
+				assert(erased == present[key]);
+			}
+			assert(tree.GetCount() == 0 && tree.GetNodeCount() == 0 && tree.begin() == tree.end());
+
+			// Signed keys with the default node size, inserted in descending order.
+			BTree<int32_t, float> signedTree{};
+			signedTree.Allocate(allocator, 1000);
+			for (int32_t i = 500; i > -500; --i)
+				signedTree.Insert(i, static_cast<float>(i));
+			assert(signedTree.GetCount() == 1000);
+			assert((*signedTree.begin()).key == -499);
+			assert(*signedTree.Find(-42) == -42.f && !signedTree.Find(501));
+			signedTree.Free(allocator);
+
+			tree.Free(allocator);
+		}
+
+		// Clock cache.
+		{
+			LinearAllocator allocator{ 4096 };
+
+			ClockCache<int, int> cache{};
+			cache.hasher = [](const int& key)
+			{
+				return static_cast<size_t>(key);
+			};
+			cache.Allocate(allocator, 4);
+			for (int i = 1; i <= 4; ++i)
+				cache.Put(i, i * 10);
+			assert(cache.GetCount() == 4);
+			[[maybe_unused]] const int* one = cache.Get(1);
+			[[maybe_unused]] const int* three = cache.Get(3);
+			[[maybe_unused]] const int* seven = cache.Get(7);
+			assert(*one == 10 && *three == 30 && !seven);
+
+			// 1 and 3 have been used, so they get a second chance and 2 is evicted instead.
+			cache.Put(5, 50);
+			assert(!cache.Contains(2) && cache.Contains(1) && cache.Contains(3));
+			// The hand took away the second chance of 3 on its way to 4.
+			cache.Put(6, 60);
+			assert(!cache.Contains(4) && cache.Contains(3));
+			cache.Put(7, 70);
+			assert(!cache.Contains(1) && cache.GetCount() == 4);
+
+			// Replacing a value does not evict anything.
+			[[maybe_unused]] const int replaced = cache.Put(6, 61);
+			[[maybe_unused]] const int* six = cache.Get(6);
+			assert(replaced == 61 && *six == 61 && cache.GetCount() == 4);
+
+			const CacheStats& stats = cache.GetStats();
+			assert(stats.hits == 3 && stats.misses == 1);
+			assert(stats.inserts == 7 && stats.evictions == 3);
+			assert(stats.GetHitRate() == 0.75);
+
+			[[maybe_unused]] const bool erased = cache.Erase(3);
+			[[maybe_unused]] const bool erasedTwice = cache.Erase(3);
+			assert(erased && !erasedTwice);
+			assert(cache.GetCount() == 3 && cache.Contains(5) && cache.Contains(6) && cache.Contains(7));
+
+			// Keys that collide in the index, with random puts and erases.
+			cache.Free(allocator);
+			cache.hasher = [](const int& key)
+			{
+				return static_cast<size_t>(key % 8);
+			};
+			cache.Allocate(allocator, 16);
+			cache.ResetStats();
+			for (int i = 0; i < 2000; ++i)
+			{
+				const int key = rand() % 40;
+				if (rand() % 4 == 0)
+					cache.Erase(key);
+				else if (int* value = cache.Get(key))
+					assert(*value == key * 10);
+				else
+					cache.Put(key, key * 10);
+				assert(cache.GetCount() <= cache.GetCapacity());
+			}
+			size_t cached = 0;
+			for (int key = 0; key < 40; ++key)
+				cached += cache.Contains(key);
+			assert(cached == cache.GetCount());
+			assert(cache.GetStats().hits + cache.GetStats().misses > 0);
+
+			cache.Clear();
+			assert(cache.GetCount() == 0 && !cache.Contains(0));
+			cache.Free(allocator);
+		}
+
+		// Bloom filter.
+		{
+			LinearAllocator allocator{ 65536 };
+
+			BloomFilter filter{};
+			filter.Allocate(allocator, 1000, 0.01);
+			assert(filter.GetBlockCount() * BloomFilter::BLOCK_SIZE * 8 < 1000 * 16);
+			assert(!filter.MayContain(0));
+
+			for (size_t i = 0; i < 1000; ++i)
+				filter.Insert(i);
+			assert(filter.GetCount() == 1000);
+			assert(filter.GetFalsePositiveRate() <= 0.01);
+			// Never any false negatives.
+			for (size_t i = 0; i < 1000; ++i)
+				assert(filter.MayContain(i));
+
+			size_t falsePositives = 0;
+			for (size_t i = 1000; i < 101000; ++i)
+				falsePositives += filter.MayContain(i);
+			assert(falsePositives < 2000);
+
+			filter.Clear();
+			assert(filter.GetCount() == 0 && !filter.MayContain(5));
+			filter.Free(allocator);
+
+			// As a pre-check for a HashMap.
+			FilteredHashMap<int> map{};
+			map.hasher = [](int& value)
+			{
+				return static_cast<size_t>(value);
+			};
+			map.Allocate(allocator, 64, 0.001);
+			for (int i = 0; i < 40; ++i)
+				map.Insert(i * 3);
+			for (int i = 0; i < 120; ++i)
+				assert(map.Contains(i) == (i % 3 == 0));
+			int erased = 6;
+			map.Erase(erased);
+			assert(!map.Contains(erased));
+			assert(map.GetFilter().MayContain(6));
+			map.RebuildFilter();
+			assert(map.GetFilter().GetCount() == 39);
+			int kept = 9;
+			assert(map.Contains(kept));
+
+			// Values can only be inserted through the filter.
+			static_assert(!std::is_convertible_v<FilteredHashMap<int>*, HashMap<int>*>);
+
+			// Reading a snapshot fills the filter with the values that have been read.
+			const char* path = "jlb_filtered_snapshot_test.bin";
+			{
+				SnapshotWriter writer{ path, 1 };
+				writer.Write(map);
+				[[maybe_unused]] const bool closed = writer.Close();
+				assert(closed);
+			}
+			{
+				SnapshotReader reader{ path };
+				FilteredHashMap<int> loaded{};
+				loaded.hasher = map.hasher;
+				[[maybe_unused]] const bool read = reader.Read(allocator, loaded);
+				assert(read);
+				assert(loaded.GetCount() == 39 && loaded.GetFilter().GetCount() == 39);
+				for (int i = 0; i < 120; ++i)
+					assert(loaded.Contains(i) == (i % 3 == 0 && i != 6));
+				loaded.Free(allocator);
+			}
+			remove(path);
+			map.Free(allocator);
 		}
 
 		// ECS-like.
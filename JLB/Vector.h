@@ -1,16 +1,49 @@
 ﻿#pragma once
 #include "Array.h"
+#include <type_traits>
 
 namespace jlb
 {
 	/// <summary>
 	/// Unordered vector that does not have ownership over the memory that it uses.<br>
-	/// It does not resize the capacity automatically.
+	/// It does not resize the capacity automatically, unless it has been allocated as growable.
 	/// </summary>
 	template <typename T>
 	class Vector : public Array<T>
 	{
 	public:
+		/// <summary>
+		/// Allocates a chunk of memory that grows automatically when the capacity is exceeded.<br>
+		/// If the vector is the newest allocation it grows in place, otherwise it moves to a new allocation twice the size.<br>
+		/// Memory left behind after moving is released, and will be freed together with the allocations on top of it.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate. Has to outlive the vector.</param>
+		/// <param name="capacity">Initial capacity of the vector.</param>
+		void AllocateGrowable(LinearAllocator& allocator, size_t capacity);
+		/// <summary>
+		/// Allocates a chunk of memory with a fixed capacity. Clears the vector, and it is no longer growable.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="size">Capacity of the vector.</param>
+		/// <param name="fillValue">The memory will be initialized with this value.</param>
+		void Allocate(LinearAllocator& allocator, size_t size, const T& fillValue = {}) override;
+		/// <summary>
+		/// Allocates a chunk of memory with a fixed capacity. Clears the vector, and it is no longer growable.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="size">Capacity of the vector.</param>
+		/// <param name="src">The data to copy into the memory.</param>
+		void Allocate(LinearAllocator& allocator, size_t size, T* src) override;
+		/// <summary>
+		/// Frees the vector from the linear allocator. Clears the vector, and it is no longer growable.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator) override;
+		/// <summary>
+		/// Increases the capacity of a growable vector to at least the given capacity.
+		/// </summary>
+		/// <param name="capacity">Minimum capacity of the vector.</param>
+		void Reserve(size_t capacity);
 		/// <summary>
 		/// Place a value in the front of the vector and increase it's size by one.<br>
 		/// Cannot exceed the capacity of the managed memory.
@@ -26,11 +59,63 @@ namespace jlb
 		/// <returns>The added value inside the vector.</returns>
 		T& Add(T&& value = {});
 		/// <summary>
+		/// Place multiple values in the front of the vector and increase it's size accordingly.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <param name="src">Pointer to the values to be added.</param>
+		/// <param name="count">Amount of values to be added.</param>
+		void AddRange(const T* src, size_t count);
+		/// <summary>
+		/// Place all the values of an array in the front of the vector.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <param name="other">Array from which all the values will be copied.</param>
+		void AddRange(Array<T>& other);
+		/// <summary>
+		/// Place all the values of another vector in the front of this vector.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <param name="other">Vector from which all the values will be copied.</param>
+		void AddRange(Vector<T>& other);
+		/// <summary>
+		/// Insert a value at a certain index, shifting all the values behind it one place backwards.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <param name="index">Index where the value will be placed.</param>
+		/// <param name="value">The value to be inserted.</param>
+		/// <returns>The inserted value inside the vector.</returns>
+		T& InsertAt(size_t index, T& value);
+		/// <summary>
+		/// Insert a value at a certain index, shifting all the values behind it one place backwards.<br>
+		/// Cannot exceed the capacity of the managed memory.
+		/// </summary>
+		/// <param name="index">Index where the value will be placed.</param>
+		/// <param name="value">The value to be inserted.</param>
+		/// <returns>The inserted value inside the vector.</returns>
+		T& InsertAt(size_t index, T&& value = {});
+		/// <summary>
 		/// Remove the value at a certain index.
 		/// </summary>
 		/// <param name="index">Index where the value will be removed.</param>
 		void RemoveAt(size_t index);
 		/// <summary>
+		/// Remove the value at a certain index while preserving the order of the remaining values.
+		/// </summary>
+		/// <param name="index">Index where the value will be removed.</param>
+		void RemoveAtStable(size_t index);
+		/// <summary>
+		/// Remove all the values that match the predicate in a single pass.<br>
+		/// The order of the remaining values is preserved.
+		/// </summary>
+		/// <param name="predicate">Returns true for every value that has to be removed.</param>
+		/// <returns>Amount of values removed.</returns>
+		template <typename Predicate>
+		size_t RemoveIf(Predicate predicate);
+		/// <summary>
+		/// Sets the count to zero.
+		/// </summary>
+		void Clear();
+		/// <summary>
 		/// Set the count of the vector. Cannot exceed the capacity of the managed memory.
 		/// </summary>
 		/// <param name="count"></param>
@@ -42,14 +127,117 @@ namespace jlb
 		[[nodiscard]] size_t GetCount() const;
 		[[nodiscard]] Iterator<T> end() override;
 
+	protected:
+		/// <summary>
+		/// Makes the vector grow into an allocator once the memory it currently uses runs out.<br>
+		/// The current memory is not owned by the allocator, so it will not be resized or released.
+		/// </summary>
+		/// <param name="allocator">Allocator to grow into. Has to outlive the vector.</param>
+		void SetSpillAllocator(LinearAllocator& allocator);
+
 	private:
 		// The amount of values in this vector.
 		size_t _count = 0;
+		// Allocator used to grow the vector. Null if the vector is not growable.
+		LinearAllocator* _allocator = nullptr;
+		// If the current memory is not owned by the allocator.
+		bool _external = false;
+
+		void EnsureCapacity(size_t count);
 	};
 
+	template <typename T>
+	void Vector<T>::AllocateGrowable(LinearAllocator& allocator, const size_t capacity)
+	{
+		Array<T>::Allocate(allocator, capacity);
+		_allocator = &allocator;
+		_external = false;
+		_count = 0;
+	}
+
+	template <typename T>
+	void Vector<T>::Allocate(LinearAllocator& allocator, const size_t size, const T& fillValue)
+	{
+		Array<T>::Allocate(allocator, size, fillValue);
+		_allocator = nullptr;
+		_external = false;
+		_count = 0;
+	}
+
+	template <typename T>
+	void Vector<T>::Allocate(LinearAllocator& allocator, const size_t size, T* src)
+	{
+		Array<T>::Allocate(allocator, size, src);
+		_allocator = nullptr;
+		_external = false;
+		_count = 0;
+	}
+
+	template <typename T>
+	void Vector<T>::Free(LinearAllocator& allocator)
+	{
+		Array<T>::Free(allocator);
+		_allocator = nullptr;
+		_external = false;
+		_count = 0;
+	}
+
+	template <typename T>
+	void Vector<T>::Reserve(const size_t capacity)
+	{
+		assert(_allocator);
+		const size_t length = Array<T>::GetLength();
+		if (capacity <= length)
+			return;
+
+		T* data = Array<T>::GetData();
+
+		// If this is the newest allocation, simply move the end of the allocation.
+		if (!_external && _allocator->TryResize(data, capacity * sizeof(T)))
+		{
+			Array<T>::SetMemory(data, capacity);
+			return;
+		}
+
+		// Otherwise move to a new allocation.
+		T* memory = _allocator->New<T>(capacity);
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (_count > 0)
+				memcpy(memory, data, _count * sizeof(T));
+		}
+		else
+			for (size_t i = 0; i < _count; ++i)
+				memory[i] = data[i];
+
+		if (!_external)
+			_allocator->Release(data, length * sizeof(T));
+		_external = false;
+		Array<T>::SetMemory(memory, capacity);
+	}
+
+	template <typename T>
+	void Vector<T>::SetSpillAllocator(LinearAllocator& allocator)
+	{
+		_allocator = &allocator;
+		_external = true;
+	}
+
+	template <typename T>
+	void Vector<T>::EnsureCapacity(const size_t count)
+	{
+		if (!_allocator || count <= Array<T>::GetLength())
+			return;
+
+		// Grow geometrically to keep the amount of reallocations logarithmic.
+		const size_t doubled = Array<T>::GetLength() * 2;
+		Reserve(doubled > count ? doubled : count);
+	}
+
 	template <typename T>
 	T& Vector<T>::Add(T& value)
 	{
+		EnsureCapacity(_count + 1);
 		assert(_count + 1 <= Array<T>::GetLength());
 		return Array<T>::operator[](_count++) = value;
 	}
@@ -57,10 +245,70 @@ namespace jlb
 	template <typename T>
 	T& Vector<T>::Add(T&& value)
 	{
+		EnsureCapacity(_count + 1);
 		assert(_count + 1 <= Array<T>::GetLength());
 		return Array<T>::operator[](_count++) = value;
 	}
 
+	template <typename T>
+	void Vector<T>::AddRange(const T* src, const size_t count)
+	{
+		EnsureCapacity(_count + count);
+		assert(_count + count <= Array<T>::GetLength());
+		T* data = Array<T>::GetData();
+
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (count > 0)
+				memcpy(&data[_count], src, count * sizeof(T));
+		}
+		else
+			for (size_t i = 0; i < count; ++i)
+				data[_count + i] = src[i];
+
+		_count += count;
+	}
+
+	template <typename T>
+	void Vector<T>::AddRange(Array<T>& other)
+	{
+		AddRange(other.GetData(), other.GetLength());
+	}
+
+	template <typename T>
+	void Vector<T>::AddRange(Vector<T>& other)
+	{
+		AddRange(other.GetData(), other.GetCount());
+	}
+
+	template <typename T>
+	T& Vector<T>::InsertAt(const size_t index, T& value)
+	{
+		assert(index <= _count);
+
+		// Copy the value first, since it might be part of the range that is about to be shifted or moved.
+		const T copy = value;
+		EnsureCapacity(_count + 1);
+		assert(_count + 1 <= Array<T>::GetLength());
+		T* data = Array<T>::GetData();
+
+		// Shift everything behind the index one place backwards.
+		if constexpr (std::is_trivially_copyable_v<T>)
+			memmove(&data[index + 1], &data[index], (_count - index) * sizeof(T));
+		else
+			for (size_t i = _count; i > index; --i)
+				data[i] = data[i - 1];
+
+		++_count;
+		return data[index] = copy;
+	}
+
+	template <typename T>
+	T& Vector<T>::InsertAt(const size_t index, T&& value)
+	{
+		return InsertAt(index, value);
+	}
+
 	template <typename T>
 	void Vector<T>::RemoveAt(const size_t index)
 	{
@@ -68,6 +316,49 @@ namespace jlb
 		Array<T>::Swap(index, --_count);
 	}
 
+	template <typename T>
+	void Vector<T>::RemoveAtStable(const size_t index)
+	{
+		assert(index < _count);
+		T* data = Array<T>::GetData();
+		--_count;
+
+		// Shift everything behind the index one place forwards.
+		if constexpr (std::is_trivially_copyable_v<T>)
+			memmove(&data[index], &data[index + 1], (_count - index) * sizeof(T));
+		else
+			for (size_t i = index; i < _count; ++i)
+				data[i] = data[i + 1];
+	}
+
+	template <typename T>
+	template <typename Predicate>
+	size_t Vector<T>::RemoveIf(Predicate predicate)
+	{
+		T* data = Array<T>::GetData();
+
+		// Compact the remaining values towards the front.
+		size_t dst = 0;
+		for (size_t src = 0; src < _count; ++src)
+		{
+			if (predicate(data[src]))
+				continue;
+			if (dst != src)
+				data[dst] = data[src];
+			++dst;
+		}
+
+		const size_t removed = _count - dst;
+		_count = dst;
+		return removed;
+	}
+
+	template <typename T>
+	void Vector<T>::Clear()
+	{
+		_count = 0;
+	}
+
 	template <typename T>
 	void Vector<T>::SetCount(const size_t count)
 	{
@@ -84,10 +375,6 @@ namespace jlb
 	template <typename T>
 	Iterator<T> Vector<T>::end()
 	{
-		Iterator<T> it;
-		it.memory = Array<T>::GetData();
-		it.index = _count;
-		it.length = Array<T>::GetLength();
-		return it;
+		return Iterator<T>(Array<T>::GetData() + _count);
 	}
 }
\ No newline at end of file
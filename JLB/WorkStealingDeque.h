@@ -0,0 +1,157 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include "LinearAllocator.h"
+#include "CacheLine.h"
+
+namespace jlb
+{
+	/// <summary>
+	/// Bounded Chase-Lev deque, used to distribute work between threads.<br>
+	/// The owning thread pushes and pops values at the bottom as if it were a stack,
+	/// while any other thread can steal the oldest values from the top.<br>
+	/// Values are copied in and out without calling constructors, so T should be trivially copyable.
+	/// </summary>
+	template <typename T>
+	class WorkStealingDeque final
+	{
+	public:
+		WorkStealingDeque() = default;
+		WorkStealingDeque(WorkStealingDeque& other) = delete;
+		WorkStealingDeque(WorkStealingDeque&& other) = delete;
+		WorkStealingDeque& operator=(WorkStealingDeque& other) = delete;
+		WorkStealingDeque& operator=(WorkStealingDeque&& other) = delete;
+
+		/// <summary>
+		/// Allocates the ring buffer. Not thread safe.
+		/// </summary>
+		/// <param name="allocator">Allocator from which to allocate.</param>
+		/// <param name="capacity">Minimum capacity of the deque. Will be rounded up to a power of two.</param>
+		void Allocate(LinearAllocator& allocator, size_t capacity);
+		/// <summary>
+		/// Frees the ring buffer from the linear allocator. Not thread safe.
+		/// </summary>
+		/// <param name="allocator">Allocator to free it from.</param>
+		void Free(LinearAllocator& allocator);
+
+		/// <summary>
+		/// Add a value to the bottom of the deque. Owning thread only.
+		/// </summary>
+		/// <param name="value">Value to be added.</param>
+		/// <returns>False if the deque is full.</returns>
+		[[nodiscard]] bool Push(const T& value);
+		/// <summary>
+		/// Get and remove the newest value from the bottom of the deque. Owning thread only.
+		/// </summary>
+		/// <param name="outValue">Newest value of the deque.</param>
+		/// <returns>False if the deque is empty, or if the last value has been stolen.</returns>
+		[[nodiscard]] bool Pop(T& outValue);
+		/// <summary>
+		/// Get and remove the oldest value from the top of the deque. Can be called from any thread.
+		/// </summary>
+		/// <param name="outValue">Oldest value of the deque.</param>
+		/// <returns>False if the deque is empty, or if another thread got to the value first.</returns>
+		[[nodiscard]] bool Steal(T& outValue);
+
+		/// <summary>
+		/// Gets the amount of values in the deque.<br>
+		/// Only an estimate when called while other threads are modifying the deque.
+		/// </summary>
+		/// <returns>Amount of values in the deque.</returns>
+		[[nodiscard]] size_t GetCount() const;
+
+	private:
+		// Written to by thieves.
+		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> _top{ 0 };
+		// Written to by the owner.
+		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> _bottom{ 0 };
+		T* _memory = nullptr;
+		int64_t _mask = 0;
+	};
+
+	template <typename T>
+	void WorkStealingDeque<T>::Allocate(LinearAllocator& allocator, const size_t capacity)
+	{
+		assert(capacity > 0);
+
+		// Round up to a power of two, so that indices can be wrapped with a mask.
+		size_t length = 1;
+		while (length < capacity)
+			length *= 2;
+
+		_memory = allocator.New<T>(length);
+		_mask = static_cast<int64_t>(length) - 1;
+		_top.store(0, std::memory_order_relaxed);
+		_bottom.store(0, std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	void WorkStealingDeque<T>::Free(LinearAllocator& allocator)
+	{
+		allocator.Free();
+	}
+
+	template <typename T>
+	bool WorkStealingDeque<T>::Push(const T& value)
+	{
+		const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+		const int64_t top = _top.load(std::memory_order_acquire);
+		if (bottom - top > _mask)
+			return false;
+
+		_memory[bottom & _mask] = value;
+		// Make sure the value is visible before thieves can see the new bottom.
+		_bottom.store(bottom + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T>
+	bool WorkStealingDeque<T>::Pop(T& outValue)
+	{
+		// Reserve the bottom value before looking at the top, so that thieves can see the reservation.
+		const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+		_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = _top.load(std::memory_order_relaxed);
+
+		// Empty, restore the bottom.
+		if (top > bottom)
+		{
+			_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		outValue = _memory[bottom & _mask];
+		if (top < bottom)
+			return true;
+
+		// This is the last value, so race the thieves for it.
+		const bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	template <typename T>
+	bool WorkStealingDeque<T>::Steal(T& outValue)
+	{
+		int64_t top = _top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return false;
+
+		// Read the value before claiming it, since the owner may overwrite the slot once the top moves.
+		outValue = _memory[top & _mask];
+		return _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	size_t WorkStealingDeque<T>::GetCount() const
+	{
+		const int64_t top = _top.load(std::memory_order_acquire);
+		const int64_t bottom = _bottom.load(std::memory_order_acquire);
+		return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+	}
+}
@@ -0,0 +1,9 @@
+#include <iostream>
+#include "UnitTest.h"
+
+int main()
+{
+	jlb::UnitTest::Run();
+	std::cout << "All tests passed." << std::endl;
+	return 0;
+}